@@ -24,26 +24,86 @@ echo 正在编译静态链接版本...
 echo.
 
 REM 编译源文件
-echo [1/4] 编译 graph.c...
+echo [1/19] 编译 graph.c...
 gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/graph.c -o obj/graph.o
 if errorlevel 1 goto compile_error
 
-echo [2/4] 编译 pathfinding.c...
+echo [2/19] 编译 pathfinding.c...
 gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/pathfinding.c -o obj/pathfinding.o
 if errorlevel 1 goto compile_error
 
-echo [3/4] 编译 utils.c...
+echo [3/19] 编译 utils.c...
 gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/utils.c -o obj/utils.o
 if errorlevel 1 goto compile_error
 
-echo [4/4] 编译 main.c...
+echo [4/19] 编译 heap.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/heap.c -o obj/heap.o
+if errorlevel 1 goto compile_error
+
+echo [5/19] 编译 ch.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/ch.c -o obj/ch.o
+if errorlevel 1 goto compile_error
+
+echo [6/19] 编译 landmarks.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/landmarks.c -o obj/landmarks.o
+if errorlevel 1 goto compile_error
+
+echo [7/19] 编译 matrix.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/matrix.c -o obj/matrix.o
+if errorlevel 1 goto compile_error
+
+echo [8/19] 编译 engine.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/engine.c -o obj/engine.o
+if errorlevel 1 goto compile_error
+
+echo [9/19] 编译 spt.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/spt.c -o obj/spt.o
+if errorlevel 1 goto compile_error
+
+echo [10/19] 编译 routecache.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/routecache.c -o obj/routecache.o
+if errorlevel 1 goto compile_error
+
+echo [11/19] 编译 dynspt.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/dynspt.c -o obj/dynspt.o
+if errorlevel 1 goto compile_error
+
+echo [12/19] 编译 loader.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/loader.c -o obj/loader.o
+if errorlevel 1 goto compile_error
+
+echo [13/19] 编译 snapshot.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/snapshot.c -o obj/snapshot.o
+if errorlevel 1 goto compile_error
+
+echo [14/19] 编译 generator.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/generator.c -o obj/generator.o
+if errorlevel 1 goto compile_error
+
+echo [15/19] 编译 batch.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/batch.c -o obj/batch.o
+if errorlevel 1 goto compile_error
+
+echo [16/19] 编译 server.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/server.c -o obj/server.o
+if errorlevel 1 goto compile_error
+
+echo [17/19] 编译 timedep.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/timedep.c -o obj/timedep.o
+if errorlevel 1 goto compile_error
+
+echo [18/19] 编译 multimodal.c...
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/multimodal.c -o obj/multimodal.o
+if errorlevel 1 goto compile_error
+
+echo [19/19] 编译 main.c...
 gcc -Wall -Wextra -std=c99 -O2 -Iinclude -c src/main.c -o obj/main.o
 if errorlevel 1 goto compile_error
 
 REM 静态链接生成独立可执行文件
 echo.
 echo 正在生成独立可执行文件...
-gcc -static -static-libgcc -static-libstdc++ obj/graph.o obj/pathfinding.o obj/utils.o obj/main.o -o release/PathFinding_Standalone.exe -lm
+gcc -static -static-libgcc -static-libstdc++ obj/graph.o obj/pathfinding.o obj/utils.o obj/heap.o obj/ch.o obj/landmarks.o obj/matrix.o obj/engine.o obj/spt.o obj/routecache.o obj/dynspt.o obj/loader.o obj/snapshot.o obj/generator.o obj/batch.o obj/server.o obj/timedep.o obj/multimodal.o obj/main.o -o release/PathFinding_Standalone.exe -lm -lpthread
 if errorlevel 1 goto link_error
 
 REM 压缩可执行文件（可选）
@@ -79,7 +139,7 @@ goto error_exit
 echo.
 echo [链接失败] 可能缺少静态库
 echo 尝试生成普通版本...
-gcc obj/graph.o obj/pathfinding.o obj/utils.o obj/main.o -o release/PathFinding_Normal.exe -lm
+gcc obj/graph.o obj/pathfinding.o obj/utils.o obj/heap.o obj/ch.o obj/landmarks.o obj/matrix.o obj/engine.o obj/spt.o obj/routecache.o obj/dynspt.o obj/loader.o obj/snapshot.o obj/generator.o obj/batch.o obj/server.o obj/timedep.o obj/multimodal.o obj/main.o -o release/PathFinding_Normal.exe -lm -lpthread
 if errorlevel 1 (
     echo 普通版本也失败了
     goto error_exit
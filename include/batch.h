@@ -0,0 +1,62 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+#include "graph.h"
+#include "engine.h"
+
+#define BATCH_CHUNK_SIZE 4096       // 每次读入并提交给查询引擎的查询数
+#define BATCH_LINE_LEN 512          // 查询行的最大长度
+#define BATCH_OUTPUT_BUFFER (1 << 20)// 输出缓冲区大小
+
+// 可增长的输出文本
+typedef struct {
+    char* text;
+    int length;
+    int capacity;
+} RouteText;
+
+// 批量查询选项
+typedef struct {
+    int threadCount;            // 查询线程数（<=0时使用全部处理器核）
+    int printPath;              // 是否在结果行中输出路径上的节点名称
+} BatchOptions;
+
+// 批量查询的汇总
+typedef struct {
+    long long queries;          // 读入的查询数（不含空行和注释）
+    long long found;            // 找到路径的查询数
+    long long unreachable;      // 不可达的查询数
+    long long errors;           // 格式错误或节点不存在的查询数
+    int threadCount;            // 实际使用的查询线程数
+    double elapsedSeconds;      // 总耗时（含读入、查询和输出）
+    double latencyMean;         // 单次查询搜索耗时的均值和分位数（秒）
+    double latencyP50;
+    double latencyP95;
+    double latencyP99;
+    double latencyMax;
+} BatchSummary;
+
+// 从input逐行读取查询并把结果按输入顺序写到output：
+//   查询行：<起点名称> <终点名称> [walking|driving] [dijkstra|astar|bidijkstra|biastar]
+//   （交通方式缺省为driving，算法缺省为dijkstra；空行和以#开头的行被忽略）
+//   结果行：ok <代价> <距离> <时间> [节点1,节点2,...] / unreachable / error <行号> <原因>
+// 查询按块分配给查询引擎的工作线程；读入和输出下一块与查询当前块重叠进行，输出整块写入带缓冲的文件。
+// 图在批量查询期间被冻结且不得修改。返回0表示成功，-1表示参数错误或无法启动工作线程
+int runBatchQueries(Graph* graph, FILE* input, FILE* output, const BatchOptions* options,
+                    BatchSummary* summary);
+
+// 输出汇总（吞吐量和延迟分位数）
+void printBatchSummary(FILE* stream, const BatchSummary* summary);
+
+// 行协议（批量查询和路由服务共用）：
+// 解析查询行"<起点> <终点> [交通方式] [算法]"，deadlineMs不为NULL时还接受第5个字段（截止毫秒数，缺省为0）。
+// 成功返回0（query->deadline置0）；失败返回-1并在error中给出原因
+int parseRouteQuery(Graph* graph, const char* line, RouteQuery* query, int* deadlineMs, const char** error);
+
+// 追加一个查询的结果行（ok ... 或 unreachable，以换行结尾）
+void formatRouteResult(RouteText* text, const Graph* graph, const RouteQuery* query, const PathResult* result,
+                       int printPath);
+void appendRouteText(RouteText* text, const char* data, int length);
+
+#endif // BATCH_H
@@ -0,0 +1,52 @@
+#ifndef CH_H
+#define CH_H
+
+#include "graph.h"
+#include "pathfinding.h"
+
+#define CH_WITNESS_SETTLE_LIMIT 500     // 收缩时见证搜索最多确定的节点数
+#define CH_SIMULATE_SETTLE_LIMIT 50     // 计算优先级（模拟收缩）时见证搜索最多确定的节点数
+
+// 层次中的弧：原始边或shortcut（shortcut u→w 由经过中间节点v的两段弧组成）
+typedef struct {
+    int from;
+    int to;
+    int weight;         // 所属交通方式下的权重
+    int edgeId;         // 原始边编号（shortcut为-1）
+    int child[2];       // shortcut的两段弧编号（u→v, v→w），原始边为-1
+    int hops;           // 完全展开后的原始边数
+} CHArc;
+
+// 查询图中的一条弧（目标节点和权重内联存放，扫描时不再访问arcs）
+typedef struct {
+    int target;
+    int weight;
+    int arcId;
+} CHQueryEdge;
+
+// 收缩层次（Contraction Hierarchies）：按单一交通方式预处理的快照，
+// 图的拓扑、权重或通行状态变化后需要重新构建
+typedef struct {
+    TransportMode mode;
+    int nodeCount;
+    int edgeCount;              // 构建时图的边数
+    int* rank;                  // 节点的收缩顺序（越大层次越高）
+    CHArc* arcs;                // 所有弧（原始边在前，shortcut在后）
+    int arcCount;
+    int shortcutCount;
+    int* upOffsets;             // 节点u通往更高层节点的出弧位于[upOffsets[u], upOffsets[u+1])
+    CHQueryEdge* upEdges;
+    int* downOffsets;           // 节点v来自更高层节点的入弧位于[downOffsets[v], downOffsets[v+1])，target为弧的起点
+    CHQueryEdge* downEdges;
+} ContractionHierarchy;
+
+// 构建与销毁
+ContractionHierarchy* buildContractionHierarchy(Graph* graph, TransportMode mode);
+void destroyContractionHierarchy(ContractionHierarchy* ch);
+
+// 查询：返回值同dijkstraSearch（-1还表示层次与图不匹配）
+int chSearch(SearchWorkspace* ws, const ContractionHierarchy* ch, Graph* graph, int start, int end,
+             const PathBuffer* buffer, PathResult* result);
+PathResult* chFindPath(const ContractionHierarchy* ch, Graph* graph, int start, int end);
+
+#endif // CH_H
@@ -0,0 +1,42 @@
+#ifndef DYNSPT_H
+#define DYNSPT_H
+
+#include "graph.h"
+#include "heap.h"
+#include "spt.h"
+
+#define DETACHED_EDGE (-2)      // 入边链表中已摘除的边
+
+// 动态维护的最短路径树（Ramalingam-Reps式增量修复）。
+// 创建时构建一棵完整的树并在图上注册监听者，之后每次修改只修复受影响的部分：
+// 代价减小（权重减小、边或节点恢复通行、新增边）时从改善的节点开始做局部Dijkstra；
+// 代价增大（树边权重增大、树边或节点被阻断）时只重新计算该边/节点下方的子树，
+// 先取子树外入边给出的最好代价，再在子树内做局部Dijkstra。
+// 只沿邻接表和自身维护的入边链表访问图，不依赖CSR，也不在监听者中冻结图；
+// 修复时间与受影响的节点及其邻边数成正比；不经过树边的增大型修改无需任何工作
+typedef struct {
+    Graph* graph;
+    ShortestPathTree* tree;     // 维护中的树（随时与当前图一致）
+    IndexedHeap* heap;          // 局部Dijkstra使用的堆
+    unsigned int* affected;     // affected[v]==stamp 表示v在本次修复的子树中
+    int* affectedList;          // 本次修复的子树节点
+    unsigned int stamp;
+    int capacity;               // affected/affectedList/heap/inHead的节点容量
+    int* inHead;                // 每个节点的第一条入边（-1表示没有）
+    int* inNext;                // 同一终点的下一条入边（DETACHED_EDGE表示已被removeEdge摘除）
+    int edgeCapacity;           // inNext的容量
+    
+    long long repairs;          // 处理过的修改次数
+    long long touchedNodes;     // 累计代价被重新确定的节点数
+    int lastTouched;            // 最近一次修复涉及的节点数
+} DynamicSPT;
+
+// 创建与销毁（须在图销毁之前销毁）
+DynamicSPT* createDynamicSPT(Graph* graph, int source, TransportMode mode);
+void destroyDynamicSPT(DynamicSPT* dyn);
+
+// 按一次图修改修复树（已由监听者自动调用；图已修改完毕时传入对应的GraphChange）
+// 返回本次代价被重新确定的节点数，-1表示参数错误
+int repairDynamicSPT(DynamicSPT* dyn, const GraphChange* change);
+
+#endif // DYNSPT_H
@@ -0,0 +1,68 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <pthread.h>
+#include "graph.h"
+#include "pathfinding.h"
+
+#define ENGINE_MAX_CHUNK 16         // 工作线程一次领取的最大查询数
+#define ENGINE_INITIAL_QUEUE 64     // 任务队列初始容量
+
+// 一条路径查询请求
+typedef struct {
+    int start;
+    int end;
+    TransportMode mode;
+    PathAlgorithm algorithm;
+    double deadline;            // 截止时刻（getTimeSeconds的时钟，0表示不限）；开始执行时已过期的查询不做搜索
+} RouteQuery;
+
+// 查询完成回调：在执行该查询的工作线程中调用，不同查询的回调可能并发执行。
+// index为查询在所属批次中的下标；result只在回调期间有效（指向工作线程的工作区缓冲区），
+// 参数错误或已过截止时刻的查询以isValid=0的结果回调；elapsedSeconds为该查询的搜索耗时（含路径回溯）
+typedef void (*QueryCallback)(int index, const RouteQuery* query, const PathResult* result,
+                              double elapsedSeconds, void* userData);
+
+// 队列中的任务
+typedef struct {
+    RouteQuery query;
+    int index;
+    QueryCallback callback;
+    void* userData;
+} QueryTask;
+
+// 查询引擎：固定数量的工作线程，每个线程持有自己的搜索工作区，从共享队列中按块领取查询。
+// 引擎存续期间图视为只读：创建时冻结图，之后不得调用任何修改图的函数（需要修改时先销毁引擎）
+typedef struct {
+    Graph* graph;
+    int threadCount;
+    pthread_t* threads;
+    
+    pthread_mutex_t lock;           // 保护以下字段
+    pthread_cond_t workAvailable;   // 有新任务或正在关闭
+    pthread_cond_t allDone;         // 已提交的任务全部完成
+    QueryTask* tasks;               // 待处理任务 [head, tail)
+    int head;
+    int tail;
+    int capacity;
+    long long submitted;            // 累计提交的查询数
+    long long completed;            // 累计完成的查询数
+    int shuttingDown;
+} QueryEngine;
+
+// 创建与销毁（threadCount<=0时使用全部处理器核；销毁前会先处理完已提交的查询）
+QueryEngine* createQueryEngine(Graph* graph, int threadCount);
+void destroyQueryEngine(QueryEngine* engine);
+
+// 提交一批查询（查询内容被复制，调用后即可释放queries），立即返回；返回0表示成功，-1表示参数错误
+int submitQueryBatch(QueryEngine* engine, const RouteQuery* queries, int count,
+                     QueryCallback callback, void* userData);
+
+// 等待所有已提交的查询完成
+void waitQueryEngine(QueryEngine* engine);
+
+// 提交一批查询并等待其完成
+int runQueryBatch(QueryEngine* engine, const RouteQuery* queries, int count,
+                  QueryCallback callback, void* userData);
+
+#endif // ENGINE_H
@@ -0,0 +1,56 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "graph.h"
+
+#define GENERATOR_ORIGIN_LATITUDE 40.0      // 生成图左下角的纬度
+#define GENERATOR_ORIGIN_LONGITUDE 116.0    // 生成图左下角的经度
+#define GENERATOR_METERS_PER_LAT 111000.0   // 每度纬度的米数（与calculateHeuristic一致）
+#define GENERATOR_METERS_PER_LNG 85000.0    // 每度经度的米数（北纬40度左右）
+
+// 合成图的类型
+typedef enum {
+    GENERATOR_GRID = 0,         // 扰动网格：节点位置随机偏移，部分路段随机删除，每隔若干行列一条主干道
+    GENERATOR_GEOMETRIC = 1,    // 随机几何图：节点均匀分布，距离不超过半径的节点对之间连路
+    GENERATOR_HIGHWAY = 2       // 分层路网：扰动网格的街道 + 稀疏的高速网，高速只在互通立交处与街道相连
+} GeneratorType;
+
+// 道路等级（决定行驶速度）
+typedef enum {
+    ROAD_STREET = 0,            // 街道 30 km/h
+    ROAD_ARTERIAL = 1,          // 主干道 50 km/h
+    ROAD_HIGHWAY = 2,           // 高速 100 km/h（步行权重为距离的10倍）
+    ROAD_CLASS_COUNT = 3
+} RoadClass;
+
+// 生成参数。节点名称为"n<编号>"，坐标由平面米数按上面的比例换算为经纬度。
+// 每条道路生成两个方向的边：distance为端点直线距离（米，向上取整），timeCost为按道路等级行驶的秒数，
+// 步行权重等于距离，驾车权重为按高速速度折算的米数（距离×100/速度），两者都不小于直线距离，
+// 因此欧几里得启发式在生成的图上仍是可采纳的
+typedef struct {
+    GeneratorType type;
+    int nodeCount;              // 目标节点数（网格类取最接近的正方形，分层路网另加立交节点）
+    unsigned long long seed;    // 随机种子（相同参数和种子生成相同的图）
+    double spacing;             // 平均节点间距（米）
+    double jitter;              // 网格节点位置的扰动幅度（间距的比例）
+    double dropRate;            // 网格路段的随机删除比例
+    double degree;              // 几何图的目标平均度数
+    int arterialEvery;          // 每隔多少行/列一条主干道（0表示没有）
+    int highwayEvery;           // 分层路网中每隔多少行/列一条高速
+} GeneratorConfig;
+
+// 按类型填入默认参数
+void initGeneratorConfig(GeneratorConfig* config, GeneratorType type, int nodeCount, unsigned long long seed);
+
+// 解析类型名称（grid / geometric / highway），无法识别时返回-1
+int parseGeneratorType(const char* name);
+const char* getGeneratorTypeName(GeneratorType type);
+
+// 生成图并冻结，参数无效时返回NULL
+Graph* generateGraph(const GeneratorConfig* config);
+
+// 生成图并以文本格式（NODE/EDGE）流式写入文件，不在内存中构建图，内存占用只有节点坐标。
+// edgeCount可为NULL，成功时写入生成的边数。返回0表示成功
+int writeGeneratedGraph(const GeneratorConfig* config, const char* path, long long* edgeCount);
+
+#endif // GENERATOR_H
@@ -7,8 +7,8 @@
 #include <limits.h>
 
 #define MAX_NAME_LEN 32
-#define MAX_NODES 100
-#define MAX_EDGES 1000
+#define DEFAULT_NODE_CAPACITY 16    // 默认初始节点容量
+#define DEFAULT_EDGE_CAPACITY 64    // 默认初始边容量
 #define INF INT_MAX
 
 // 交通方式枚举
@@ -44,25 +44,103 @@ typedef struct {
     int modeWeight[MODE_COUNT]; // 不同交通方式的权重
 } Edge;
 
-// 邻接表节点
-typedef struct AdjListNode {
-    int dest;                   // 目标节点
-    int edgeIndex;              // 边的索引
-    struct AdjListNode* next;   // 下一个邻接节点
-} AdjListNode;
+// 名称索引槽位（开放寻址哈希表）
+typedef struct {
+    unsigned int hash;          // 大小写折叠后名称的哈希值
+    int nodeId;                 // 节点编号（-1表示空槽）
+} NameIndexSlot;
 
-// 图结构
+// 边索引槽位（按(from, to)定位边的开放寻址哈希表）
+typedef struct {
+    int from, to;               // 边的起点和终点
+    int edgeId;                 // 该节点对上编号最小的边（-1表示空槽）
+} EdgeIndexSlot;
+
+typedef struct Graph Graph;
+
+// 图变化类型（修改函数完成修改后通知监听者）
+typedef enum {
+    GRAPH_CHANGE_NODE_ADDED = 0,    // 新增节点
+    GRAPH_CHANGE_EDGE_ADDED = 1,    // 新增边
+    GRAPH_CHANGE_EDGE_WEIGHT = 2,   // 边在某种交通方式下的权重变化
+    GRAPH_CHANGE_EDGE_ACCESS = 3,   // 边的通行状态变化（removeEdge也以此通知）
+    GRAPH_CHANGE_NODE_ACCESS = 4    // 节点的可访问性变化（removeNode也以此通知）
+} GraphChangeType;
+
+// 一次图变化
+typedef struct {
+    GraphChangeType type;
+    int nodeId;                 // 涉及的节点（边变化时为-1）
+    int edgeId;                 // 涉及的边（节点变化时为-1）
+    TransportMode mode;         // 权重变化的交通方式
+    int oldValue;               // 变化前的权重或状态
+    int newValue;               // 变化后的权重或状态
+} GraphChange;
+
+// 图变化监听函数，在修改函数返回前同步调用（回调中不得增删监听者）
+typedef void (*GraphChangeListener)(Graph* graph, const GraphChange* change, void* userData);
+
+// 已注册的监听者
 typedef struct {
+    GraphChangeListener callback;
+    void* userData;
+} GraphListener;
+
+// 图结构
+// 节点和边存放在按需倍增的连续数组中；邻接表以边编号串联，
+// adjHead[u] 为节点u的第一条出边，adjNext[e] 为同一起点的下一条出边（-1表示结束）
+struct Graph {
     int nodeCount;              // 节点数量
     int edgeCount;              // 边数量
-    Node nodes[MAX_NODES];      // 节点数组
-    Edge edges[MAX_EDGES];      // 边数组
-    AdjListNode* adjList[MAX_NODES]; // 邻接表
-} Graph;
+    int nodeCapacity;           // 节点数组容量
+    int edgeCapacity;           // 边数组容量
+    Node* nodes;                // 节点数组
+    Edge* edges;                // 边数组
+    int* adjHead;               // 邻接表表头（按节点）
+    int* adjNext;               // 邻接表后继（按边）
+    
+    // 名称索引：线性探测哈希表，容量为2的幂，负载不超过1/2
+    NameIndexSlot* nameIndex;   // 槽位数组
+    int nameIndexCapacity;      // 槽位数量
+    
+    // 边索引：(from, to) -> 边编号，线性探测哈希表，容量为2的幂
+    EdgeIndexSlot* edgeIndex;   // 槽位数组
+    int edgeIndexCapacity;      // 槽位数量
+    
+    // 冻结后的CSR邻接结构（由freezeGraph生成，供查询路径顺序扫描）
+    // 增删节点或边会使其失效；修改权重和通行状态会同步到CSR中
+    int isFrozen;               // CSR是否与当前拓扑一致
+    int* csrOffsets;            // 节点u的出边位于槽位[csrOffsets[u], csrOffsets[u+1])
+    int* csrTargets;            // 每个槽位的目标节点
+    int* csrEdgeIds;            // 每个槽位对应的边编号
+    int* csrWeights[MODE_COUNT];// 每种交通方式的权重（不可通行时为INF）
+    int* edgeSlot;              // 边编号到CSR槽位的映射（-1表示不在CSR中）
+    
+    // 反向CSR（按终点组织的入边），供反向搜索使用，与正向CSR同时生成和同步
+    int* rcsrOffsets;           // 节点v的入边位于槽位[rcsrOffsets[v], rcsrOffsets[v+1])
+    int* rcsrSources;           // 每个槽位的起点
+    int* rcsrEdgeIds;           // 每个槽位对应的边编号
+    int* rcsrWeights[MODE_COUNT];// 每种交通方式的权重（不可通行时为INF）
+    int* edgeReverseSlot;       // 边编号到反向CSR槽位的映射（-1表示不在CSR中）
+    
+    // 各交通方式modeWeight与端点直线距离之比的下界，乘以两点直线距离即为两点间最短路径代价的下界。
+    // 添加边和修改权重时只降不升，freezeGraph按所有边重新计算；负值表示还没有长度非零的边
+    double weightPerMeter[MODE_COUNT];
+    
+    // 只读图（如映射自快照文件）：数组不属于图，修改函数一律拒绝执行
+    int isReadOnly;
+    
+    // 变化监听者（缓存等派生数据据此失效）
+    unsigned long long version; // 图版本，每次修改后递增
+    GraphListener* listeners;
+    int listenerCount;
+    int listenerCapacity;
+};
 
 // 路径结果结构
 typedef struct {
     int* path;                  // 路径节点序列
+    int* edges;                 // 路径依次经过的边编号（pathLength-1条）
     int pathLength;             // 路径长度（节点数）
     int totalDistance;          // 总距离
     int totalTime;              // 总时间
@@ -71,6 +149,8 @@ typedef struct {
 
 // 图操作函数声明
 Graph* createGraph();
+Graph* createGraphWithCapacity(int nodeCapacity, int edgeCapacity);
+int reserveGraph(Graph* graph, int nodeCapacity, int edgeCapacity);
 void destroyGraph(Graph* graph);
 int addNode(Graph* graph, const char* name, float lat, float lng, NodeType type);
 int addEdge(Graph* graph, int from, int to, int distance, int timeCost, 
@@ -78,9 +158,15 @@ int addEdge(Graph* graph, int from, int to, int distance, int timeCost,
 int removeNode(Graph* graph, int nodeId);
 int removeEdge(Graph* graph, int from, int to);
 int findNodeByName(Graph* graph, const char* name);
+int findEdge(Graph* graph, int from, int to);
 void updateEdgeWeight(Graph* graph, int from, int to, TransportMode mode, int newWeight);
-void setNodeAccessible(Graph* graph, int nodeId, int accessible);
+int setNodeAccessible(Graph* graph, int nodeId, int accessible);
 void setEdgeAccessible(Graph* graph, int from, int to, int accessible);
 void printGraph(Graph* graph);
+int freezeGraph(Graph* graph);
+void computeWeightPerMeter(Graph* graph);
+double straightLineDistance(const Graph* graph, int from, int to);
+int addGraphListener(Graph* graph, GraphChangeListener callback, void* userData);
+void removeGraphListener(Graph* graph, GraphChangeListener callback, void* userData);
 
 #endif // GRAPH_H 
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HEAP_ARITY 4    // d叉堆的分叉数（4叉堆层数更少，且子节点位于同一缓存行）
+#define RADIX_BUCKETS 33 // 基数堆桶数：键值与上次弹出值的最高不同位（0~32）
+
+// 堆元素
+typedef struct {
+    int key;            // 排序键（距离或f值）
+    int id;             // 元素编号（节点编号）
+} HeapEntry;
+
+// 带索引的d叉最小堆，支持按编号降低键值（decrease-key）
+typedef struct {
+    HeapEntry* entries; // 堆数组
+    int* position;      // 编号到堆下标的映射（-1表示不在堆中）
+    int size;           // 当前元素数量
+    int capacity;       // 可容纳的编号范围 [0, capacity)
+} IndexedHeap;
+
+// 基数堆的桶（容量只增不减，清空后复用）
+typedef struct {
+    HeapEntry* items;
+    int size;
+    int capacity;
+} RadixBucket;
+
+// 单调基数堆：要求入堆键值不小于最近一次弹出的键值（Dijkstra中恒成立）
+// 不支持decrease-key，同一编号可重复入堆，由调用方丢弃过期元素
+typedef struct {
+    RadixBucket buckets[RADIX_BUCKETS];
+    unsigned int last;  // 最近一次弹出的键值
+    int size;           // 元素总数
+} RadixHeap;
+
+// 索引堆操作函数
+IndexedHeap* createIndexedHeap(int capacity);
+void destroyIndexedHeap(IndexedHeap* heap);
+int reserveIndexedHeap(IndexedHeap* heap, int capacity);
+void clearIndexedHeap(IndexedHeap* heap);
+int isIndexedHeapEmpty(const IndexedHeap* heap);
+int indexedHeapContains(const IndexedHeap* heap, int id);
+void indexedHeapPush(IndexedHeap* heap, int id, int key);
+void indexedHeapUpdate(IndexedHeap* heap, int id, int key);
+int indexedHeapPop(IndexedHeap* heap, int* key);
+int indexedHeapTopKey(const IndexedHeap* heap);
+
+// 基数堆操作函数
+RadixHeap* createRadixHeap();
+void destroyRadixHeap(RadixHeap* heap);
+void clearRadixHeap(RadixHeap* heap);
+int isRadixHeapEmpty(const RadixHeap* heap);
+void radixHeapPush(RadixHeap* heap, int id, int key);
+int radixHeapPop(RadixHeap* heap, int* key);
+
+#endif // HEAP_H
@@ -0,0 +1,27 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "graph.h"
+
+#define DEFAULT_LANDMARK_COUNT 8    // 默认地标数
+#define MAX_LANDMARKS 64            // 地标数上限
+
+// ALT（A*、地标、三角不等式）预处理结果。
+// 距离按节点连续存放（第v个节点的k个值位于[v*k, v*k+k)），估计一个节点只访问两段连续内存。
+// 下界在边权增大或边被阻断后仍然有效；边权减小或图结构变化后需要重新构建
+typedef struct {
+    int count;                      // 地标数k
+    int nodeCount;                  // 构建时的节点数
+    int* landmarks;                 // 地标节点编号
+    int* distTo[MODE_COUNT];        // distTo[m][v*k+i]   = 节点v到第i个地标的距离
+    int* distFrom[MODE_COUNT];      // distFrom[m][v*k+i] = 第i个地标到节点v的距离
+} LandmarkSet;
+
+// 构建与销毁（按最远点策略选取count个地标，要求图已冻结）
+LandmarkSet* buildLandmarks(Graph* graph, int count);
+void destroyLandmarks(LandmarkSet* set);
+
+// 节点from到to的距离下界（三角不等式）
+int landmarkLowerBound(const LandmarkSet* set, TransportMode mode, int from, int to);
+
+#endif // LANDMARKS_H
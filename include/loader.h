@@ -0,0 +1,44 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "graph.h"
+#include "utils.h"
+
+#define LOADER_MESSAGE_LEN 128  // 错误详情的最大长度
+#define LOADER_MAX_TOKENS 8     // 每行最多的字段数
+
+// 加载结果
+typedef struct {
+    ErrorCode error;                    // ERR_NONE表示成功
+    int line;                           // 出错的行号（从1开始，文件级错误为0）
+    char message[LOADER_MESSAGE_LEN];   // 错误详情
+    int nodeCount;                      // 读入的节点数
+    int edgeCount;                      // 读入的边数
+} GraphLoadStatus;
+
+// 解析文本格式的图数据（data/sample_graph.txt）并追加到图中：
+//   NODE <name> <latitude> <longitude> <type>
+//   EDGE <from_name> <to_name> <distance> <time_cost> <walk_weight> <drive_weight>
+// 空行和以#开头的行被忽略；边的端点必须在之前的行中定义。
+// 单遍扫描，逐行就地切分字段，不做逐行的内存分配；端点经图的名称索引解析。
+// 成功时冻结图并返回0；出错返回-1，status中给出错误码和行号，出错前读入的记录保留在图中
+int parseGraphText(Graph* graph, const char* data, size_t size, GraphLoadStatus* status);
+
+// 以内存映射方式读取文件并解析
+int loadGraphFromFile(Graph* graph, const char* path, GraphLoadStatus* status);
+
+// 创建新图并从文件加载，失败时返回NULL
+Graph* loadGraph(const char* path, GraphLoadStatus* status);
+
+// 从第9届DIMACS挑战赛格式的文件创建图（coPath为NULL时不读取坐标，节点坐标为0）：
+//   .gr：c <注释> / p sp <节点数> <弧数> / a <起点> <终点> <长度>
+//   .co：c <注释> / p aux sp co <节点数> / v <编号> <x> <y>（百万分之一度）
+// 编号为v的节点对应图中的节点v-1，名称为"v<编号>"；弧长同时作为距离、时间和两种交通方式的权重。
+// p行给出的规模用于一次性预留全部数组（之后不再扩容），a行的数量必须与p行声明的弧数一致（截断的文件会报错），
+// 文件以只读映射流式读取，峰值内存约为图本身加上冻结生成的CSR。出错时返回NULL，status中的行号属于出错的文件
+Graph* loadDimacsGraph(const char* grPath, const char* coPath, GraphLoadStatus* status);
+
+// 同上，把grPath的最后三个字符换成".co"得到坐标文件，该文件存在时一并读取
+Graph* loadDimacsGraphWithCoordinates(const char* grPath, GraphLoadStatus* status);
+
+#endif // LOADER_H
@@ -0,0 +1,35 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "graph.h"
+
+// 距离矩阵（按行存放：第i个起点到第j个终点位于下标 i*targetCount+j）
+// costs为最短路径的modeWeight之和，distances/times为该路径的总距离（米）和总时间（秒），不可达时均为INF
+typedef struct {
+    int sourceCount;
+    int targetCount;
+    int* costs;
+    int* distances;
+    int* times;
+} DistanceMatrix;
+
+// 创建与销毁
+DistanceMatrix* createDistanceMatrix(int sourceCount, int targetCount);
+void destroyDistanceMatrix(DistanceMatrix* matrix);
+
+// 计算距离矩阵：每个起点一次Dijkstra，所有终点确定后立即停止；起点分配到threadCount个线程
+// （threadCount<=0时使用全部处理器核）。图未冻结时先冻结；计算期间不得修改图。
+// 返回0表示成功，-1表示参数错误
+int computeDistanceMatrix(Graph* graph, const int* sources, int sourceCount,
+                          const int* targets, int targetCount, TransportMode mode,
+                          int threadCount, DistanceMatrix* matrix);
+
+// 便捷接口：分配并计算距离矩阵（使用全部处理器核），失败返回NULL
+DistanceMatrix* distanceMatrix(Graph* graph, const int* sources, int sourceCount,
+                               const int* targets, int targetCount, TransportMode mode);
+
+// 一对多：单线程计算一个起点到各终点的结果，distances/times可为NULL
+int oneToMany(Graph* graph, int source, const int* targets, int targetCount, TransportMode mode,
+              int* costs, int* distances, int* times);
+
+#endif // MATRIX_H
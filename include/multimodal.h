@@ -0,0 +1,46 @@
+#ifndef MULTIMODAL_H
+#define MULTIMODAL_H
+
+#include "graph.h"
+#include "pathfinding.h"
+
+#define MODE_MASK(mode) (1 << (mode))                   // 交通方式对应的位
+#define MODE_MASK_ALL ((1 << MODE_COUNT) - 1)           // 所有交通方式
+#define MULTIMODAL_DEFAULT_SWITCH_PENALTY 60            // 默认的换乘代价（与modeWeight同单位，约为停车或取车的时间）
+
+// 多方式查询的选项：出发和到达时允许的交通方式用MODE_MASK的组合表示，
+// 例如开车出发、步行到达为startModes=MODE_MASK(MODE_DRIVING)、endModes=MODE_MASK(MODE_WALKING)
+typedef struct {
+    int startModes;             // 出发时可用的交通方式
+    int endModes;               // 到达时允许的交通方式
+    int switchPenalty;          // 每次换乘附加的代价（>=0）
+} MultiModalOptions;
+
+// 多方式查询的结果。route中的路径按PathBuffer的规则存放（buffer为NULL时在工作区自带缓冲区中），
+// totalDistance和totalTime为各边的距离和时间之和；edgeModes由结果自己持有，可在多次查询间复用
+typedef struct {
+    PathResult route;
+    TransportMode* edgeModes;   // edgeModes[i]为第i条边（path[i]→path[i+1]）使用的交通方式
+    int modeCapacity;           // edgeModes的容量
+    int totalCost;              // 各边在所用方式下的权重之和加上换乘代价
+    int switchCount;            // 换乘次数
+} MultiModalResult;
+
+// 默认选项：任意方式出发和到达，换乘代价为MULTIMODAL_DEFAULT_SWITCH_PENALTY
+void initMultiModalOptions(MultiModalOptions* options);
+
+// 结果的初始化与释放（只释放edgeModes，route的存储归buffer或工作区所有）
+void initMultiModalResult(MultiModalResult* result);
+void clearMultiModalResult(MultiModalResult* result);
+
+// 多方式最短路径：在步行和驾车之间只能于交通枢纽（NODE_TRANSPORT_HUB）换乘，如开车到停车场再步行。
+// 搜索在隐式的分层状态空间上一次完成：状态为（节点，交通方式），同层沿该方式可通行的边扩展，
+// 在枢纽处以switchPenalty的代价移到另一层。各层不实际建出，标签按节点数×MODE_COUNT个状态存放在工作区中。
+// 返回值同dijkstraSearch：0表示完成（result->route.isValid指示是否可达），-1表示参数错误，-2表示缓冲区不足
+int multiModalSearch(SearchWorkspace* ws, Graph* graph, int start, int end, const MultiModalOptions* options,
+                     const PathBuffer* buffer, MultiModalResult* result);
+
+// 输出多方式路径：按交通方式分段列出经过的节点和各段的距离与时间
+void printMultiModalPath(Graph* graph, const MultiModalResult* result);
+
+#endif // MULTIMODAL_H
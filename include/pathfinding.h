@@ -2,40 +2,177 @@
 #define PATHFINDING_H
 
 #include "graph.h"
+#include "heap.h"
+#include "landmarks.h"
 
-// 优先队列节点（用于Dijkstra算法）
-typedef struct PriorityQueueNode {
+// Dijkstra可选的优先队列类型
+typedef enum {
+    QUEUE_DARY_HEAP = 0,    // 带decrease-key的d叉堆（默认）
+    QUEUE_RADIX_HEAP = 1    // 单调基数堆（要求边权非负）
+} QueueType;
+
+// 优先队列元素（用于Dijkstra算法）
+typedef struct {
     int nodeId;
     int distance;
-    struct PriorityQueueNode* next;
 } PriorityQueueNode;
 
-// A*算法专用优先队列节点
-typedef struct AStarQueueNode {
+// A*算法专用优先队列元素
+typedef struct {
     int nodeId;
     int gCost;      // 从起点到当前节点的实际代价
     int hCost;      // 从当前节点到终点的启发式代价
     int fCost;      // f = g + h
-    struct AStarQueueNode* next;
 } AStarQueueNode;
 
-// 优先队列结构
+// 优先队列结构（数组实现的二叉最小堆，允许同一节点重复入队）
 typedef struct {
-    PriorityQueueNode* head;
+    PriorityQueueNode* items;
     int size;
+    int capacity;
 } PriorityQueue;
 
-// A*算法专用优先队列结构
+// A*算法专用优先队列结构（数组实现的二叉最小堆）
 typedef struct {
-    AStarQueueNode* head;
+    AStarQueueNode* items;
     int size;
+    int capacity;
 } AStarPriorityQueue;
 
+// 路径查找算法
+typedef enum {
+    ALGO_DIJKSTRA = 0,              // Dijkstra算法
+    ALGO_ASTAR = 1,                 // A*算法
+    ALGO_BIDIRECTIONAL_DIJKSTRA = 2,// 双向Dijkstra算法
+    ALGO_BIDIRECTIONAL_ASTAR = 3,   // 双向A*算法（平均势函数）
+    ALGO_COUNT
+} PathAlgorithm;
+
+// 单个搜索方向的标签（双向搜索时正反两个方向各一份，各自维护代数）
+typedef struct {
+    unsigned int generation;    // 当前查询代数
+    int* dist;                  // 距离（A*中为gScore）
+    int* prevEdge;              // 正向为前驱边编号，反向为通往终点的后继边编号
+    unsigned int* reached;      // reached[v]==generation 时 dist/prevEdge 有效
+    unsigned int* settled;      // settled[v]==generation 时节点已确定
+    IndexedHeap* heap;          // 索引堆
+} SearchLabels;
+
+// 单次查询的工作量统计。计数代码只在以 -DENABLE_SEARCH_STATS 编译时存在，
+// 运行时还需通过 setSearchStats 为工作区指定统计结构；未编译时计数宏展开为空，查询不受任何影响
+typedef struct {
+    long long settledNodes;     // 确定（出堆并扩展）的节点数
+    long long relaxedEdges;     // 扩展时检查过的出边（反向搜索为入边）数
+    long long queuePushes;      // 入堆次数（含decrease-key）
+    long long stalePops;        // 出堆后被丢弃的元素数（已确定或不可访问）
+    int maxQueueSize;           // 堆的最大元素数（双向搜索为两侧之和）
+    double elapsedSeconds;      // 搜索耗时（不含路径回溯）
+} SearchStats;
+
+#ifdef ENABLE_SEARCH_STATS
+#define SEARCH_STATS_ENABLED 1
+#define SEARCH_STAT_ADD(ws, field, amount) \
+    do { if ((ws)->stats) (ws)->stats->field += (amount); } while (0)
+#define SEARCH_STAT_PUSH(ws, queueSize) \
+    do { \
+        if ((ws)->stats) { \
+            (ws)->stats->queuePushes++; \
+            if ((queueSize) > (ws)->stats->maxQueueSize) (ws)->stats->maxQueueSize = (queueSize); \
+        } \
+    } while (0)
+#define SEARCH_STAT_FINISH(ws) \
+    do { if ((ws)->stats) (ws)->stats->elapsedSeconds = getTimeSeconds() - (ws)->statsStartTime; } while (0)
+#else
+#define SEARCH_STATS_ENABLED 0
+#define SEARCH_STAT_ADD(ws, field, amount) ((void)0)
+#define SEARCH_STAT_PUSH(ws, queueSize) ((void)0)
+#define SEARCH_STAT_FINISH(ws) ((void)0)
+#endif
+
+// 可复用的搜索工作区：标签数组按代数戳惰性重置，开始新查询为O(1)，
+// 查询只访问实际到达的节点；稳态下不再分配内存。
+// 工作区不可在线程间共享，并发查询时每个线程使用各自的工作区。
+typedef struct {
+    int capacity;               // 节点容量
+    SearchLabels forward;       // 正向标签（单向查询只使用此方向）
+    SearchLabels backward;      // 反向标签（首次双向查询时分配，heap为NULL表示未分配）
+    RadixHeap* radix;           // 基数堆
+    int* pathBuffer;            // 工作区自带的路径缓冲区
+    int* edgeBuffer;            // 工作区自带的边缓冲区
+    int bufferCapacity;         // 自带缓冲区容量
+    SearchStats* stats;         // 每次查询开始时清零并累计（NULL表示不统计）
+    double statsStartTime;      // 本次查询的开始时刻
+} SearchWorkspace;
+
+// 标签读写（单个方向），供各搜索模块共用
+static inline int labelDist(const SearchLabels* labels, int v) {
+    return labels->reached[v] == labels->generation ? labels->dist[v] : INF;
+}
+
+static inline void setLabel(SearchLabels* labels, int v, int dist, int prevEdge) {
+    labels->reached[v] = labels->generation;
+    labels->dist[v] = dist;
+    labels->prevEdge[v] = prevEdge;
+}
+
+static inline int isSettled(const SearchLabels* labels, int v) {
+    return labels->settled[v] == labels->generation;
+}
+
+static inline void markSettled(SearchLabels* labels, int v) {
+    labels->settled[v] = labels->generation;
+}
+
+// 调用方提供的结果缓冲区：path至少capacity个元素，edges至少capacity-1个（可为NULL）
+typedef struct {
+    int* path;
+    int* edges;
+    int capacity;
+} PathBuffer;
+
+// 线程安全：所有查询函数只读取图，多个线程可以同时查询同一个图，前提是查询期间没有线程修改图
+// （包括freezeGraph，需要冻结时在开始并发查询前完成）；基于工作区的查询要求每个线程使用各自的工作区。
 // 路径查找算法函数声明
 PathResult* dijkstra(Graph* graph, int start, int end, TransportMode mode);
 PathResult* astar(Graph* graph, int start, int end, TransportMode mode);
+PathResult* dijkstraCSR(Graph* graph, int start, int end, TransportMode mode);
+PathResult* astarCSR(Graph* graph, int start, int end, TransportMode mode);
+PathResult* astarWithLandmarks(Graph* graph, int start, int end, TransportMode mode, const LandmarkSet* landmarks);
+PathResult* dijkstraWithQueue(Graph* graph, int start, int end, TransportMode mode, QueueType queue);
+PathResult* bidirectionalDijkstra(Graph* graph, int start, int end, TransportMode mode);
+PathResult* bidirectionalAStar(Graph* graph, int start, int end, TransportMode mode);
+PathResult* findPath(Graph* graph, int start, int end, TransportMode mode, PathAlgorithm algorithm);
+PathResult* findPathWithStats(Graph* graph, int start, int end, TransportMode mode, PathAlgorithm algorithm,
+                              SearchStats* stats);
+
+// 基于工作区的查询：结果写入buffer（为NULL时写入工作区自带缓冲区，下次查询前有效），
+// 返回0表示完成（result->isValid指示是否可达），-1表示参数错误，-2表示缓冲区不足
+SearchWorkspace* createSearchWorkspace(int nodeCapacity);
+void destroySearchWorkspace(SearchWorkspace* ws);
+int reserveSearchWorkspace(SearchWorkspace* ws, int nodeCapacity);
+int beginSearch(SearchWorkspace* ws, const Graph* graph);
+int beginBidirectionalSearch(SearchWorkspace* ws, const Graph* graph);
+int reservePathStorage(SearchWorkspace* ws, const PathBuffer* buffer, int pathLength, int** path, int** edges);
+void setSearchStats(SearchWorkspace* ws, SearchStats* stats);
+int dijkstraSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                   QueueType queue, const PathBuffer* buffer, PathResult* result);
+int astarSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                const PathBuffer* buffer, PathResult* result);
+int astarSearchWithLandmarks(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                             const LandmarkSet* landmarks, const PathBuffer* buffer, PathResult* result);
+int bidirectionalDijkstraSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                                const PathBuffer* buffer, PathResult* result);
+int bidirectionalAStarSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                             const PathBuffer* buffer, PathResult* result);
+int searchPath(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+               PathAlgorithm algorithm, const PathBuffer* buffer, PathResult* result);
+
 PathResult* findPathByName(Graph* graph, const char* startName, const char* endName, TransportMode mode);
 PathResult* findPathByNameAStar(Graph* graph, const char* startName, const char* endName, TransportMode mode);
+PathResult* findPathByNameWithAlgorithm(Graph* graph, const char* startName, const char* endName,
+                                        TransportMode mode, PathAlgorithm algorithm);
+const char* getAlgorithmName(PathAlgorithm algorithm);
+PathResult* copyPathResult(const PathResult* source);
 void freePathResult(PathResult* result);
 
 // 优先队列操作函数
@@ -0,0 +1,92 @@
+#ifndef ROUTECACHE_H
+#define ROUTECACHE_H
+
+#include <pthread.h>
+#include "graph.h"
+#include "pathfinding.h"
+#include "landmarks.h"
+
+#define ROUTE_CACHE_SHARDS 16           // 分片数（每片一把锁）
+#define DEFAULT_ROUTE_CACHE_CAPACITY 4096   // 默认缓存的路径数量
+
+// 缓存项：一次查询的结果及其失效判断所需的信息
+typedef struct RouteCacheEntry {
+    int start;
+    int end;
+    TransportMode mode;
+    PathAlgorithm algorithm;
+    int cost;                           // 路径在该交通方式下的代价（不可达为INF）
+    unsigned long long version;         // 计算结果时的图版本
+    unsigned long long edgeSignature;   // 路径上边编号的位图签名（快速排除无关的边）
+    unsigned long long nodeSignature;   // 路径上节点编号的位图签名
+    PathResult result;                  // 缓存拥有的结果副本
+    
+    struct RouteCacheEntry* hashNext;   // 同一哈希桶的下一项
+    struct RouteCacheEntry* lruPrev;    // LRU链表（表头为最近使用）
+    struct RouteCacheEntry* lruNext;
+} RouteCacheEntry;
+
+// 缓存分片
+typedef struct {
+    pthread_mutex_t lock;
+    RouteCacheEntry** buckets;
+    int bucketCount;                    // 桶数量（2的幂）
+    int count;
+    int capacity;
+    RouteCacheEntry* lruHead;
+    RouteCacheEntry* lruTail;
+    unsigned long long version;         // 已处理到的图版本，只接受按此版本计算的结果
+    
+    long long hits;
+    long long misses;
+    long long insertions;
+    long long evictions;                // 容量满时淘汰
+    long long invalidations;            // 图修改导致的淘汰
+    long long staleInserts;             // 计算期间图已修改而被拒绝的插入
+} RouteCacheShard;
+
+// 路径结果缓存：按(起点, 终点, 交通方式, 算法)缓存，分片加锁，可在多个线程中同时查询和插入。
+// 图的每次修改都会递增graph->version并同步通知缓存，缓存只淘汰可能受影响的项：
+// 权重增大或边/节点被阻断时淘汰经过它的路径；权重减小、恢复通行或新增边时
+// 淘汰可能因此变短的路径（有地标时用ALT下界判断，否则保守地按0下界判断）。
+// 修改图仍须与查询互斥（见pathfinding.h），版本号保证修改前算出的结果不会在修改后被插入
+typedef struct {
+    Graph* graph;
+    RouteCacheShard shards[ROUTE_CACHE_SHARDS];
+    const LandmarkSet* landmarks;       // 可选；第一次减小型修改之后下界不再可靠，自动停用
+} RouteCache;
+
+// 统计信息
+typedef struct {
+    int entries;
+    long long hits;
+    long long misses;
+    long long insertions;
+    long long evictions;
+    long long invalidations;
+    long long staleInserts;
+    double hitRate;                     // hits / (hits + misses)
+} RouteCacheStats;
+
+// 创建与销毁（capacity<=0时使用默认容量；须在图销毁之前销毁缓存）
+RouteCache* createRouteCache(Graph* graph, int capacity);
+void destroyRouteCache(RouteCache* cache);
+void clearRouteCache(RouteCache* cache);
+
+// 设置用于精确失效判断的地标（须与当前图一致，可为NULL）
+void setRouteCacheLandmarks(RouteCache* cache, const LandmarkSet* landmarks);
+
+// 查找缓存，命中时返回独立分配的结果副本，未命中返回NULL
+PathResult* routeCacheLookup(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm);
+
+// 插入按图版本version计算的结果；返回0表示已插入，1表示图已修改、结果被丢弃，-1表示参数错误
+int routeCacheInsert(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm,
+                     const PathResult* result, unsigned long long version);
+
+// 先查缓存，未命中时计算并插入
+PathResult* findPathWithRouteCache(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm);
+
+// 汇总各分片的统计信息
+void getRouteCacheStats(RouteCache* cache, RouteCacheStats* stats);
+
+#endif // ROUTECACHE_H
@@ -0,0 +1,35 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "graph.h"
+
+#define SERVER_DEFAULT_ADDRESS "127.0.0.1:7070"
+#define SERVER_DEFAULT_DEADLINE_MS 1000 // 请求未指定截止时间时的缺省值（毫秒）
+#define SERVER_MAX_PIPELINE 1024        // 每个连接最多同时处理的请求数，超过时暂停读取
+#define SERVER_MAX_OUTPUT (1 << 20)     // 每个连接待发送数据的上限，超过时暂停读取
+#define SERVER_READ_BUFFER 65536        // 每个连接的读缓冲区大小
+#define SERVER_MAX_EVENTS 256           // 每次epoll_wait处理的最大事件数
+#define SERVER_DRAIN_SECONDS 5.0        // 收到退出信号后等待未完成请求的最长时间
+
+// 路由服务选项
+typedef struct {
+    const char* listenAddress;  // "主机:端口"、":端口"（所有地址）或 "unix:套接字路径"
+    const char* graphPath;      // 重新加载时读取的图文件（文本、DIMACS .gr 或快照），NULL表示不支持重新加载
+    int threadCount;            // 查询线程数（<=0时使用全部处理器核）
+    int defaultDeadlineMs;      // 缺省截止时间（毫秒，0表示不限）
+    int printPath;              // 结果行是否包含路径上的节点名称
+} ServerOptions;
+
+// 运行路由服务（仅Linux，基于epoll），直到收到SIGINT或SIGTERM。
+// 行协议（每行一个请求，同一连接上可连续发送多个请求，响应按请求顺序返回）：
+//   <起点> <终点> [walking|driving] [dijkstra|astar|bidijkstra|biastar] [截止毫秒数]
+//     -> ok <代价> <距离> <时间> [节点1,...] / unreachable / timeout / error <原因>
+//   PING -> pong；STATS -> stats <字段=值>...；QUIT -> bye（发送完之前的响应后关闭连接）
+//   RELOAD -> reloading（与SIGHUP相同：在后台线程重新读取graphPath，完成后新请求使用新图，
+//             已提交的请求在旧图上完成，连接不中断）
+// 事件循环线程负责网络读写和请求解析，搜索交给查询引擎的工作线程，完成后经eventfd唤醒事件循环。
+// 截止时间到达时仍未完成的请求立即以timeout响应，尚未开始的搜索不再执行。
+// graph为初始的图，服务期间不得被其他线程修改，由调用方在返回后释放。返回0表示正常退出，-1表示无法启动
+int runRoutingServer(Graph* graph, const ServerOptions* options);
+
+#endif // SERVER_H
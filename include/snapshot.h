@@ -0,0 +1,38 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "graph.h"
+#include "landmarks.h"
+#include "ch.h"
+#include "utils.h"
+
+#define GRAPH_SNAPSHOT_VERSION 1        // 格式版本，布局变化时递增
+#define GRAPH_SNAPSHOT_ALIGNMENT 64     // 各数据段的对齐字节数（缓存行）
+
+// 二进制图快照：文件头（魔数、版本、字节序标记、结构体尺寸）+ 段表 + 按64字节对齐的数据段。
+// 数据段与内存中的数组逐字节相同：节点（含名称）、边、邻接表、名称索引、边索引、
+// 正反向CSR，以及可选的地标和各交通方式的收缩层次。
+// 打开时只做一次只读映射并把图的数组指针指向映射内存（不复制、不解析），
+// 耗时与图的规模无关；多个进程打开同一文件时共享物理页。
+// 快照只能在相同字节序和结构体布局的平台上打开，否则返回格式错误
+typedef struct {
+    MappedFile file;
+    Graph* graph;                                   // 只读图（修改函数均被拒绝）
+    LandmarkSet* landmarks;                         // 未保存地标时为NULL
+    ContractionHierarchy* hierarchies[MODE_COUNT];  // 未保存该交通方式的层次时为NULL
+} GraphSnapshot;
+
+// 保存快照（图未冻结时先冻结）。landmarks和hierarchies可为NULL，hierarchies[m]须按交通方式m构建且与图一致。
+// 先写入临时文件再改名替换，已映射旧文件的进程不受影响。返回0表示成功
+int saveGraphSnapshot(const char* path, Graph* graph, const LandmarkSet* landmarks,
+                      ContractionHierarchy* const hierarchies[MODE_COUNT]);
+
+// 打开快照，失败时返回NULL并在error中给出ERR_FILE_IO或ERR_FILE_FORMAT（error可为NULL）。
+// 快照中的图、地标和层次归快照所有，只能通过closeGraphSnapshot释放
+GraphSnapshot* openGraphSnapshot(const char* path, ErrorCode* error);
+void closeGraphSnapshot(GraphSnapshot* snapshot);
+
+// 文件是否以快照魔数开头
+int isGraphSnapshotFile(const char* path);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,54 @@
+#ifndef SPT_H
+#define SPT_H
+
+#include "graph.h"
+
+#define DEFAULT_SPT_CACHE_CAPACITY 16   // 默认缓存的最短路径树数量
+
+// 单源最短路径树：从source出发到每个节点的最短代价及树上的前驱（不可达时为INF和-1）。
+// 构建时的节点数之后新增的节点视为不可达
+typedef struct {
+    int source;                 // 起点
+    TransportMode mode;         // 交通方式
+    int nodeCount;              // 构建时的节点数
+    int* dist;                  // dist[v]     = 起点到v的最短代价
+    int* prevNode;              // prevNode[v] = 树上v的父节点
+    int* prevEdge;              // prevEdge[v] = 从父节点到v的边编号
+} ShortestPathTree;
+
+// 最短路径树缓存：按(起点, 交通方式)缓存最近使用的树，容量满时淘汰最久未用的树。
+// 缓存在图上注册监听者，图的修改使受影响的树立即失效（只淘汰修改后可能不再最短的树）。
+// 缓存本身不是线程安全的，并发使用时由调用方加锁
+typedef struct {
+    Graph* graph;
+    int capacity;               // 最多缓存的树数量
+    int count;                  // 当前缓存的树数量
+    ShortestPathTree** trees;   // 缓存的树（容量通常较小，按顺序查找）
+    unsigned long long* lastUsed;// 每棵树最近一次使用的时间戳
+    unsigned long long clock;   // 使用时间戳计数器
+    
+    long long hits;             // 命中次数
+    long long misses;           // 未命中（重新构建）次数
+    long long invalidations;    // 因图修改而失效的树数量
+} SPTCache;
+
+// 构建与销毁（图未冻结时先冻结，沿CSR运行完整的Dijkstra）
+ShortestPathTree* buildShortestPathTree(Graph* graph, int source, TransportMode mode);
+void destroyShortestPathTree(ShortestPathTree* tree);
+
+// 沿前驱回溯出起点到target的路径（返回独立分配的结果，不可达时isValid为0）
+PathResult* extractTreePath(const ShortestPathTree* tree, const Graph* graph, int target);
+
+// 缓存的创建与销毁（capacity<=0时使用默认容量）
+SPTCache* createSPTCache(Graph* graph, int capacity);
+void destroySPTCache(SPTCache* cache);
+void clearSPTCache(SPTCache* cache);
+
+// 取得起点source的最短路径树，未缓存时构建并放入缓存（返回的树在下次缓存操作或图修改前有效）
+const ShortestPathTree* getCachedTree(SPTCache* cache, int source, TransportMode mode);
+
+// 经缓存查找路径
+PathResult* findPathCached(SPTCache* cache, int start, int end, TransportMode mode);
+PathResult* findPathByNameCached(SPTCache* cache, const char* startName, const char* endName, TransportMode mode);
+
+#endif // SPT_H
@@ -0,0 +1,83 @@
+#ifndef TIMEDEP_H
+#define TIMEDEP_H
+
+#include "graph.h"
+#include "pathfinding.h"
+#include "loader.h"
+
+#define TIME_PROFILE_PERIOD 86400       // 剖面的周期（秒），时刻按周期取模后查找
+#define TIME_PROFILE_MAX_POINTS 1024    // 单个剖面的断点数上限
+#define TIME_PROFILE_SCAN_LIMIT 8       // 断点数不超过该值时顺序查找所在区间，否则二分查找
+#define TIME_PROFILE_LINE_LEN 16384     // 剖面文件中一行的最大长度
+
+// 剖面的一个断点：在一天中的时刻time出发时，通过该边需要travelTime秒
+typedef struct {
+    int time;
+    int travelTime;
+} TimeBreakpoint;
+
+// 正向CSR槽位上的时间信息（与csrTargets按槽位对齐，扫描出边时顺序访问）
+typedef struct {
+    int profile;                // 剖面编号（-1表示使用静态的timeCost）
+    int timeCost;               // 边的静态行程时间
+} TimeArc;
+
+// 时间相关的行程时间：边可以带一个分段线性、按天循环的剖面，未带剖面的边使用静态的timeCost。
+// 所有剖面的断点依次存放在同一个断点池中（每个剖面末尾附加一个时刻为周期的哨兵断点，
+// 其行程时间等于时刻0的值），查找一个剖面只访问连续的几个缓存行；多条边可以共用同一个剖面。
+// 剖面满足FIFO（先出发不会晚到达）：相邻断点间行程时间的下降不超过时刻的增量，
+// 按整数向下取整插值后仍然成立，因此时间相关的Dijkstra和A*按到达时刻标号即可得到最早到达路径。
+// 与图的拓扑绑定：创建时冻结图，之后增删节点或边需要重新创建
+typedef struct {
+    int nodeCount;              // 创建时图的节点数
+    int edgeCount;              // 创建时图的边数
+    int slotCount;              // 正向CSR的槽位数
+    int* edgeProfile;           // 每条边的剖面编号（-1表示没有）
+    TimeArc* arcs;              // 每个正向CSR槽位的剖面编号和静态行程时间
+    int* profileOffsets;        // 剖面p的断点（含哨兵）位于points[profileOffsets[p], profileOffsets[p+1])
+    int profileCount;
+    int profileCapacity;
+    TimeBreakpoint* points;     // 断点池
+    int pointCount;
+    int pointCapacity;
+    double secondsPerMeter;     // 任意边的最小行程时间与端点直线距离之比的下界（A*的启发式系数）
+} TimeProfileSet;
+
+// 创建与销毁（所有边初始使用静态的timeCost，图未冻结时先冻结）
+TimeProfileSet* createTimeProfileSet(Graph* graph);
+void destroyTimeProfileSet(TimeProfileSet* set);
+
+// 添加剖面：断点按时刻严格递增，第一个断点的时刻为0，时刻小于TIME_PROFILE_PERIOD，行程时间非负，
+// 且（含从最后一个断点回到下一周期时刻0的区间）满足FIFO。返回剖面编号，参数无效时返回-1
+int addTimeProfile(TimeProfileSet* set, const TimeBreakpoint* points, int count);
+
+// 为边指定剖面（profileId为-1时恢复静态的timeCost），返回0表示成功
+int setEdgeTimeProfile(TimeProfileSet* set, const Graph* graph, int edgeId, int profileId);
+
+// 剖面在出发时刻departureTime（>=0，按周期取模）的行程时间
+int evaluateTimeProfile(const TimeProfileSet* set, int profileId, int departureTime);
+
+// 边在出发时刻departureTime的行程时间
+int getEdgeTravelTime(const TimeProfileSet* set, const Graph* graph, int edgeId, int departureTime);
+
+// 从文本文件读取剖面并指定给边：
+//   PROFILE <起点名称> <终点名称> <时刻>:<行程时间> [<时刻>:<行程时间> ...]
+// 空行和以#开头的行被忽略；同一节点对有多条边时指定给编号最小的一条。
+// 成功返回0（status->edgeCount为指定了剖面的边数）；出错返回-1，status中给出错误码和行号
+int loadTimeProfiles(TimeProfileSet* set, Graph* graph, const char* path, GraphLoadStatus* status);
+
+// 时间相关的最早到达查询：在departureTime（秒，>=0）从start出发，按各边在到达其起点时刻的行程时间搜索，
+// 只经过在mode下可通行的边。result->totalTime为到达时刻减去出发时刻，totalDistance为路径的距离之和。
+// A*以直线距离乘secondsPerMeter作为剩余时间的下界。返回值同dijkstraSearch（-1还表示剖面与图不匹配）
+int timeDependentDijkstraSearch(SearchWorkspace* ws, Graph* graph, const TimeProfileSet* profiles,
+                                int start, int end, TransportMode mode, int departureTime,
+                                const PathBuffer* buffer, PathResult* result);
+int timeDependentAStarSearch(SearchWorkspace* ws, Graph* graph, const TimeProfileSet* profiles,
+                             int start, int end, TransportMode mode, int departureTime,
+                             const PathBuffer* buffer, PathResult* result);
+
+// 使用临时工作区查询并返回独立分配的结果（algorithm为ALGO_DIJKSTRA或ALGO_ASTAR）
+PathResult* findTimeDependentPath(Graph* graph, const TimeProfileSet* profiles, int start, int end,
+                                  TransportMode mode, int departureTime, PathAlgorithm algorithm);
+
+#endif // TIMEDEP_H
@@ -16,6 +16,7 @@ int isValidCoordinate(float coord);
 void trimString(char* str);
 void toLowerCase(char* str);
 int stringCompareIgnoreCase(const char* str1, const char* str2);
+unsigned int hashStringIgnoreCase(const char* str);
 
 // 数学工具函数
 float calculateDistance(float lat1, float lng1, float lat2, float lng2);
@@ -26,6 +27,19 @@ int maxInt(int a, int b);
 void* safeMalloc(size_t size);
 void* safeRealloc(void* ptr, size_t size);
 
+// 系统工具函数
+int getProcessorCount(void);
+double getTimeSeconds(void);    // 单调时钟读数（秒），只用于计算时间差
+
+// 只读内存映射的文件（多个进程映射同一文件时共享物理页）
+typedef struct {
+    const char* data;           // 文件内容（空文件时为NULL）
+    size_t size;                // 文件字节数
+} MappedFile;
+
+int mapFileReadOnly(const char* path, MappedFile* file);
+void unmapFile(MappedFile* file);
+
 // 错误处理
 typedef enum {
     ERR_NONE = 0,
@@ -34,7 +48,9 @@ typedef enum {
     ERR_EDGE_NOT_FOUND,
     ERR_MEMORY_ALLOCATION,
     ERR_GRAPH_FULL,
-    ERR_PATH_NOT_FOUND
+    ERR_PATH_NOT_FOUND,
+    ERR_FILE_IO,
+    ERR_FILE_FORMAT
 } ErrorCode;
 
 const char* getErrorMessage(ErrorCode error);
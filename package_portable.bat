@@ -23,7 +23,7 @@ echo 正在编译程序...
 echo.
 
 REM 编译程序（普通版本）
-gcc -Wall -Wextra -std=c99 -O2 -Iinclude src/graph.c src/pathfinding.c src/utils.c src/main.c -o portable/bin/PathFinding.exe -lm
+gcc -Wall -Wextra -std=c99 -O2 -Iinclude src/graph.c src/pathfinding.c src/utils.c src/heap.c src/ch.c src/landmarks.c src/matrix.c src/engine.c src/spt.c src/routecache.c src/dynspt.c src/loader.c src/snapshot.c src/generator.c src/batch.c src/server.c src/timedep.c src/multimodal.c src/main.c -o portable/bin/PathFinding.exe -lm -lpthread
 if errorlevel 1 goto compile_error
 
 echo 正在查找依赖的DLL文件...
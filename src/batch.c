@@ -0,0 +1,323 @@
+#include "../include/batch.h"
+#include "../include/engine.h"
+#include "../include/pathfinding.h"
+#include "../include/utils.h"
+
+// 一条查询的结果类别
+typedef enum {
+    BATCH_FOUND = 0,
+    BATCH_UNREACHABLE = 1,
+    BATCH_ERROR = 2
+} BatchOutcome;
+
+// 一块查询：每个查询行的输出，以及其中格式正确、提交给引擎的查询。
+// 引擎回调只写入本查询所在行的输出，不同查询之间不需要加锁
+typedef struct {
+    Graph* graph;
+    int printPath;
+    int count;                  // 块中的查询行数
+    RouteText* texts;           // 每个查询行的输出
+    unsigned char* outcomes;    // 每个查询行的结果类别
+    RouteQuery* queries;        // 提交给引擎的查询
+    int* lineOf;                // 提交的查询在块中的行位置
+    double* latencies;          // 提交的查询的搜索耗时
+    int queryCount;             // 提交的查询数
+} BatchChunk;
+
+static void initChunk(BatchChunk* chunk, Graph* graph, int printPath) {
+    chunk->graph = graph;
+    chunk->printPath = printPath;
+    chunk->count = 0;
+    chunk->queryCount = 0;
+    chunk->texts = (RouteText*)safeMalloc(BATCH_CHUNK_SIZE * sizeof(RouteText));
+    chunk->outcomes = (unsigned char*)safeMalloc(BATCH_CHUNK_SIZE);
+    chunk->queries = (RouteQuery*)safeMalloc(BATCH_CHUNK_SIZE * sizeof(RouteQuery));
+    chunk->lineOf = (int*)safeMalloc(BATCH_CHUNK_SIZE * sizeof(int));
+    chunk->latencies = (double*)safeMalloc(BATCH_CHUNK_SIZE * sizeof(double));
+    memset(chunk->texts, 0, BATCH_CHUNK_SIZE * sizeof(RouteText));
+}
+
+static void freeChunk(BatchChunk* chunk) {
+    for (int i = 0; i < BATCH_CHUNK_SIZE; i++) {
+        free(chunk->texts[i].text);
+    }
+    free(chunk->texts);
+    free(chunk->outcomes);
+    free(chunk->queries);
+    free(chunk->lineOf);
+    free(chunk->latencies);
+}
+
+// 追加输出文本，容量不足时倍增
+void appendRouteText(RouteText* text, const char* data, int length) {
+    if (text->length + length > text->capacity) {
+        int capacity = maxInt(64, text->capacity);
+        while (text->length + length > capacity) capacity *= 2;
+        text->text = (char*)safeRealloc(text->text, (size_t)capacity);
+        text->capacity = capacity;
+    }
+    memcpy(text->text + text->length, data, (size_t)length);
+    text->length += length;
+}
+
+// 追加格式化的文本（最多三个整数参数）
+static void appendFormat(RouteText* text, const char* format, long long a, long long b, long long c) {
+    char buffer[96];
+    int length = snprintf(buffer, sizeof(buffer), format, a, b, c);
+    appendRouteText(text, buffer, minInt(length, (int)sizeof(buffer) - 1));
+}
+
+// 交通方式名称（也接受编号），无法识别时返回-1
+static int parseModeName(const char* name) {
+    if (strcmp(name, "driving") == 0 || strcmp(name, "drive") == 0 || strcmp(name, "1") == 0) return MODE_DRIVING;
+    if (strcmp(name, "walking") == 0 || strcmp(name, "walk") == 0 || strcmp(name, "0") == 0) return MODE_WALKING;
+    return -1;
+}
+
+// 算法名称（也接受编号），无法识别时返回-1
+static int parseAlgorithmName(const char* name) {
+    static const char* names[ALGO_COUNT] = { "dijkstra", "astar", "bidijkstra", "biastar" };
+    
+    for (int i = 0; i < ALGO_COUNT; i++) {
+        if (stringCompareIgnoreCase(name, names[i]) == 0) return i;
+    }
+    if (name[0] >= '0' && name[0] < '0' + ALGO_COUNT && name[1] == '\0') return name[0] - '0';
+    return -1;
+}
+
+// 把一行标记为错误
+static void setLineError(BatchChunk* chunk, int line, long long lineNumber, const char* reason) {
+    RouteText* text = &chunk->texts[line];
+    chunk->outcomes[line] = BATCH_ERROR;
+    appendFormat(text, "error %lld ", lineNumber, 0, 0);
+    appendRouteText(text, reason, (int)strlen(reason));
+    appendRouteText(text, "\n", 1);
+}
+
+// 解析查询行：<起点> <终点> [交通方式] [算法] [截止毫秒数]。deadlineMs为NULL时不接受第5个字段
+int parseRouteQuery(Graph* graph, const char* line, RouteQuery* query, int* deadlineMs, const char** error) {
+    char startName[BATCH_LINE_LEN], endName[BATCH_LINE_LEN];
+    char modeName[BATCH_LINE_LEN] = "driving", algorithmName[BATCH_LINE_LEN] = "dijkstra";
+    char deadlineText[BATCH_LINE_LEN] = "0";
+    char extra[2];
+    int maxFields = deadlineMs ? 5 : 4;
+    
+    if (strlen(line) >= BATCH_LINE_LEN) {
+        *error = "行过长";
+        return -1;
+    }
+    int fields = sscanf(line, "%s %s %s %s %s %1s", startName, endName, modeName, algorithmName,
+                        deadlineText, extra);
+    if (fields < 2 || fields > maxFields) {
+        *error = deadlineMs ? "查询需要2到5个字段" : "查询需要2到4个字段";
+        return -1;
+    }
+    
+    int start = findNodeByName(graph, startName);
+    int end = findNodeByName(graph, endName);
+    int mode = parseModeName(modeName);
+    int algorithm = parseAlgorithmName(algorithmName);
+    char* deadlineEnd;
+    long deadline = strtol(deadlineText, &deadlineEnd, 10);
+    if (start == -1) {
+        *error = "未定义的起点";
+    } else if (end == -1) {
+        *error = "未定义的终点";
+    } else if (mode == -1) {
+        *error = "无效的交通方式";
+    } else if (algorithm == -1) {
+        *error = "无效的算法";
+    } else if (*deadlineEnd != '\0' || deadline < 0 || deadline > INT_MAX) {
+        *error = "无效的截止时间";
+    } else {
+        query->start = start;
+        query->end = end;
+        query->mode = (TransportMode)mode;
+        query->algorithm = (PathAlgorithm)algorithm;
+        query->deadline = 0.0;
+        if (deadlineMs) *deadlineMs = (int)deadline;
+        return 0;
+    }
+    return -1;
+}
+
+// 解析一个查询行：格式正确时加入待提交的查询，否则写入错误结果
+static void parseQueryLine(BatchChunk* chunk, char* line, long long lineNumber) {
+    int index = chunk->count++;
+    chunk->texts[index].length = 0;
+    
+    const char* error;
+    if (parseRouteQuery(chunk->graph, line, &chunk->queries[chunk->queryCount], NULL, &error) != 0) {
+        setLineError(chunk, index, lineNumber, error);
+        return;
+    }
+    chunk->lineOf[chunk->queryCount++] = index;
+}
+
+// 读入下一块查询（最多BATCH_CHUNK_SIZE行，跳过空行和注释），返回读入的查询行数
+static int readChunk(BatchChunk* chunk, FILE* input, long long* lineNumber) {
+    char line[BATCH_LINE_LEN];
+    chunk->count = 0;
+    chunk->queryCount = 0;
+    
+    while (chunk->count < BATCH_CHUNK_SIZE && fgets(line, sizeof(line), input)) {
+        (*lineNumber)++;
+        size_t length = strlen(line);
+        if (length > 0 && line[length - 1] != '\n' && !feof(input)) {
+            // 行过长：丢弃剩余部分
+            int c;
+            while ((c = fgetc(input)) != EOF && c != '\n') {}
+            int index = chunk->count++;
+            chunk->texts[index].length = 0;
+            setLineError(chunk, index, *lineNumber, "行过长");
+            continue;
+        }
+        
+        trimString(line);
+        if (line[0] == '\0' || line[0] == '#') continue;
+        parseQueryLine(chunk, line, *lineNumber);
+    }
+    return chunk->count;
+}
+
+// 追加结果行：ok <代价> <距离> <时间> [节点1,节点2,...] 或 unreachable
+void formatRouteResult(RouteText* text, const Graph* graph, const RouteQuery* query, const PathResult* result,
+                       int printPath) {
+    if (!result->isValid) {
+        appendRouteText(text, "unreachable\n", 12);
+        return;
+    }
+    
+    long long cost = 0;
+    for (int i = 0; i + 1 < result->pathLength; i++) {
+        cost += graph->edges[result->edges[i]].modeWeight[query->mode];
+    }
+    appendFormat(text, "ok %lld %lld %lld", cost, result->totalDistance, result->totalTime);
+    
+    if (printPath) {
+        for (int i = 0; i < result->pathLength; i++) {
+            const char* name = graph->nodes[result->path[i]].name;
+            appendRouteText(text, i == 0 ? " " : ",", 1);
+            appendRouteText(text, name, (int)strlen(name));
+        }
+    }
+    appendRouteText(text, "\n", 1);
+}
+
+// 查询完成回调（在工作线程中执行）：格式化该查询的结果行
+static void onQueryDone(int index, const RouteQuery* query, const PathResult* result,
+                        double elapsedSeconds, void* userData) {
+    BatchChunk* chunk = (BatchChunk*)userData;
+    int line = chunk->lineOf[index];
+    chunk->latencies[index] = elapsedSeconds;
+    chunk->outcomes[line] = result->isValid ? BATCH_FOUND : BATCH_UNREACHABLE;
+    formatRouteResult(&chunk->texts[line], chunk->graph, query, result, chunk->printPath);
+}
+
+// 全部查询的搜索耗时
+typedef struct {
+    double* values;
+    long long count;
+    long long capacity;
+} LatencyLog;
+
+// 按输入顺序写出一块结果，并把统计计入汇总
+static void writeChunk(const BatchChunk* chunk, FILE* output, BatchSummary* summary, LatencyLog* latencyLog) {
+    for (int i = 0; i < chunk->count; i++) {
+        fwrite(chunk->texts[i].text, 1, (size_t)chunk->texts[i].length, output);
+        switch (chunk->outcomes[i]) {
+            case BATCH_FOUND: summary->found++; break;
+            case BATCH_UNREACHABLE: summary->unreachable++; break;
+            default: summary->errors++; break;
+        }
+    }
+    summary->queries += chunk->count;
+    
+    if (latencyLog->count + chunk->queryCount > latencyLog->capacity) {
+        long long capacity = latencyLog->capacity > 0 ? latencyLog->capacity : BATCH_CHUNK_SIZE;
+        while (latencyLog->count + chunk->queryCount > capacity) capacity *= 2;
+        latencyLog->values = (double*)safeRealloc(latencyLog->values, (size_t)capacity * sizeof(double));
+        latencyLog->capacity = capacity;
+    }
+    memcpy(latencyLog->values + latencyLog->count, chunk->latencies, (size_t)chunk->queryCount * sizeof(double));
+    latencyLog->count += chunk->queryCount;
+}
+
+static int compareLatency(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// 已排序数组的分位数（最近秩法）
+static double latencyPercentile(const double* sorted, long long count, double p) {
+    if (count == 0) return 0.0;
+    long long index = (long long)(p * count + 0.999999) - 1;
+    if (index < 0) index = 0;
+    if (index > count - 1) index = count - 1;
+    return sorted[index];
+}
+
+int runBatchQueries(Graph* graph, FILE* input, FILE* output, const BatchOptions* options,
+                    BatchSummary* summary) {
+    if (!graph || !input || !output || !options || !summary) return -1;
+    memset(summary, 0, sizeof(BatchSummary));
+    
+    double begin = getTimeSeconds();
+    QueryEngine* engine = createQueryEngine(graph, options->threadCount);
+    if (!engine) return -1;
+    summary->threadCount = engine->threadCount;
+    
+    // 两块交替使用：引擎查询一块的同时，主线程读入下一块并写出上一块
+    BatchChunk chunks[2];
+    initChunk(&chunks[0], graph, options->printPath);
+    initChunk(&chunks[1], graph, options->printPath);
+    LatencyLog latencyLog = { NULL, 0, 0 };
+    long long lineNumber = 0;
+    
+    int current = 0;
+    readChunk(&chunks[current], input, &lineNumber);
+    submitQueryBatch(engine, chunks[current].queries, chunks[current].queryCount, onQueryDone, &chunks[current]);
+    
+    while (chunks[current].count > 0) {
+        BatchChunk* next = &chunks[1 - current];
+        readChunk(next, input, &lineNumber);
+        waitQueryEngine(engine);
+        submitQueryBatch(engine, next->queries, next->queryCount, onQueryDone, next);
+        writeChunk(&chunks[current], output, summary, &latencyLog);
+        current = 1 - current;
+    }
+    fflush(output);
+    destroyQueryEngine(engine);
+    summary->elapsedSeconds = getTimeSeconds() - begin;
+    
+    if (latencyLog.count > 0) {
+        double total = 0.0;
+        for (long long i = 0; i < latencyLog.count; i++) {
+            total += latencyLog.values[i];
+        }
+        qsort(latencyLog.values, (size_t)latencyLog.count, sizeof(double), compareLatency);
+        summary->latencyMean = total / latencyLog.count;
+        summary->latencyP50 = latencyPercentile(latencyLog.values, latencyLog.count, 0.50);
+        summary->latencyP95 = latencyPercentile(latencyLog.values, latencyLog.count, 0.95);
+        summary->latencyP99 = latencyPercentile(latencyLog.values, latencyLog.count, 0.99);
+        summary->latencyMax = latencyLog.values[latencyLog.count - 1];
+    }
+    
+    free(latencyLog.values);
+    freeChunk(&chunks[0]);
+    freeChunk(&chunks[1]);
+    return 0;
+}
+
+void printBatchSummary(FILE* stream, const BatchSummary* summary) {
+    if (!stream || !summary) return;
+    
+    fprintf(stream, "批量查询: %lld 条（找到 %lld，不可达 %lld，错误 %lld），%d 个线程\n",
+            summary->queries, summary->found, summary->unreachable, summary->errors, summary->threadCount);
+    fprintf(stream, "总耗时: %.3f 秒，吞吐量: %.1f 条/秒\n", summary->elapsedSeconds,
+            summary->elapsedSeconds > 0.0 ? summary->queries / summary->elapsedSeconds : 0.0);
+    fprintf(stream, "搜索延迟（微秒）: 平均 %.1f，p50 %.1f，p95 %.1f，p99 %.1f，最大 %.1f\n",
+            summary->latencyMean * 1e6, summary->latencyP50 * 1e6, summary->latencyP95 * 1e6,
+            summary->latencyP99 * 1e6, summary->latencyMax * 1e6);
+}
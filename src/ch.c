@@ -0,0 +1,599 @@
+#include "../include/ch.h"
+#include "../include/utils.h"
+#include <string.h>
+
+#define ARC_LIST_INITIAL_CAPACITY 4
+
+// 节点的弧编号列表（收缩过程中只追加，失效的弧在遍历时跳过）
+typedef struct {
+    int* items;
+    int size;
+    int capacity;
+} ArcList;
+
+// 预处理期间的状态
+typedef struct {
+    int nodeCount;
+    CHArc* arcs;
+    int arcCount;
+    int arcCapacity;
+    unsigned char* dominated;   // 弧被更短的平行弧取代
+    ArcList* outArcs;
+    ArcList* inArcs;
+    unsigned char* contracted;
+    int* deletedNeighbors;      // 已收缩的邻居数（优先级项，使收缩在图中均匀展开）
+    int* touchedBy;             // 最近一次处理该邻居的被收缩节点编号加1（用于去重）
+    
+    // 见证搜索
+    int* witnessDist;
+    unsigned int* witnessStamp;
+    unsigned int* targetStamp;  // targetStamp[w]==witnessGeneration 表示w是本次搜索的目标
+    unsigned int witnessGeneration;
+    IndexedHeap* witnessHeap;
+} ContractionState;
+
+// 向列表追加弧编号（容量不足时倍增）
+static void arcListAppend(ArcList* list, int arcId) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : ARC_LIST_INITIAL_CAPACITY;
+        list->items = (int*)safeRealloc(list->items, (size_t)list->capacity * sizeof(int));
+    }
+    list->items[list->size++] = arcId;
+}
+
+// 弧在收缩图中是否仍然有效（未被取代且两端都未收缩）
+static inline int isArcAlive(const ContractionState* st, int arcId) {
+    const CHArc* arc = &st->arcs[arcId];
+    return !st->dominated[arcId] && !st->contracted[arc->from] && !st->contracted[arc->to];
+}
+
+// 添加弧：若已有不更长的平行弧则放弃，否则取代原有的平行弧
+// 返回新弧编号，未添加时返回-1
+static int addArc(ContractionState* st, int from, int to, int weight, int edgeId, int first, int second) {
+    ArcList* out = &st->outArcs[from];
+    for (int i = 0; i < out->size; i++) {
+        int existing = out->items[i];
+        if (st->arcs[existing].to != to || st->dominated[existing]) continue;
+        
+        if (st->arcs[existing].weight <= weight) return -1;
+        st->dominated[existing] = 1;
+    }
+    
+    if (st->arcCount == st->arcCapacity) {
+        st->arcCapacity *= 2;
+        st->arcs = (CHArc*)safeRealloc(st->arcs, (size_t)st->arcCapacity * sizeof(CHArc));
+        st->dominated = (unsigned char*)safeRealloc(st->dominated, (size_t)st->arcCapacity);
+    }
+    
+    int arcId = st->arcCount++;
+    CHArc* arc = &st->arcs[arcId];
+    arc->from = from;
+    arc->to = to;
+    arc->weight = weight;
+    arc->edgeId = edgeId;
+    arc->child[0] = first;
+    arc->child[1] = second;
+    arc->hops = edgeId != -1 ? 1 : st->arcs[first].hops + st->arcs[second].hops;
+    st->dominated[arcId] = 0;
+    
+    arcListAppend(out, arcId);
+    arcListAppend(&st->inArcs[to], arcId);
+    return arcId;
+}
+
+static inline int witnessDistance(const ContractionState* st, int v) {
+    return st->witnessStamp[v] == st->witnessGeneration ? st->witnessDist[v] : INF;
+}
+
+// 见证搜索：从source出发、不经过via和已收缩节点的受限Dijkstra，目标为via的出邻居。
+// 所有目标都已确定、键值超过maxCost或确定的节点数达到settleLimit时停止；之后witnessDistance为距离上界
+static void witnessSearch(ContractionState* st, int source, int via, int maxCost, int settleLimit) {
+    st->witnessGeneration++;
+    if (st->witnessGeneration == 0) {
+        memset(st->witnessStamp, 0, (size_t)st->nodeCount * sizeof(unsigned int));
+        memset(st->targetStamp, 0, (size_t)st->nodeCount * sizeof(unsigned int));
+        st->witnessGeneration = 1;
+    }
+    
+    int remaining = 0;
+    ArcList* targets = &st->outArcs[via];
+    for (int i = 0; i < targets->size; i++) {
+        int w = st->arcs[targets->items[i]].to;
+        if (!isArcAlive(st, targets->items[i]) || w == source || st->targetStamp[w] == st->witnessGeneration) {
+            continue;
+        }
+        st->targetStamp[w] = st->witnessGeneration;
+        remaining++;
+    }
+    
+    st->witnessStamp[source] = st->witnessGeneration;
+    st->witnessDist[source] = 0;
+    indexedHeapPush(st->witnessHeap, source, 0);
+    
+    int settled = 0;
+    while (!isIndexedHeapEmpty(st->witnessHeap)) {
+        int key;
+        int u = indexedHeapPop(st->witnessHeap, &key);
+        if (key > maxCost || ++settled > settleLimit) break;
+        if (st->targetStamp[u] == st->witnessGeneration && --remaining == 0) break;
+        
+        ArcList* out = &st->outArcs[u];
+        for (int i = 0; i < out->size; i++) {
+            int arcId = out->items[i];
+            if (!isArcAlive(st, arcId)) continue;
+            
+            int w = st->arcs[arcId].to;
+            if (w == via) continue;
+            
+            int newDist = key + st->arcs[arcId].weight;
+            if (newDist < witnessDistance(st, w)) {
+                st->witnessStamp[w] = st->witnessGeneration;
+                st->witnessDist[w] = newDist;
+                indexedHeapPush(st->witnessHeap, w, newDist);
+            }
+        }
+    }
+    
+    clearIndexedHeap(st->witnessHeap);
+}
+
+// 收缩节点v：对每对入弧(u→v)和出弧(v→w)，若不存在不经过v且不更长的见证路径则添加shortcut u→w。
+// simulate为真时只统计需要的shortcut数而不添加。返回shortcut数
+static int contractNode(ContractionState* st, int v, int simulate, int settleLimit) {
+    ArcList* in = &st->inArcs[v];
+    ArcList* out = &st->outArcs[v];
+    int shortcuts = 0;
+    
+    for (int i = 0; i < in->size; i++) {
+        int inArc = in->items[i];
+        if (!isArcAlive(st, inArc)) continue;
+        
+        int u = st->arcs[inArc].from;
+        int inWeight = st->arcs[inArc].weight;
+        
+        // 见证搜索的范围：经过v到达各出邻居的最大代价
+        int maxCost = -1;
+        for (int j = 0; j < out->size; j++) {
+            int outArc = out->items[j];
+            if (!isArcAlive(st, outArc) || st->arcs[outArc].to == u) continue;
+            maxCost = maxInt(maxCost, inWeight + st->arcs[outArc].weight);
+        }
+        if (maxCost < 0) continue;
+        
+        witnessSearch(st, u, v, maxCost, settleLimit);
+        
+        for (int j = 0; j < out->size; j++) {
+            int outArc = out->items[j];
+            if (!isArcAlive(st, outArc)) continue;
+            
+            int w = st->arcs[outArc].to;
+            int viaWeight = inWeight + st->arcs[outArc].weight;
+            if (w == u || witnessDistance(st, w) <= viaWeight) continue;
+            
+            shortcuts++;
+            if (!simulate) {
+                addArc(st, u, w, viaWeight, -1, inArc, outArc);
+            }
+        }
+    }
+    
+    return shortcuts;
+}
+
+// 节点优先级：边差（新增shortcut数减去移除的弧数）的2倍加上已收缩的邻居数，越小越先收缩
+static int nodePriority(ContractionState* st, int v) {
+    int removed = 0;
+    for (int i = 0; i < st->inArcs[v].size; i++) {
+        if (isArcAlive(st, st->inArcs[v].items[i])) removed++;
+    }
+    for (int i = 0; i < st->outArcs[v].size; i++) {
+        if (isArcAlive(st, st->outArcs[v].items[i])) removed++;
+    }
+    
+    int shortcuts = contractNode(st, v, 1, CH_SIMULATE_SETTLE_LIMIT);
+    return 2 * (shortcuts - removed) + st->deletedNeighbors[v];
+}
+
+// 从列表中移除失效的弧
+static void pruneArcList(const ContractionState* st, ArcList* list) {
+    int size = 0;
+    for (int i = 0; i < list->size; i++) {
+        if (isArcAlive(st, list->items[i])) {
+            list->items[size++] = list->items[i];
+        }
+    }
+    list->size = size;
+}
+
+// 节点v收缩后处理其未收缩的邻居（入弧和出弧中重复出现的邻居只处理一次）
+static void updateNeighbors(ContractionState* st, IndexedHeap* order, int v) {
+    for (int side = 0; side < 2; side++) {
+        ArcList* list = side == 0 ? &st->inArcs[v] : &st->outArcs[v];
+        for (int i = 0; i < list->size; i++) {
+            const CHArc* arc = &st->arcs[list->items[i]];
+            int neighbor = side == 0 ? arc->from : arc->to;
+            if (st->contracted[neighbor] || st->dominated[list->items[i]] ||
+                st->touchedBy[neighbor] == v + 1) {
+                continue;
+            }
+            st->touchedBy[neighbor] = v + 1;
+            
+            st->deletedNeighbors[neighbor]++;
+            pruneArcList(st, &st->inArcs[neighbor]);
+            pruneArcList(st, &st->outArcs[neighbor]);
+            indexedHeapUpdate(order, neighbor, nodePriority(st, neighbor));
+        }
+    }
+}
+
+// 分配count个元素并清零
+static void* zeroAlloc(int count, size_t size) {
+    size_t bytes = (size_t)maxInt(count, 1) * size;
+    void* ptr = safeMalloc(bytes);
+    memset(ptr, 0, bytes);
+    return ptr;
+}
+
+// 释放预处理状态（arcs的所有权转移后置为NULL）
+static void freeContractionState(ContractionState* st) {
+    if (st->outArcs) {
+        for (int v = 0; v < st->nodeCount; v++) {
+            free(st->outArcs[v].items);
+            free(st->inArcs[v].items);
+        }
+    }
+    free(st->outArcs);
+    free(st->inArcs);
+    free(st->arcs);
+    free(st->dominated);
+    free(st->contracted);
+    free(st->deletedNeighbors);
+    free(st->touchedBy);
+    free(st->witnessDist);
+    free(st->witnessStamp);
+    free(st->targetStamp);
+    destroyIndexedHeap(st->witnessHeap);
+}
+
+// 按层次关系生成查询图：低层→高层的弧放入up，高层→低层的弧按终点放入down
+static void buildQueryGraph(ContractionHierarchy* ch, const unsigned char* dominated) {
+    int n = ch->nodeCount;
+    ch->upOffsets = (int*)safeMalloc((size_t)(n + 1) * sizeof(int));
+    ch->downOffsets = (int*)safeMalloc((size_t)(n + 1) * sizeof(int));
+    for (int v = 0; v <= n; v++) {
+        ch->upOffsets[v] = 0;
+        ch->downOffsets[v] = 0;
+    }
+    
+    // 统计每个节点的弧数
+    for (int a = 0; a < ch->arcCount; a++) {
+        if (dominated[a]) continue;
+        const CHArc* arc = &ch->arcs[a];
+        if (ch->rank[arc->from] < ch->rank[arc->to]) {
+            ch->upOffsets[arc->from + 1]++;
+        } else {
+            ch->downOffsets[arc->to + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        ch->upOffsets[v + 1] += ch->upOffsets[v];
+        ch->downOffsets[v + 1] += ch->downOffsets[v];
+    }
+    
+    ch->upEdges = (CHQueryEdge*)safeMalloc((size_t)maxInt(ch->upOffsets[n], 1) * sizeof(CHQueryEdge));
+    ch->downEdges = (CHQueryEdge*)safeMalloc((size_t)maxInt(ch->downOffsets[n], 1) * sizeof(CHQueryEdge));
+    
+    // 填充（借用offsets作为写指针，结束后还原）
+    for (int a = 0; a < ch->arcCount; a++) {
+        if (dominated[a]) continue;
+        const CHArc* arc = &ch->arcs[a];
+        CHQueryEdge* edge;
+        if (ch->rank[arc->from] < ch->rank[arc->to]) {
+            edge = &ch->upEdges[ch->upOffsets[arc->from]++];
+            edge->target = arc->to;
+        } else {
+            edge = &ch->downEdges[ch->downOffsets[arc->to]++];
+            edge->target = arc->from;
+        }
+        edge->weight = arc->weight;
+        edge->arcId = a;
+    }
+    for (int v = n; v > 0; v--) {
+        ch->upOffsets[v] = ch->upOffsets[v - 1];
+        ch->downOffsets[v] = ch->downOffsets[v - 1];
+    }
+    ch->upOffsets[0] = 0;
+    ch->downOffsets[0] = 0;
+}
+
+// 构建指定交通方式的收缩层次：只包含可通行的边和活跃节点
+ContractionHierarchy* buildContractionHierarchy(Graph* graph, TransportMode mode) {
+    if (!graph || mode < 0 || mode >= MODE_COUNT) return NULL;
+    
+    int n = graph->nodeCount;
+    ContractionState st;
+    memset(&st, 0, sizeof(st));
+    st.nodeCount = n;
+    st.arcCapacity = maxInt(graph->edgeCount * 2, 16);
+    st.arcs = (CHArc*)safeMalloc((size_t)st.arcCapacity * sizeof(CHArc));
+    st.dominated = (unsigned char*)safeMalloc((size_t)st.arcCapacity);
+    st.outArcs = (ArcList*)zeroAlloc(n, sizeof(ArcList));
+    st.inArcs = (ArcList*)zeroAlloc(n, sizeof(ArcList));
+    st.contracted = (unsigned char*)zeroAlloc(n, 1);
+    st.deletedNeighbors = (int*)zeroAlloc(n, sizeof(int));
+    st.touchedBy = (int*)zeroAlloc(n, sizeof(int));
+    st.witnessDist = (int*)safeMalloc((size_t)maxInt(n, 1) * sizeof(int));
+    st.witnessStamp = (unsigned int*)zeroAlloc(n, sizeof(unsigned int));
+    st.targetStamp = (unsigned int*)zeroAlloc(n, sizeof(unsigned int));
+    st.witnessHeap = createIndexedHeap(n);
+    
+    IndexedHeap* order = createIndexedHeap(n);
+    ContractionHierarchy* ch = (ContractionHierarchy*)safeMalloc(sizeof(ContractionHierarchy));
+    if (!st.witnessHeap || !order || !ch) {
+        freeContractionState(&st);
+        destroyIndexedHeap(order);
+        free(ch);
+        return NULL;
+    }
+    
+    memset(ch, 0, sizeof(ContractionHierarchy));
+    ch->mode = mode;
+    ch->nodeCount = n;
+    ch->edgeCount = graph->edgeCount;
+    ch->rank = (int*)safeMalloc((size_t)maxInt(n, 1) * sizeof(int));
+    
+    // 原始边（平行边只保留最短的一条）
+    for (int e = 0; e < graph->edgeCount; e++) {
+        Edge* edge = &graph->edges[e];
+        if (!edge->isAccessible || edge->from == edge->to ||
+            !graph->nodes[edge->from].isActive || !graph->nodes[edge->to].isActive) {
+            continue;
+        }
+        addArc(&st, edge->from, edge->to, edge->modeWeight[mode], e, -1, -1);
+    }
+    
+    // 不活跃的节点不参与收缩，排在最低层
+    int nextRank = 0;
+    for (int v = 0; v < n; v++) {
+        if (!graph->nodes[v].isActive) {
+            st.contracted[v] = 1;
+            ch->rank[v] = nextRank++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (!st.contracted[v]) {
+            indexedHeapPush(order, v, nodePriority(&st, v));
+        }
+    }
+    
+    // 按优先级依次收缩；出堆时重新计算优先级（惰性更新），变大则放回堆中
+    while (!isIndexedHeapEmpty(order)) {
+        int v = indexedHeapPop(order, NULL);
+        int priority = nodePriority(&st, v);
+        if (!isIndexedHeapEmpty(order) && priority > indexedHeapTopKey(order)) {
+            indexedHeapPush(order, v, priority);
+            continue;
+        }
+        
+        contractNode(&st, v, 0, CH_WITNESS_SETTLE_LIMIT);
+        st.contracted[v] = 1;
+        ch->rank[v] = nextRank++;
+        
+        // 更新邻居：累计已收缩邻居数，清理失效的弧并重新计算优先级
+        updateNeighbors(&st, order, v);
+    }
+    destroyIndexedHeap(order);
+    
+    // 转移弧数组的所有权
+    ch->arcs = st.arcs;
+    ch->arcCount = st.arcCount;
+    for (int a = 0; a < st.arcCount; a++) {
+        if (st.arcs[a].edgeId == -1) ch->shortcutCount++;
+    }
+    st.arcs = NULL;
+    
+    buildQueryGraph(ch, st.dominated);
+    freeContractionState(&st);
+    return ch;
+}
+
+// 销毁收缩层次
+void destroyContractionHierarchy(ContractionHierarchy* ch) {
+    if (!ch) return;
+    
+    free(ch->rank);
+    free(ch->arcs);
+    free(ch->upOffsets);
+    free(ch->upEdges);
+    free(ch->downOffsets);
+    free(ch->downEdges);
+    free(ch);
+}
+
+// ==================== 查询 ====================
+
+// 按搜索方向扫描节点的弧：正向沿up图，反向沿down图
+static inline void queryEdges(const ContractionHierarchy* ch, int upward, int v,
+                              const CHQueryEdge** first, const CHQueryEdge** last) {
+    if (upward) {
+        *first = ch->upEdges + ch->upOffsets[v];
+        *last = ch->upEdges + ch->upOffsets[v + 1];
+    } else {
+        *first = ch->downEdges + ch->downOffsets[v];
+        *last = ch->downEdges + ch->downOffsets[v + 1];
+    }
+}
+
+// stall-on-demand：若某个更高层节点w经由弧到达v比当前标签更短，则v的标签不是最短距离，无需扩展
+static int isStalled(const ContractionHierarchy* ch, const SearchLabels* labels, int upward, int v) {
+    const CHQueryEdge* edge;
+    const CHQueryEdge* last;
+    queryEdges(ch, !upward, v, &edge, &last);
+    
+    int dist = labels->dist[v];
+    for (; edge < last; edge++) {
+        int otherDist = labelDist(labels, edge->target);
+        if (otherDist != INF && otherDist + edge->weight < dist) return 1;
+    }
+    return 0;
+}
+
+// 将弧展开为原始边，从下标position开始写入path[position+1..]和edges[position..]，返回写入后的下标
+static int unpackArc(const ContractionHierarchy* ch, Graph* graph, int arcId, int* path, int* edges,
+                     int position, PathResult* result) {
+    const CHArc* arc = &ch->arcs[arcId];
+    if (arc->edgeId == -1) {
+        position = unpackArc(ch, graph, arc->child[0], path, edges, position, result);
+        return unpackArc(ch, graph, arc->child[1], path, edges, position, result);
+    }
+    
+    Edge* edge = &graph->edges[arc->edgeId];
+    if (edges) edges[position] = arc->edgeId;
+    path[position + 1] = arc->to;
+    result->totalDistance += edge->distance;
+    result->totalTime += edge->timeCost;
+    return position + 1;
+}
+
+// 写入CH查询结果：起点沿正向前驱弧到meet，再沿反向后继弧到终点，逐条展开shortcut
+static int writeCHResult(SearchWorkspace* ws, const ContractionHierarchy* ch, Graph* graph, int start, int meet,
+                         const PathBuffer* buffer, PathResult* result) {
+    result->path = NULL;
+    result->edges = NULL;
+    result->pathLength = 0;
+    result->totalDistance = 0;
+    result->totalTime = 0;
+    result->isValid = 0;
+    
+    if (meet < 0) return 0;  // 无路径
+    
+    const int* prevArc = ws->forward.prevEdge;
+    const int* nextArc = ws->backward.prevEdge;
+    
+    // 展开后的边数：正向部分和反向部分之和
+    int forwardHops = 0;
+    int backwardHops = 0;
+    for (int v = meet; prevArc[v] != -1; v = ch->arcs[prevArc[v]].from) {
+        forwardHops += ch->arcs[prevArc[v]].hops;
+    }
+    for (int v = meet; nextArc[v] != -1; v = ch->arcs[nextArc[v]].to) {
+        backwardHops += ch->arcs[nextArc[v]].hops;
+    }
+    int pathLength = forwardHops + backwardHops + 1;
+    
+    int* path;
+    int* edges;
+    if (reservePathStorage(ws, buffer, pathLength, &path, &edges) != 0) {
+        result->pathLength = pathLength;
+        return -2;
+    }
+    
+    // 正向部分：从meet回溯，每条弧写入它在路径中的位置
+    path[0] = start;
+    int position = forwardHops;
+    for (int v = meet; prevArc[v] != -1; v = ch->arcs[prevArc[v]].from) {
+        position -= ch->arcs[prevArc[v]].hops;
+        unpackArc(ch, graph, prevArc[v], path, edges, position, result);
+    }
+    
+    // 反向部分：从meet顺序走向终点
+    position = forwardHops;
+    for (int v = meet; nextArc[v] != -1; v = ch->arcs[nextArc[v]].to) {
+        position = unpackArc(ch, graph, nextArc[v], path, edges, position, result);
+    }
+    
+    result->path = path;
+    result->edges = edges;
+    result->pathLength = pathLength;
+    result->isValid = 1;
+    return 0;
+}
+
+// CH查询：正向只沿up图、反向只沿down图搜索，两侧都只走向更高层节点。
+// 最短路径上层次最高的节点会被两侧同时确定；某一侧堆顶不小于mu后该侧停止
+int chSearch(SearchWorkspace* ws, const ContractionHierarchy* ch, Graph* graph, int start, int end,
+             const PathBuffer* buffer, PathResult* result) {
+    if (!ws || !ch || !graph || !result || ch->nodeCount != graph->nodeCount ||
+        !isValidNodeId(start, graph->nodeCount) || !isValidNodeId(end, graph->nodeCount)) {
+        return -1;
+    }
+    if (beginBidirectionalSearch(ws, graph) != 0) return -1;
+    
+    SearchLabels* forward = &ws->forward;
+    SearchLabels* backward = &ws->backward;
+    int mu = INF;
+    int meet = -1;
+    
+    setLabel(forward, start, 0, -1);
+    setLabel(backward, end, 0, -1);
+    if (start == end) {
+        mu = 0;
+        meet = start;
+    } else {
+        indexedHeapPush(forward->heap, start, 0);
+        indexedHeapPush(backward->heap, end, 0);
+        SEARCH_STAT_ADD(ws, queuePushes, 2);
+    }
+    
+    int expandForward = 1;
+    while (1) {
+        int forwardDone = isIndexedHeapEmpty(forward->heap) || indexedHeapTopKey(forward->heap) >= mu;
+        int backwardDone = isIndexedHeapEmpty(backward->heap) || indexedHeapTopKey(backward->heap) >= mu;
+        if (forwardDone && backwardDone) break;
+        
+        // 两个方向交替扩展，已停止的一侧跳过
+        int isForward = forwardDone ? 0 : (backwardDone ? 1 : expandForward);
+        expandForward = !isForward;
+        
+        SearchLabels* labels = isForward ? forward : backward;
+        SearchLabels* other = isForward ? backward : forward;
+        int current = indexedHeapPop(labels->heap, NULL);
+        markSettled(labels, current);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
+        
+        int currentDist = labels->dist[current];
+        int otherDist = labelDist(other, current);
+        if (otherDist != INF && currentDist + otherDist < mu) {
+            mu = currentDist + otherDist;
+            meet = current;
+        }
+        
+        if (isStalled(ch, labels, isForward, current)) continue;
+        
+        const CHQueryEdge* edge;
+        const CHQueryEdge* last;
+        queryEdges(ch, isForward, current, &edge, &last);
+        SEARCH_STAT_ADD(ws, relaxedEdges, last - edge);
+        for (; edge < last; edge++) {
+            int neighbor = edge->target;
+            if (isSettled(labels, neighbor)) continue;
+            
+            int newDist = currentDist + edge->weight;
+            if (newDist < labelDist(labels, neighbor)) {
+                setLabel(labels, neighbor, newDist, edge->arcId);
+                indexedHeapPush(labels->heap, neighbor, newDist);
+                SEARCH_STAT_PUSH(ws, forward->heap->size + backward->heap->size);
+            }
+        }
+    }
+    
+    SEARCH_STAT_FINISH(ws);
+    return writeCHResult(ws, ch, graph, start, meet, buffer, result);
+}
+
+// 使用临时工作区进行CH查询，返回独立分配的结果
+PathResult* chFindPath(const ContractionHierarchy* ch, Graph* graph, int start, int end) {
+    if (!ch || !graph) return NULL;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    if (!ws) return NULL;
+    
+    PathResult* result = NULL;
+    PathResult local;
+    if (chSearch(ws, ch, graph, start, end, NULL, &local) == 0) {
+        result = copyPathResult(&local);
+    }
+    
+    destroySearchWorkspace(ws);
+    return result;
+}
@@ -0,0 +1,319 @@
+#include "../include/dynspt.h"
+#include "../include/utils.h"
+
+// 节点v是否已到达且会被扩展（不活跃的起点虽有代价但不扩展）
+static int isExpanded(const DynamicSPT* dyn, int v) {
+    return dyn->tree->dist[v] != INF && dyn->graph->nodes[v].isActive;
+}
+
+// 树和辅助数组的节点容量跟随图增长（新增的节点不可达）
+static void growDynamicSPT(DynamicSPT* dyn) {
+    ShortestPathTree* tree = dyn->tree;
+    int n = dyn->graph->nodeCount;
+    
+    if (n > tree->nodeCount) {
+        tree->dist = (int*)safeRealloc(tree->dist, (size_t)n * sizeof(int));
+        tree->prevNode = (int*)safeRealloc(tree->prevNode, (size_t)n * sizeof(int));
+        tree->prevEdge = (int*)safeRealloc(tree->prevEdge, (size_t)n * sizeof(int));
+        for (int v = tree->nodeCount; v < n; v++) {
+            tree->dist[v] = INF;
+            tree->prevNode[v] = -1;
+            tree->prevEdge[v] = -1;
+        }
+        tree->nodeCount = n;
+    }
+    
+    if (n > dyn->capacity) {
+        int capacity = maxInt(n, dyn->capacity * 2);
+        dyn->affected = (unsigned int*)safeRealloc(dyn->affected, (size_t)capacity * sizeof(unsigned int));
+        dyn->affectedList = (int*)safeRealloc(dyn->affectedList, (size_t)capacity * sizeof(int));
+        dyn->inHead = (int*)safeRealloc(dyn->inHead, (size_t)capacity * sizeof(int));
+        for (int v = dyn->capacity; v < capacity; v++) {
+            dyn->affected[v] = 0;
+            dyn->inHead[v] = -1;
+        }
+        reserveIndexedHeap(dyn->heap, capacity);
+        dyn->capacity = capacity;
+    }
+    
+    int m = dyn->graph->edgeCount;
+    if (m > dyn->edgeCapacity) {
+        int capacity = maxInt(m, dyn->edgeCapacity * 2);
+        dyn->inNext = (int*)safeRealloc(dyn->inNext, (size_t)capacity * sizeof(int));
+        dyn->edgeCapacity = capacity;
+    }
+}
+
+// 把边加入终点的入边链表（头插）
+static void linkInEdge(DynamicSPT* dyn, int edgeId) {
+    int to = dyn->graph->edges[edgeId].to;
+    dyn->inNext[edgeId] = dyn->inHead[to];
+    dyn->inHead[to] = edgeId;
+}
+
+// 边是否仍在起点的邻接表中（removeEdge会把边摘出邻接表）
+static int isLinkedEdge(const Graph* graph, int edgeId) {
+    for (int e = graph->adjHead[graph->edges[edgeId].from]; e != -1; e = graph->adjNext[e]) {
+        if (e == edgeId) return 1;
+    }
+    return 0;
+}
+
+// 把已摘除的边移出终点的入边链表，之后不再作为前驱考虑
+static void detachInEdge(DynamicSPT* dyn, int edgeId) {
+    int* link = &dyn->inHead[dyn->graph->edges[edgeId].to];
+    while (*link != -1 && *link != edgeId) {
+        link = &dyn->inNext[*link];
+    }
+    if (*link == edgeId) *link = dyn->inNext[edgeId];
+    dyn->inNext[edgeId] = DETACHED_EDGE;
+}
+
+// 更新节点v的代价和前驱并放入堆
+static void improveNode(DynamicSPT* dyn, int v, int dist, int edgeId) {
+    ShortestPathTree* tree = dyn->tree;
+    tree->dist[v] = dist;
+    tree->prevEdge[v] = edgeId;
+    tree->prevNode[v] = edgeId == -1 ? -1 : dyn->graph->edges[edgeId].from;
+    indexedHeapPush(dyn->heap, v, dist);
+}
+
+// 局部Dijkstra：从堆中的节点出发沿出边松弛，返回出堆的节点数
+static int propagate(DynamicSPT* dyn) {
+    Graph* graph = dyn->graph;
+    ShortestPathTree* tree = dyn->tree;
+    TransportMode mode = tree->mode;
+    
+    int touched = 0;
+    while (!isIndexedHeapEmpty(dyn->heap)) {
+        int current = indexedHeapPop(dyn->heap, NULL);
+        touched++;
+        if (!graph->nodes[current].isActive) continue;
+        
+        int currentDist = tree->dist[current];
+        for (int e = graph->adjHead[current]; e != -1; e = graph->adjNext[e]) {
+            Edge* edge = &graph->edges[e];
+            int neighbor = edge->to;
+            
+            if (!edge->isAccessible || !graph->nodes[neighbor].isActive) continue;
+            
+            long long newDist = (long long)currentDist + edge->modeWeight[mode];
+            if (newDist < tree->dist[neighbor]) {
+                improveNode(dyn, neighbor, (int)newDist, e);
+            }
+        }
+    }
+    return touched;
+}
+
+// 边edgeId变得更便宜、可通行或新增后，若能改善其终点则放入堆（已摘除的边不在图中，忽略）
+static void relaxChangedEdge(DynamicSPT* dyn, int edgeId) {
+    Graph* graph = dyn->graph;
+    Edge* edge = &graph->edges[edgeId];
+    
+    if (dyn->inNext[edgeId] == DETACHED_EDGE) return;
+    if (!edge->isAccessible || !graph->nodes[edge->to].isActive || !isExpanded(dyn, edge->from)) return;
+    
+    long long newDist = (long long)dyn->tree->dist[edge->from] + edge->modeWeight[dyn->tree->mode];
+    if (newDist < dyn->tree->dist[edge->to]) {
+        improveNode(dyn, edge->to, (int)newDist, edgeId);
+    }
+}
+
+// 经入边链表取进入v的最好代价（只考虑已扩展的前驱），无可用入边时不修改
+static void relaxFromPredecessors(DynamicSPT* dyn, int v) {
+    Graph* graph = dyn->graph;
+    ShortestPathTree* tree = dyn->tree;
+    
+    long long best = tree->dist[v];
+    int bestEdge = -1;
+    for (int e = dyn->inHead[v]; e != -1; e = dyn->inNext[e]) {
+        const Edge* edge = &graph->edges[e];
+        if (!edge->isAccessible || !isExpanded(dyn, edge->from)) continue;
+        
+        long long candidate = (long long)tree->dist[edge->from] + edge->modeWeight[tree->mode];
+        if (candidate < best) {
+            best = candidate;
+            bestEdge = e;
+        }
+    }
+    if (bestEdge != -1) {
+        improveNode(dyn, v, (int)best, bestEdge);
+    }
+}
+
+// 代价增大：重新计算以root为根的子树，返回子树节点数
+static int repairSubtree(DynamicSPT* dyn, int root) {
+    Graph* graph = dyn->graph;
+    ShortestPathTree* tree = dyn->tree;
+    
+    if (++dyn->stamp == 0) {
+        memset(dyn->affected, 0, (size_t)dyn->capacity * sizeof(unsigned int));
+        dyn->stamp = 1;
+    }
+    
+    // 沿树边收集子树：y是x的孩子当且仅当y的前驱边是x的出边
+    int count = 0;
+    dyn->affected[root] = dyn->stamp;
+    dyn->affectedList[count++] = root;
+    for (int i = 0; i < count; i++) {
+        int x = dyn->affectedList[i];
+        for (int e = graph->adjHead[x]; e != -1; e = graph->adjNext[e]) {
+            int y = graph->edges[e].to;
+            if (tree->prevEdge[y] == e && dyn->affected[y] != dyn->stamp) {
+                dyn->affected[y] = dyn->stamp;
+                dyn->affectedList[count++] = y;
+            }
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        int y = dyn->affectedList[i];
+        tree->dist[y] = INF;
+        tree->prevNode[y] = -1;
+        tree->prevEdge[y] = -1;
+    }
+    
+    // 逐个节点从入边取初始代价。先处理的子树节点得到有限值后，后面的节点可能经由它取值，
+    // 因此这些代价只是初始估计（不低于真实距离），由propagate在子树内传播修正
+    for (int i = 0; i < count; i++) {
+        int y = dyn->affectedList[i];
+        if (y == tree->source) {
+            improveNode(dyn, y, 0, -1);
+        } else if (graph->nodes[y].isActive) {
+            relaxFromPredecessors(dyn, y);
+        }
+    }
+    propagate(dyn);
+    return count;
+}
+
+// 代价减小：节点恢复可访问后从它开始传播
+static int repairReactivatedNode(DynamicSPT* dyn, int v) {
+    if (v == dyn->tree->source) {
+        improveNode(dyn, v, 0, -1);
+    } else {
+        relaxFromPredecessors(dyn, v);
+    }
+    return propagate(dyn);
+}
+
+// 按一次图修改修复树
+int repairDynamicSPT(DynamicSPT* dyn, const GraphChange* change) {
+    if (!dyn || !change) return -1;
+    
+    growDynamicSPT(dyn);
+    
+    ShortestPathTree* tree = dyn->tree;
+    int touched = 0;
+    switch (change->type) {
+        case GRAPH_CHANGE_NODE_ADDED:
+            break;  // 孤立的新节点不可达
+        case GRAPH_CHANGE_EDGE_ADDED:
+            linkInEdge(dyn, change->edgeId);
+            relaxChangedEdge(dyn, change->edgeId);
+            touched = propagate(dyn);
+            break;
+        case GRAPH_CHANGE_EDGE_WEIGHT:
+        case GRAPH_CHANGE_EDGE_ACCESS: {
+            if (change->type == GRAPH_CHANGE_EDGE_WEIGHT && change->mode != tree->mode) break;
+            
+            // removeEdge以阻断通知；边被摘出邻接表后也从入边链表中移除
+            if (change->type == GRAPH_CHANGE_EDGE_ACCESS && dyn->inNext[change->edgeId] != DETACHED_EDGE &&
+                !isLinkedEdge(dyn->graph, change->edgeId)) {
+                detachInEdge(dyn, change->edgeId);
+            }
+            
+            int to = dyn->graph->edges[change->edgeId].to;
+            int increased = change->type == GRAPH_CHANGE_EDGE_WEIGHT ?
+                            change->newValue > change->oldValue : !change->newValue;
+            if (!increased) {
+                relaxChangedEdge(dyn, change->edgeId);
+                touched = propagate(dyn);
+            } else if (tree->prevEdge[to] == change->edgeId) {
+                touched = repairSubtree(dyn, to);
+            }
+            break;
+        }
+        case GRAPH_CHANGE_NODE_ACCESS:
+            if (change->newValue) {
+                touched = repairReactivatedNode(dyn, change->nodeId);
+            } else if (tree->dist[change->nodeId] != INF) {
+                touched = repairSubtree(dyn, change->nodeId);
+            }
+            break;
+    }
+    if (touched < 0) return -1;
+    
+    dyn->repairs++;
+    dyn->touchedNodes += touched;
+    dyn->lastTouched = touched;
+    return touched;
+}
+
+// 图变化监听
+static void onGraphChange(Graph* graph, const GraphChange* change, void* userData) {
+    (void)graph;
+    repairDynamicSPT((DynamicSPT*)userData, change);
+}
+
+// 创建动态最短路径树
+DynamicSPT* createDynamicSPT(Graph* graph, int source, TransportMode mode) {
+    ShortestPathTree* tree = buildShortestPathTree(graph, source, mode);
+    if (!tree) return NULL;
+    
+    DynamicSPT* dyn = (DynamicSPT*)safeMalloc(sizeof(DynamicSPT));
+    if (!dyn) {
+        destroyShortestPathTree(tree);
+        return NULL;
+    }
+    
+    int capacity = maxInt(graph->nodeCount, 1);
+    dyn->graph = graph;
+    dyn->tree = tree;
+    dyn->heap = createIndexedHeap(capacity);
+    dyn->affected = (unsigned int*)safeMalloc((size_t)capacity * sizeof(unsigned int));
+    dyn->affectedList = (int*)safeMalloc((size_t)capacity * sizeof(int));
+    memset(dyn->affected, 0, (size_t)capacity * sizeof(unsigned int));
+    dyn->inHead = (int*)safeMalloc((size_t)capacity * sizeof(int));
+    dyn->inNext = (int*)safeMalloc((size_t)maxInt(graph->edgeCount, 1) * sizeof(int));
+    dyn->stamp = 0;
+    dyn->capacity = capacity;
+    dyn->edgeCapacity = maxInt(graph->edgeCount, 1);
+    dyn->repairs = 0;
+    dyn->touchedNodes = 0;
+    dyn->lastTouched = 0;
+    
+    // 入边链表只包含仍在邻接表中的边（已摘除的边标记为DETACHED_EDGE）
+    for (int v = 0; v < capacity; v++) {
+        dyn->inHead[v] = -1;
+    }
+    for (int e = 0; e < graph->edgeCount; e++) {
+        dyn->inNext[e] = DETACHED_EDGE;
+    }
+    for (int v = 0; v < graph->nodeCount; v++) {
+        for (int e = graph->adjHead[v]; e != -1; e = graph->adjNext[e]) {
+            linkInEdge(dyn, e);
+        }
+    }
+    
+    if (!dyn->heap || addGraphListener(graph, onGraphChange, dyn) != 0) {
+        destroyDynamicSPT(dyn);
+        return NULL;
+    }
+    return dyn;
+}
+
+// 销毁动态最短路径树
+void destroyDynamicSPT(DynamicSPT* dyn) {
+    if (!dyn) return;
+    
+    removeGraphListener(dyn->graph, onGraphChange, dyn);
+    destroyShortestPathTree(dyn->tree);
+    destroyIndexedHeap(dyn->heap);
+    free(dyn->affected);
+    free(dyn->affectedList);
+    free(dyn->inHead);
+    free(dyn->inNext);
+    free(dyn);
+}
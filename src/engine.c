@@ -0,0 +1,179 @@
+#include "../include/engine.h"
+#include "../include/utils.h"
+
+// 工作线程：按块领取任务，在自己的工作区上执行查询并回调
+static void* engineWorker(void* arg) {
+    QueryEngine* engine = (QueryEngine*)arg;
+    Graph* graph = engine->graph;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    QueryTask chunk[ENGINE_MAX_CHUNK];
+    
+    while (1) {
+        pthread_mutex_lock(&engine->lock);
+        while (engine->head == engine->tail && !engine->shuttingDown) {
+            pthread_cond_wait(&engine->workAvailable, &engine->lock);
+        }
+        if (engine->head == engine->tail) {
+            pthread_mutex_unlock(&engine->lock);
+            break;
+        }
+        
+        // 块大小按剩余任务在线程间平分，避免少量任务被一个线程全部取走
+        int pending = engine->tail - engine->head;
+        int count = minInt(ENGINE_MAX_CHUNK, maxInt(1, pending / engine->threadCount));
+        memcpy(chunk, engine->tasks + engine->head, (size_t)count * sizeof(QueryTask));
+        engine->head += count;
+        if (engine->head == engine->tail) {
+            engine->head = 0;
+            engine->tail = 0;
+        }
+        pthread_mutex_unlock(&engine->lock);
+        
+        for (int i = 0; i < count; i++) {
+            const RouteQuery* query = &chunk[i].query;
+            PathResult result;
+            double begin = getTimeSeconds();
+            int expired = query->deadline > 0.0 && begin > query->deadline;
+            if (!ws || expired || searchPath(ws, graph, query->start, query->end, query->mode,
+                                             query->algorithm, NULL, &result) != 0) {
+                memset(&result, 0, sizeof(PathResult));
+            }
+            double elapsed = getTimeSeconds() - begin;
+            if (chunk[i].callback) {
+                chunk[i].callback(chunk[i].index, query, &result, elapsed, chunk[i].userData);
+            }
+        }
+        
+        pthread_mutex_lock(&engine->lock);
+        engine->completed += count;
+        if (engine->completed == engine->submitted) {
+            pthread_cond_broadcast(&engine->allDone);
+        }
+        pthread_mutex_unlock(&engine->lock);
+    }
+    
+    destroySearchWorkspace(ws);
+    return NULL;
+}
+
+// 创建查询引擎并启动工作线程
+QueryEngine* createQueryEngine(Graph* graph, int threadCount) {
+    if (!graph) return NULL;
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return NULL;
+    
+    QueryEngine* engine = (QueryEngine*)safeMalloc(sizeof(QueryEngine));
+    if (!engine) return NULL;
+    
+    if (threadCount <= 0) threadCount = getProcessorCount();
+    
+    engine->graph = graph;
+    engine->threadCount = 0;
+    engine->threads = (pthread_t*)safeMalloc((size_t)threadCount * sizeof(pthread_t));
+    engine->tasks = (QueryTask*)safeMalloc(ENGINE_INITIAL_QUEUE * sizeof(QueryTask));
+    engine->head = 0;
+    engine->tail = 0;
+    engine->capacity = ENGINE_INITIAL_QUEUE;
+    engine->submitted = 0;
+    engine->completed = 0;
+    engine->shuttingDown = 0;
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->workAvailable, NULL);
+    pthread_cond_init(&engine->allDone, NULL);
+    
+    // 工作线程读取threadCount计算块大小，先设为目标值，创建失败时再修正
+    engine->threadCount = threadCount;
+    int started = 0;
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&engine->threads[started], NULL, engineWorker, engine) == 0) {
+            started++;
+        }
+    }
+    
+    pthread_mutex_lock(&engine->lock);
+    engine->threadCount = started;
+    pthread_mutex_unlock(&engine->lock);
+    
+    if (started == 0) {
+        destroyQueryEngine(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+// 销毁查询引擎：处理完已提交的查询后停止工作线程
+void destroyQueryEngine(QueryEngine* engine) {
+    if (!engine) return;
+    
+    pthread_mutex_lock(&engine->lock);
+    engine->shuttingDown = 1;
+    pthread_cond_broadcast(&engine->workAvailable);
+    pthread_mutex_unlock(&engine->lock);
+    
+    for (int i = 0; i < engine->threadCount; i++) {
+        pthread_join(engine->threads[i], NULL);
+    }
+    
+    pthread_mutex_destroy(&engine->lock);
+    pthread_cond_destroy(&engine->workAvailable);
+    pthread_cond_destroy(&engine->allDone);
+    free(engine->threads);
+    free(engine->tasks);
+    free(engine);
+}
+
+// 提交一批查询
+int submitQueryBatch(QueryEngine* engine, const RouteQuery* queries, int count,
+                     QueryCallback callback, void* userData) {
+    if (!engine || count < 0 || (count > 0 && !queries)) return -1;
+    if (count == 0) return 0;
+    
+    pthread_mutex_lock(&engine->lock);
+    
+    // 先把未处理的任务移到队列开头，仍不足时倍增容量
+    if (engine->tail + count > engine->capacity) {
+        int pending = engine->tail - engine->head;
+        memmove(engine->tasks, engine->tasks + engine->head, (size_t)pending * sizeof(QueryTask));
+        engine->head = 0;
+        engine->tail = pending;
+        
+        if (pending + count > engine->capacity) {
+            int capacity = engine->capacity;
+            while (pending + count > capacity) capacity *= 2;
+            engine->tasks = (QueryTask*)safeRealloc(engine->tasks, (size_t)capacity * sizeof(QueryTask));
+            engine->capacity = capacity;
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        QueryTask* task = &engine->tasks[engine->tail++];
+        task->query = queries[i];
+        task->index = i;
+        task->callback = callback;
+        task->userData = userData;
+    }
+    engine->submitted += count;
+    
+    pthread_cond_broadcast(&engine->workAvailable);
+    pthread_mutex_unlock(&engine->lock);
+    return 0;
+}
+
+// 等待所有已提交的查询完成
+void waitQueryEngine(QueryEngine* engine) {
+    if (!engine) return;
+    
+    pthread_mutex_lock(&engine->lock);
+    while (engine->completed < engine->submitted) {
+        pthread_cond_wait(&engine->allDone, &engine->lock);
+    }
+    pthread_mutex_unlock(&engine->lock);
+}
+
+// 提交一批查询并等待完成
+int runQueryBatch(QueryEngine* engine, const RouteQuery* queries, int count,
+                  QueryCallback callback, void* userData) {
+    if (submitQueryBatch(engine, queries, count, callback, userData) != 0) return -1;
+    waitQueryEngine(engine);
+    return 0;
+}
@@ -0,0 +1,400 @@
+#include "../include/generator.h"
+#include "../include/utils.h"
+#include <math.h>
+
+#define GENERATOR_RAMP_LENGTH 50        // 立交匝道的长度（米）
+#define GENERATOR_WRITE_BUFFER (1 << 20)// 文本输出的缓冲区大小
+
+// 各道路等级的行驶速度（km/h），驾车权重按最高速度折算
+static const int roadSpeedKmh[ROAD_CLASS_COUNT] = { 30, 50, 100 };
+
+// 生成结果的去向：内存中的图或文本文件（二者之一）。
+// 节点坐标在生成边时用于计算距离，所以总是保存一份
+typedef struct {
+    Graph* graph;
+    FILE* file;
+    float* latitudes;
+    float* longitudes;
+    int nodeCount;              // 已生成的节点数
+    long long edgeCount;        // 已生成的边数
+    int failed;                 // 写入或插入是否失败过
+} GeneratorSink;
+
+// 随机数发生器（xorshift64，种子经splitmix64打散，避免小种子开头的输出过于相近）
+static unsigned long long seedRandom(unsigned long long seed) {
+    unsigned long long z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+static unsigned long long nextRandom(unsigned long long* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// [0, 1)上的均匀分布
+static double nextUniform(unsigned long long* state) {
+    return (double)(nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void initGeneratorConfig(GeneratorConfig* config, GeneratorType type, int nodeCount, unsigned long long seed) {
+    if (!config) return;
+    
+    config->type = type;
+    config->nodeCount = nodeCount;
+    config->seed = seed;
+    config->spacing = 100.0;
+    config->jitter = type == GENERATOR_GEOMETRIC ? 0.0 : 0.25;
+    config->dropRate = type == GENERATOR_GEOMETRIC ? 0.0 : 0.05;
+    config->degree = 6.0;
+    config->arterialEvery = 8;
+    config->highwayEvery = 32;
+}
+
+int parseGeneratorType(const char* name) {
+    if (!name) return -1;
+    
+    for (int type = GENERATOR_GRID; type <= GENERATOR_HIGHWAY; type++) {
+        if (strcmp(name, getGeneratorTypeName((GeneratorType)type)) == 0) return type;
+    }
+    return -1;
+}
+
+const char* getGeneratorTypeName(GeneratorType type) {
+    switch (type) {
+        case GENERATOR_GRID: return "grid";
+        case GENERATOR_GEOMETRIC: return "geometric";
+        case GENERATOR_HIGHWAY: return "highway";
+        default: return "unknown";
+    }
+}
+
+static int isValidConfig(const GeneratorConfig* config) {
+    return config && config->type >= GENERATOR_GRID && config->type <= GENERATOR_HIGHWAY &&
+           config->nodeCount >= 4 && config->spacing >= 1.0 && config->jitter >= 0.0 && config->jitter <= 0.5 &&
+           config->dropRate >= 0.0 && config->dropRate < 1.0 && config->degree > 0.0 &&
+           config->arterialEvery >= 0 && config->highwayEvery >= 2;
+}
+
+// 网格类的边长（取最接近nodeCount的正方形）
+static int gridSide(const GeneratorConfig* config) {
+    return maxInt(2, (int)(sqrt((double)config->nodeCount) + 0.5));
+}
+
+// 分层路网中每行/列的立交数
+static int interchangeSide(const GeneratorConfig* config) {
+    return (gridSide(config) - 1) / config->highwayEvery + 1;
+}
+
+// 生成的节点总数
+static int totalNodeCount(const GeneratorConfig* config) {
+    if (config->type == GENERATOR_GEOMETRIC) return config->nodeCount;
+    
+    int side = gridSide(config);
+    int interchanges = config->type == GENERATOR_HIGHWAY ? interchangeSide(config) : 0;
+    return side * side + interchanges * interchanges;
+}
+
+// 输出一个节点（编号按调用顺序递增）
+static void emitNodeAt(GeneratorSink* sink, float latitude, float longitude, NodeType type) {
+    int id = sink->nodeCount++;
+    sink->latitudes[id] = latitude;
+    sink->longitudes[id] = longitude;
+    
+    if (sink->graph) {
+        char name[MAX_NAME_LEN];
+        snprintf(name, sizeof(name), "n%d", id);
+        if (addNode(sink->graph, name, latitude, longitude, type) == -1) sink->failed = 1;
+    } else if (fprintf(sink->file, "NODE n%d %.7f %.7f %d\n", id, latitude, longitude, (int)type) < 0) {
+        sink->failed = 1;
+    }
+}
+
+// 按相对原点的平面米数输出节点
+static void emitNode(GeneratorSink* sink, double x, double y, NodeType type) {
+    emitNodeAt(sink, (float)(GENERATOR_ORIGIN_LATITUDE + y / GENERATOR_METERS_PER_LAT),
+               (float)(GENERATOR_ORIGIN_LONGITUDE + x / GENERATOR_METERS_PER_LNG), type);
+}
+
+// 输出u与v之间的一条道路（两个方向的边）。距离按存储后的单精度坐标计算并向上取整，
+// 保证不小于calculateHeuristic给出的直线距离；minLength用于坐标重合的立交匝道
+static void emitRoad(GeneratorSink* sink, int u, int v, RoadClass roadClass, int minLength) {
+    double dy = ((double)sink->latitudes[v] - sink->latitudes[u]) * GENERATOR_METERS_PER_LAT;
+    double dx = ((double)sink->longitudes[v] - sink->longitudes[u]) * GENERATOR_METERS_PER_LNG;
+    int distance = maxInt((int)sqrt(dx * dx + dy * dy) + 1, minLength);
+    
+    int speed = roadSpeedKmh[roadClass];
+    int timeCost = maxInt(1, (int)ceil(distance * 3.6 / speed));
+    int walkWeight = roadClass == ROAD_HIGHWAY ? distance * 10 : distance;
+    int driveWeight = (int)ceil((double)distance * roadSpeedKmh[ROAD_HIGHWAY] / speed);
+    
+    int ends[2][2] = { { u, v }, { v, u } };
+    for (int i = 0; i < 2; i++) {
+        if (sink->graph) {
+            if (addEdge(sink->graph, ends[i][0], ends[i][1], distance, timeCost, walkWeight, driveWeight) == -1) {
+                sink->failed = 1;
+            }
+        } else if (fprintf(sink->file, "EDGE n%d n%d %d %d %d %d\n", ends[i][0], ends[i][1],
+                           distance, timeCost, walkWeight, driveWeight) < 0) {
+            sink->failed = 1;
+        }
+    }
+    sink->edgeCount += 2;
+}
+
+// 扰动网格的节点：编号为 行*边长+列，位置在格点附近随机偏移
+static void emitGridNodes(GeneratorSink* sink, const GeneratorConfig* config, unsigned long long* rng) {
+    int side = gridSide(config);
+    double amplitude = config->jitter * config->spacing;
+    
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            double dx = (nextUniform(rng) * 2.0 - 1.0) * amplitude;
+            double dy = (nextUniform(rng) * 2.0 - 1.0) * amplitude;
+            emitNode(sink, x * config->spacing + dx, y * config->spacing + dy, NODE_NORMAL);
+        }
+    }
+}
+
+// 扰动网格的街道：每个节点连向右侧和上方的邻居，主干道所在的行/列不删除路段
+static void emitGridRoads(GeneratorSink* sink, const GeneratorConfig* config, unsigned long long* rng) {
+    int side = gridSide(config);
+    int every = config->arterialEvery;
+    
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            int u = y * side + x;
+            // 每个候选路段都消耗一个随机数，生成结果与输出方式无关
+            if (x + 1 < side) {
+                int arterial = every > 0 && y % every == 0;
+                if (nextUniform(rng) >= config->dropRate || arterial) {
+                    emitRoad(sink, u, u + 1, arterial ? ROAD_ARTERIAL : ROAD_STREET, 1);
+                }
+            }
+            if (y + 1 < side) {
+                int arterial = every > 0 && x % every == 0;
+                if (nextUniform(rng) >= config->dropRate || arterial) {
+                    emitRoad(sink, u, u + side, arterial ? ROAD_ARTERIAL : ROAD_STREET, 1);
+                }
+            }
+        }
+    }
+}
+
+// 分层路网：在每隔highwayEvery行/列的格点上放置立交节点（交通枢纽），
+// 立交之间以高速相连，每个立交经匝道连到同一位置的街道节点
+static void emitHighwayNodes(GeneratorSink* sink, const GeneratorConfig* config) {
+    int side = gridSide(config);
+    int count = interchangeSide(config);
+    
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < count; j++) {
+            int street = i * config->highwayEvery * side + j * config->highwayEvery;
+            emitNodeAt(sink, sink->latitudes[street], sink->longitudes[street], NODE_TRANSPORT_HUB);
+        }
+    }
+}
+
+static void emitHighwayRoads(GeneratorSink* sink, const GeneratorConfig* config) {
+    int side = gridSide(config);
+    int count = interchangeSide(config);
+    int first = side * side;
+    
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < count; j++) {
+            int id = first + i * count + j;
+            int street = i * config->highwayEvery * side + j * config->highwayEvery;
+            emitRoad(sink, id, street, ROAD_ARTERIAL, GENERATOR_RAMP_LENGTH);
+            if (j + 1 < count) emitRoad(sink, id, id + 1, ROAD_HIGHWAY, 1);
+            if (i + 1 < count) emitRoad(sink, id, id + count, ROAD_HIGHWAY, 1);
+        }
+    }
+}
+
+// 随机几何图的空间划分：节点按所在单元格排序后编号，单元格边长不小于连接半径
+typedef struct {
+    int cellsPerSide;
+    double cellSize;
+    double radius;
+    double* x;                  // 按编号排列的坐标（米）
+    double* y;
+    int* cellStart;             // 单元格c中的节点编号为 [cellStart[c], cellStart[c+1])
+} GeometricLayout;
+
+static void buildGeometricLayout(GeometricLayout* layout, const GeneratorConfig* config, unsigned long long* rng) {
+    int n = config->nodeCount;
+    double extent = config->spacing * sqrt((double)n);
+    layout->radius = config->spacing * sqrt(config->degree / 3.14159265358979323846);
+    layout->cellsPerSide = maxInt(1, (int)(extent / layout->radius));
+    layout->cellSize = extent / layout->cellsPerSide;
+    
+    int cells = layout->cellsPerSide * layout->cellsPerSide;
+    double* rawX = (double*)safeMalloc((size_t)n * sizeof(double));
+    double* rawY = (double*)safeMalloc((size_t)n * sizeof(double));
+    int* cellOf = (int*)safeMalloc((size_t)n * sizeof(int));
+    layout->cellStart = (int*)calloc((size_t)cells + 1, sizeof(int));
+    if (!layout->cellStart) {
+        fprintf(stderr, "内存分配失败！\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    for (int i = 0; i < n; i++) {
+        rawX[i] = nextUniform(rng) * extent;
+        rawY[i] = nextUniform(rng) * extent;
+        int cx = minInt((int)(rawX[i] / layout->cellSize), layout->cellsPerSide - 1);
+        int cy = minInt((int)(rawY[i] / layout->cellSize), layout->cellsPerSide - 1);
+        cellOf[i] = cy * layout->cellsPerSide + cx;
+        layout->cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < cells; c++) {
+        layout->cellStart[c + 1] += layout->cellStart[c];
+    }
+    
+    // 计数排序：同一单元格的节点编号相邻，邻接访问保持局部性
+    int* next = (int*)safeMalloc((size_t)cells * sizeof(int));
+    memcpy(next, layout->cellStart, (size_t)cells * sizeof(int));
+    layout->x = (double*)safeMalloc((size_t)n * sizeof(double));
+    layout->y = (double*)safeMalloc((size_t)n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        int id = next[cellOf[i]]++;
+        layout->x[id] = rawX[i];
+        layout->y[id] = rawY[i];
+    }
+    
+    free(next);
+    free(cellOf);
+    free(rawX);
+    free(rawY);
+}
+
+static void freeGeometricLayout(GeometricLayout* layout) {
+    free(layout->x);
+    free(layout->y);
+    free(layout->cellStart);
+}
+
+// 连接距离不超过半径的节点对（每对只处理一次）。sink为NULL时只计数，返回生成的边数
+static long long connectGeometric(const GeometricLayout* layout, GeneratorSink* sink) {
+    int cellsPerSide = layout->cellsPerSide;
+    double radiusSquared = layout->radius * layout->radius;
+    long long edges = 0;
+    
+    for (int cy = 0; cy < cellsPerSide; cy++) {
+        for (int cx = 0; cx < cellsPerSide; cx++) {
+            int cell = cy * cellsPerSide + cx;
+            for (int u = layout->cellStart[cell]; u < layout->cellStart[cell + 1]; u++) {
+                for (int ny = maxInt(cy - 1, 0); ny <= minInt(cy + 1, cellsPerSide - 1); ny++) {
+                    for (int nx = maxInt(cx - 1, 0); nx <= minInt(cx + 1, cellsPerSide - 1); nx++) {
+                        int other = ny * cellsPerSide + nx;
+                        for (int v = maxInt(layout->cellStart[other], u + 1); v < layout->cellStart[other + 1]; v++) {
+                            double dx = layout->x[v] - layout->x[u];
+                            double dy = layout->y[v] - layout->y[u];
+                            if (dx * dx + dy * dy > radiusSquared) continue;
+                            
+                            if (sink) emitRoad(sink, u, v, ROAD_STREET, 1);
+                            edges += 2;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+// 生成全部节点和边。生成内存中的图时先按规模预留数组
+static void runGenerator(const GeneratorConfig* config, GeneratorSink* sink) {
+    unsigned long long rng = seedRandom(config->seed);
+    
+    if (config->type == GENERATOR_GEOMETRIC) {
+        GeometricLayout layout;
+        buildGeometricLayout(&layout, config, &rng);
+        if (sink->graph) {
+            long long edges = connectGeometric(&layout, NULL);
+            if (edges > INT_MAX || reserveGraph(sink->graph, config->nodeCount, (int)edges) != 0) sink->failed = 1;
+        }
+        if (!sink->failed) {
+            for (int i = 0; i < config->nodeCount; i++) {
+                emitNode(sink, layout.x[i], layout.y[i], NODE_NORMAL);
+            }
+            connectGeometric(&layout, sink);
+        }
+        freeGeometricLayout(&layout);
+        return;
+    }
+    
+    if (sink->graph) {
+        // 上界：每个格点两条道路，每个立交一条匝道和两条高速
+        long long side = gridSide(config);
+        long long interchanges = config->type == GENERATOR_HIGHWAY ? interchangeSide(config) : 0;
+        long long edges = 4 * side * side + 6 * interchanges * interchanges;
+        if (edges > INT_MAX || reserveGraph(sink->graph, totalNodeCount(config), (int)edges) != 0) {
+            sink->failed = 1;
+            return;
+        }
+    }
+    emitGridNodes(sink, config, &rng);
+    if (config->type == GENERATOR_HIGHWAY) emitHighwayNodes(sink, config);
+    emitGridRoads(sink, config, &rng);
+    if (config->type == GENERATOR_HIGHWAY) emitHighwayRoads(sink, config);
+}
+
+static int initSink(GeneratorSink* sink, const GeneratorConfig* config) {
+    memset(sink, 0, sizeof(GeneratorSink));
+    if (!isValidConfig(config)) return -1;
+    
+    long long nodes = totalNodeCount(config);
+    if (nodes > INT_MAX / 2) return -1;
+    sink->latitudes = (float*)safeMalloc((size_t)nodes * sizeof(float));
+    sink->longitudes = (float*)safeMalloc((size_t)nodes * sizeof(float));
+    return 0;
+}
+
+static void freeSink(GeneratorSink* sink) {
+    free(sink->latitudes);
+    free(sink->longitudes);
+}
+
+Graph* generateGraph(const GeneratorConfig* config) {
+    GeneratorSink sink;
+    if (initSink(&sink, config) != 0) return NULL;
+    
+    sink.graph = createGraph();
+    runGenerator(config, &sink);
+    freeSink(&sink);
+    
+    if (sink.failed || freezeGraph(sink.graph) != 0) {
+        destroyGraph(sink.graph);
+        return NULL;
+    }
+    return sink.graph;
+}
+
+int writeGeneratedGraph(const GeneratorConfig* config, const char* path, long long* edgeCount) {
+    GeneratorSink sink;
+    if (!path || initSink(&sink, config) != 0) return -1;
+    
+    sink.file = fopen(path, "w");
+    if (!sink.file) {
+        freeSink(&sink);
+        return -1;
+    }
+    setvbuf(sink.file, NULL, _IOFBF, GENERATOR_WRITE_BUFFER);
+    
+    fprintf(sink.file, "# 合成图：type=%s nodes=%d seed=%llu spacing=%.1f\n",
+            getGeneratorTypeName(config->type), totalNodeCount(config), config->seed, config->spacing);
+    fprintf(sink.file, "# NODE <name> <latitude> <longitude> <type>\n");
+    fprintf(sink.file, "# EDGE <from_name> <to_name> <distance> <time_cost> <walk_weight> <drive_weight>\n");
+    runGenerator(config, &sink);
+    
+    if (fclose(sink.file) != 0) sink.failed = 1;
+    freeSink(&sink);
+    if (sink.failed) return -1;
+    
+    if (edgeCount) *edgeCount = sink.edgeCount;
+    return 0;
+}
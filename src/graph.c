@@ -1,73 +1,494 @@
 #include "../include/graph.h"
 #include "../include/utils.h"
+#include <math.h>
 
 // 创建图
 Graph* createGraph() {
+    return createGraphWithCapacity(DEFAULT_NODE_CAPACITY, DEFAULT_EDGE_CAPACITY);
+}
+
+// 按预估规模创建图（容量不足时会自动扩展）
+Graph* createGraphWithCapacity(int nodeCapacity, int edgeCapacity) {
     Graph* graph = (Graph*)safeMalloc(sizeof(Graph));
     if (!graph) return NULL;
     
     graph->nodeCount = 0;
     graph->edgeCount = 0;
+    graph->nodeCapacity = 0;
+    graph->edgeCapacity = 0;
+    graph->nodes = NULL;
+    graph->edges = NULL;
+    graph->adjHead = NULL;
+    graph->adjNext = NULL;
+    graph->nameIndex = NULL;
+    graph->nameIndexCapacity = 0;
+    graph->edgeIndex = NULL;
+    graph->edgeIndexCapacity = 0;
+    graph->isFrozen = 0;
+    graph->csrOffsets = NULL;
+    graph->csrTargets = NULL;
+    graph->csrEdgeIds = NULL;
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->csrWeights[m] = NULL;
+    }
+    graph->edgeSlot = NULL;
+    graph->rcsrOffsets = NULL;
+    graph->rcsrSources = NULL;
+    graph->rcsrEdgeIds = NULL;
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->rcsrWeights[m] = NULL;
+    }
+    graph->edgeReverseSlot = NULL;
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->weightPerMeter[m] = -1.0;
+    }
+    graph->isReadOnly = 0;
+    graph->version = 0;
+    graph->listeners = NULL;
+    graph->listenerCount = 0;
+    graph->listenerCapacity = 0;
     
-    // 初始化邻接表
-    for (int i = 0; i < MAX_NODES; i++) {
-        graph->adjList[i] = NULL;
+    if (reserveGraph(graph, maxInt(nodeCapacity, 1), maxInt(edgeCapacity, 1)) != 0) {
+        destroyGraph(graph);
+        return NULL;
     }
     
     return graph;
 }
 
+// 将节点插入名称索引（调用方保证容量充足且名称不重复）
+static void nameIndexInsert(Graph* graph, int nodeId, unsigned int hash) {
+    unsigned int mask = (unsigned int)graph->nameIndexCapacity - 1;
+    unsigned int slot = hash & mask;
+    
+    while (graph->nameIndex[slot].nodeId != -1) {
+        slot = (slot + 1) & mask;
+    }
+    graph->nameIndex[slot].hash = hash;
+    graph->nameIndex[slot].nodeId = nodeId;
+}
+
+// 按节点容量调整名称索引大小（保持负载不超过1/2），并重新插入现有节点
+static int resizeNameIndex(Graph* graph, int nodeCapacity) {
+    int capacity = 16;
+    while (capacity < nodeCapacity * 2 && capacity <= INT_MAX / 4) {
+        capacity *= 2;
+    }
+    if (capacity <= graph->nameIndexCapacity) return 0;
+    
+    NameIndexSlot* old = graph->nameIndex;
+    int oldCapacity = graph->nameIndexCapacity;
+    
+    graph->nameIndex = (NameIndexSlot*)safeMalloc((size_t)capacity * sizeof(NameIndexSlot));
+    graph->nameIndexCapacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        graph->nameIndex[i].nodeId = -1;
+    }
+    
+    for (int i = 0; i < oldCapacity; i++) {
+        if (old[i].nodeId != -1) {
+            nameIndexInsert(graph, old[i].nodeId, old[i].hash);
+        }
+    }
+    free(old);
+    return 0;
+}
+
+// 查找名称所在的索引槽位（未找到返回-1）
+static int nameIndexFind(Graph* graph, const char* name, unsigned int hash) {
+    if (graph->nameIndexCapacity == 0) return -1;
+    
+    unsigned int mask = (unsigned int)graph->nameIndexCapacity - 1;
+    unsigned int slot = hash & mask;
+    
+    while (graph->nameIndex[slot].nodeId != -1) {
+        NameIndexSlot* entry = &graph->nameIndex[slot];
+        if (entry->hash == hash &&
+            stringCompareIgnoreCase(graph->nodes[entry->nodeId].name, name) == 0) {
+            return (int)slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// 删除名称索引槽位（线性探测的后移删除，不留墓碑）
+static void nameIndexErase(Graph* graph, int slot) {
+    unsigned int mask = (unsigned int)graph->nameIndexCapacity - 1;
+    unsigned int hole = (unsigned int)slot;
+    unsigned int next = (hole + 1) & mask;
+    
+    while (graph->nameIndex[next].nodeId != -1) {
+        unsigned int home = graph->nameIndex[next].hash & mask;
+        // 若next的理想位置不在(hole, next]区间内，则可前移填补空洞
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            graph->nameIndex[hole] = graph->nameIndex[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    graph->nameIndex[hole].nodeId = -1;
+}
+
+// 节点对的哈希值
+static unsigned int hashNodePair(int from, int to) {
+    unsigned int h = (unsigned int)from * 0x9E3779B1u ^ ((unsigned int)to + 0x7F4A7C15u) * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    return h;
+}
+
+// 查找节点对所在的边索引槽位；未找到时返回可插入的空槽位
+static unsigned int edgeIndexProbe(const Graph* graph, int from, int to) {
+    unsigned int mask = (unsigned int)graph->edgeIndexCapacity - 1;
+    unsigned int slot = hashNodePair(from, to) & mask;
+    
+    while (graph->edgeIndex[slot].edgeId != -1 &&
+           (graph->edgeIndex[slot].from != from || graph->edgeIndex[slot].to != to)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// 将边加入边索引（节点对已存在时保留编号更小的边）
+static void edgeIndexInsert(Graph* graph, int from, int to, int edgeId) {
+    EdgeIndexSlot* entry = &graph->edgeIndex[edgeIndexProbe(graph, from, to)];
+    if (entry->edgeId != -1) return;
+    
+    entry->from = from;
+    entry->to = to;
+    entry->edgeId = edgeId;
+}
+
+// 按边容量调整边索引大小（保持负载不超过1/2），并重新插入现有条目
+static int resizeEdgeIndex(Graph* graph, int edgeCapacity) {
+    int capacity = 16;
+    while (capacity < edgeCapacity * 2 && capacity <= INT_MAX / 4) {
+        capacity *= 2;
+    }
+    if (capacity <= graph->edgeIndexCapacity) return 0;
+    
+    EdgeIndexSlot* old = graph->edgeIndex;
+    int oldCapacity = graph->edgeIndexCapacity;
+    
+    graph->edgeIndex = (EdgeIndexSlot*)safeMalloc((size_t)capacity * sizeof(EdgeIndexSlot));
+    graph->edgeIndexCapacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        graph->edgeIndex[i].edgeId = -1;
+    }
+    
+    for (int i = 0; i < oldCapacity; i++) {
+        if (old[i].edgeId != -1) {
+            edgeIndexInsert(graph, old[i].from, old[i].to, old[i].edgeId);
+        }
+    }
+    free(old);
+    return 0;
+}
+
+// 预留容量，保证至少能容纳指定数量的节点和边
+int reserveGraph(Graph* graph, int nodeCapacity, int edgeCapacity) {
+    if (!graph || graph->isReadOnly || nodeCapacity < 0 || edgeCapacity < 0) return -1;
+    
+    if (nodeCapacity > graph->nodeCapacity) {
+        graph->nodes = (Node*)safeRealloc(graph->nodes, (size_t)nodeCapacity * sizeof(Node));
+        graph->adjHead = (int*)safeRealloc(graph->adjHead, (size_t)nodeCapacity * sizeof(int));
+        graph->nodeCapacity = nodeCapacity;
+        if (resizeNameIndex(graph, nodeCapacity) != 0) return -1;
+    }
+    
+    if (edgeCapacity > graph->edgeCapacity) {
+        graph->edges = (Edge*)safeRealloc(graph->edges, (size_t)edgeCapacity * sizeof(Edge));
+        graph->adjNext = (int*)safeRealloc(graph->adjNext, (size_t)edgeCapacity * sizeof(int));
+        graph->edgeCapacity = edgeCapacity;
+        if (resizeEdgeIndex(graph, edgeCapacity) != 0) return -1;
+    }
+    
+    return 0;
+}
+
+// 容量不足时按倍增策略扩展，保证添加操作均摊O(1)
+static int growCapacity(int current, int needed) {
+    if (needed > INT_MAX / 2) return INT_MAX;
+    int capacity = maxInt(current, 1);
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// 释放CSR结构
+static void freeFrozenAdjacency(Graph* graph) {
+    free(graph->csrOffsets);
+    free(graph->csrTargets);
+    free(graph->csrEdgeIds);
+    free(graph->rcsrOffsets);
+    free(graph->rcsrSources);
+    free(graph->rcsrEdgeIds);
+    for (int m = 0; m < MODE_COUNT; m++) {
+        free(graph->csrWeights[m]);
+        free(graph->rcsrWeights[m]);
+        graph->csrWeights[m] = NULL;
+        graph->rcsrWeights[m] = NULL;
+    }
+    free(graph->edgeSlot);
+    free(graph->edgeReverseSlot);
+    
+    graph->csrOffsets = NULL;
+    graph->csrTargets = NULL;
+    graph->csrEdgeIds = NULL;
+    graph->rcsrOffsets = NULL;
+    graph->rcsrSources = NULL;
+    graph->rcsrEdgeIds = NULL;
+    graph->edgeSlot = NULL;
+    graph->edgeReverseSlot = NULL;
+    graph->isFrozen = 0;
+}
+
 // 销毁图
 void destroyGraph(Graph* graph) {
     if (!graph) return;
     
-    // 释放邻接表内存
-    for (int i = 0; i < graph->nodeCount; i++) {
-        AdjListNode* current = graph->adjList[i];
-        while (current) {
-            AdjListNode* temp = current;
-            current = current->next;
-            free(temp);
-        }
+    // 只读图的数组由其所有者（如快照）释放
+    if (graph->isReadOnly) {
+        free(graph->listeners);
+        free(graph);
+        return;
     }
     
+    freeFrozenAdjacency(graph);
+    free(graph->nameIndex);
+    free(graph->edgeIndex);
+    free(graph->nodes);
+    free(graph->edges);
+    free(graph->adjHead);
+    free(graph->adjNext);
+    free(graph->listeners);
     free(graph);
 }
 
+// 注册变化监听者，返回0表示成功
+int addGraphListener(Graph* graph, GraphChangeListener callback, void* userData) {
+    if (!graph || !callback) return -1;
+    
+    if (graph->listenerCount >= graph->listenerCapacity) {
+        int capacity = growCapacity(graph->listenerCapacity, graph->listenerCount + 1);
+        graph->listeners = (GraphListener*)safeRealloc(graph->listeners, (size_t)capacity * sizeof(GraphListener));
+        graph->listenerCapacity = capacity;
+    }
+    
+    graph->listeners[graph->listenerCount].callback = callback;
+    graph->listeners[graph->listenerCount].userData = userData;
+    graph->listenerCount++;
+    return 0;
+}
+
+// 注销变化监听者
+void removeGraphListener(Graph* graph, GraphChangeListener callback, void* userData) {
+    if (!graph) return;
+    
+    for (int i = 0; i < graph->listenerCount; i++) {
+        if (graph->listeners[i].callback == callback && graph->listeners[i].userData == userData) {
+            graph->listeners[i] = graph->listeners[--graph->listenerCount];
+            return;
+        }
+    }
+}
+
+// 递增图版本并通知所有监听者（每个修改函数在实际改变图之后调用）
+static void notifyGraphChange(Graph* graph, GraphChangeType type, int nodeId, int edgeId,
+                              TransportMode mode, int oldValue, int newValue) {
+    graph->version++;
+    if (graph->listenerCount == 0) return;
+    
+    GraphChange change;
+    change.type = type;
+    change.nodeId = nodeId;
+    change.edgeId = edgeId;
+    change.mode = mode;
+    change.oldValue = oldValue;
+    change.newValue = newValue;
+    for (int i = 0; i < graph->listenerCount; i++) {
+        graph->listeners[i].callback(graph, &change, graph->listeners[i].userData);
+    }
+}
+
+// 将边的当前权重和通行状态同步到正向和反向CSR槽位
+static void syncFrozenEdge(Graph* graph, int edgeId) {
+    if (!graph->isFrozen || graph->edgeSlot[edgeId] == -1) return;
+    
+    int slot = graph->edgeSlot[edgeId];
+    int reverseSlot = graph->edgeReverseSlot[edgeId];
+    Edge* edge = &graph->edges[edgeId];
+    for (int m = 0; m < MODE_COUNT; m++) {
+        int weight = edge->isAccessible ? edge->modeWeight[m] : INF;
+        graph->csrWeights[m][slot] = weight;
+        graph->rcsrWeights[m][reverseSlot] = weight;
+    }
+}
+
+// 节点间的直线距离（米），投影与calculateHeuristic相同，但不截断为整数，保证三角不等式
+double straightLineDistance(const Graph* graph, int from, int to) {
+    double latDistance = ((double)graph->nodes[from].latitude - graph->nodes[to].latitude) * 111000.0;
+    double lngDistance = ((double)graph->nodes[from].longitude - graph->nodes[to].longitude) * 85000.0;
+    return sqrt(latDistance * latDistance + lngDistance * lngDistance);
+}
+
+// 用一条边的权重降低各交通方式的weightPerMeter。比值略微缩小，
+// 留出直线距离的浮点误差，使取整后的下界仍满足一致性
+static void lowerWeightPerMeter(Graph* graph, int edgeId) {
+    const Edge* edge = &graph->edges[edgeId];
+    double length = straightLineDistance(graph, edge->from, edge->to);
+    if (length <= 0.0) return;
+    
+    for (int m = 0; m < MODE_COUNT; m++) {
+        double ratio = maxInt(edge->modeWeight[m], 0) / length * (1.0 - 1e-9);
+        if (graph->weightPerMeter[m] < 0.0 || ratio < graph->weightPerMeter[m]) graph->weightPerMeter[m] = ratio;
+    }
+}
+
+// 按所有边重新计算weightPerMeter，去掉增量维护中已删除的边或旧权重留下的松弛
+void computeWeightPerMeter(Graph* graph) {
+    if (!graph) return;
+    
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->weightPerMeter[m] = -1.0;
+    }
+    for (int e = 0; e < graph->edgeCount; e++) {
+        lowerWeightPerMeter(graph, e);
+    }
+}
+
+// 冻结图：按邻接表顺序生成连续的正向CSR数组，并按终点计数排序生成反向CSR
+int freezeGraph(Graph* graph) {
+    if (!graph) return -1;
+    if (graph->isReadOnly) return graph->isFrozen ? 0 : -1;
+    
+    freeFrozenAdjacency(graph);
+    
+    int n = graph->nodeCount;
+    size_t edgeBytes = (size_t)maxInt(graph->edgeCount, 1) * sizeof(int);
+    
+    graph->csrOffsets = (int*)safeMalloc((size_t)(n + 1) * sizeof(int));
+    graph->csrTargets = (int*)safeMalloc(edgeBytes);
+    graph->csrEdgeIds = (int*)safeMalloc(edgeBytes);
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->csrWeights[m] = (int*)safeMalloc(edgeBytes);
+    }
+    graph->edgeSlot = (int*)safeMalloc(edgeBytes);
+    
+    graph->rcsrOffsets = (int*)safeMalloc((size_t)(n + 1) * sizeof(int));
+    graph->rcsrSources = (int*)safeMalloc(edgeBytes);
+    graph->rcsrEdgeIds = (int*)safeMalloc(edgeBytes);
+    for (int m = 0; m < MODE_COUNT; m++) {
+        graph->rcsrWeights[m] = (int*)safeMalloc(edgeBytes);
+    }
+    graph->edgeReverseSlot = (int*)safeMalloc(edgeBytes);
+    
+    for (int i = 0; i < graph->edgeCount; i++) {
+        graph->edgeSlot[i] = -1;
+        graph->edgeReverseSlot[i] = -1;
+    }
+    
+    int slot = 0;
+    for (int u = 0; u < n; u++) {
+        graph->csrOffsets[u] = slot;
+        for (int e = graph->adjHead[u]; e != -1; e = graph->adjNext[e]) {
+            graph->csrTargets[slot] = graph->edges[e].to;
+            graph->csrEdgeIds[slot] = e;
+            graph->edgeSlot[e] = slot;
+            slot++;
+        }
+    }
+    graph->csrOffsets[n] = slot;
+    
+    // 反向CSR：先统计每个节点的入度，再按正向槽位顺序分配
+    for (int v = 0; v <= n; v++) {
+        graph->rcsrOffsets[v] = 0;
+    }
+    for (int i = 0; i < slot; i++) {
+        graph->rcsrOffsets[graph->csrTargets[i] + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        graph->rcsrOffsets[v + 1] += graph->rcsrOffsets[v];
+    }
+    for (int u = 0; u < n; u++) {
+        for (int i = graph->csrOffsets[u]; i < graph->csrOffsets[u + 1]; i++) {
+            int v = graph->csrTargets[i];
+            int reverseSlot = graph->rcsrOffsets[v]++;
+            graph->rcsrSources[reverseSlot] = u;
+            graph->rcsrEdgeIds[reverseSlot] = graph->csrEdgeIds[i];
+            graph->edgeReverseSlot[graph->csrEdgeIds[i]] = reverseSlot;
+        }
+    }
+    // 分配过程中偏移量前移了一个节点，这里还原
+    for (int v = n; v > 0; v--) {
+        graph->rcsrOffsets[v] = graph->rcsrOffsets[v - 1];
+    }
+    graph->rcsrOffsets[0] = 0;
+    
+    graph->isFrozen = 1;
+    for (int i = 0; i < graph->edgeCount; i++) {
+        syncFrozenEdge(graph, i);
+    }
+    computeWeightPerMeter(graph);
+    
+    return 0;
+}
+
 // 添加节点
 int addNode(Graph* graph, const char* name, float lat, float lng, NodeType type) {
-    if (!graph || !isValidString(name) || graph->nodeCount >= MAX_NODES) {
+    if (!graph || graph->isReadOnly || !isValidString(name) || graph->nodeCount == INT_MAX) {
         return -1;
     }
     
-    // 检查是否已存在同名节点
-    if (findNodeByName(graph, name) != -1) {
+    // 按截断后的存储名称检查是否已存在同名节点
+    char key[MAX_NAME_LEN];
+    strncpy(key, name, MAX_NAME_LEN - 1);
+    key[MAX_NAME_LEN - 1] = '\0';
+    
+    unsigned int hash = hashStringIgnoreCase(key);
+    if (nameIndexFind(graph, key, hash) != -1) {
         return -1;  // 已存在
     }
     
+    if (graph->nodeCount >= graph->nodeCapacity) {
+        int capacity = growCapacity(graph->nodeCapacity, graph->nodeCount + 1);
+        if (reserveGraph(graph, capacity, graph->edgeCapacity) != 0) return -1;
+    }
+    
     int nodeId = graph->nodeCount;
     Node* node = &graph->nodes[nodeId];
     
     node->id = nodeId;
-    strncpy(node->name, name, MAX_NAME_LEN - 1);
-    node->name[MAX_NAME_LEN - 1] = '\0';
+    memcpy(node->name, key, MAX_NAME_LEN);
     node->latitude = lat;
     node->longitude = lng;
     node->type = type;
     node->isActive = 1;  // 默认激活
+    graph->adjHead[nodeId] = -1;
+    nameIndexInsert(graph, nodeId, hash);
     
     graph->nodeCount++;
+    graph->isFrozen = 0;  // 拓扑变化，CSR失效
+    notifyGraphChange(graph, GRAPH_CHANGE_NODE_ADDED, nodeId, -1, MODE_WALKING, 0, 1);
     return nodeId;
 }
 
 // 添加边
 int addEdge(Graph* graph, int from, int to, int distance, int timeCost, 
             int walkWeight, int driveWeight) {
-    if (!graph || !isValidNodeId(from, graph->nodeCount) || 
-        !isValidNodeId(to, graph->nodeCount) || graph->edgeCount >= MAX_EDGES) {
+    if (!graph || graph->isReadOnly || !isValidNodeId(from, graph->nodeCount) || 
+        !isValidNodeId(to, graph->nodeCount) || graph->edgeCount == INT_MAX) {
         return -1;
     }
     
+    if (graph->edgeCount >= graph->edgeCapacity) {
+        int capacity = growCapacity(graph->edgeCapacity, graph->edgeCount + 1);
+        if (reserveGraph(graph, graph->nodeCapacity, capacity) != 0) return -1;
+    }
+    
     int edgeId = graph->edgeCount;
     Edge* edge = &graph->edges[edgeId];
     
@@ -79,96 +500,134 @@ int addEdge(Graph* graph, int from, int to, int distance, int timeCost,
     edge->modeWeight[MODE_WALKING] = walkWeight;
     edge->modeWeight[MODE_DRIVING] = driveWeight;
     
-    // 添加到邻接表
-    AdjListNode* newNode = (AdjListNode*)safeMalloc(sizeof(AdjListNode));
-    if (!newNode) return -1;
-    
-    newNode->dest = to;
-    newNode->edgeIndex = edgeId;
-    newNode->next = graph->adjList[from];
-    graph->adjList[from] = newNode;
+    // 添加到邻接表（头插）
+    graph->adjNext[edgeId] = graph->adjHead[from];
+    graph->adjHead[from] = edgeId;
+    edgeIndexInsert(graph, from, to, edgeId);
+    lowerWeightPerMeter(graph, edgeId);
     
     graph->edgeCount++;
+    graph->isFrozen = 0;  // 拓扑变化，CSR失效
+    notifyGraphChange(graph, GRAPH_CHANGE_EDGE_ADDED, -1, edgeId, MODE_WALKING, 0, 1);
     return edgeId;
 }
 
-// 根据名称查找节点
+// 根据名称查找节点（大小写不敏感，经名称索引O(1)查找）
 int findNodeByName(Graph* graph, const char* name) {
     if (!graph || !isValidString(name)) return -1;
     
-    for (int i = 0; i < graph->nodeCount; i++) {
-        if (stringCompareIgnoreCase(graph->nodes[i].name, name) == 0) {
-            return i;
-        }
-    }
-    return -1;
+    int slot = nameIndexFind(graph, name, hashStringIgnoreCase(name));
+    return slot == -1 ? -1 : graph->nameIndex[slot].nodeId;
+}
+
+// 查找从from到to的边（存在平行边时返回编号最小者），未找到返回-1
+int findEdge(Graph* graph, int from, int to) {
+    if (!graph || !isValidNodeId(from, graph->nodeCount) || 
+        !isValidNodeId(to, graph->nodeCount)) return -1;
+    
+    return graph->edgeIndex[edgeIndexProbe(graph, from, to)].edgeId;
 }
 
 // 更新边权重
 void updateEdgeWeight(Graph* graph, int from, int to, TransportMode mode, int newWeight) {
-    if (!graph || !isValidNodeId(from, graph->nodeCount) || 
-        !isValidNodeId(to, graph->nodeCount)) return;
+    int edgeId = findEdge(graph, from, to);
+    if (edgeId == -1 || graph->isReadOnly || mode < 0 || mode >= MODE_COUNT) return;
     
-    for (int i = 0; i < graph->edgeCount; i++) {
-        if (graph->edges[i].from == from && graph->edges[i].to == to) {
-            graph->edges[i].modeWeight[mode] = newWeight;
-            break;
-        }
-    }
+    int oldWeight = graph->edges[edgeId].modeWeight[mode];
+    if (oldWeight == newWeight) return;
+    
+    graph->edges[edgeId].modeWeight[mode] = newWeight;
+    syncFrozenEdge(graph, edgeId);
+    lowerWeightPerMeter(graph, edgeId);
+    notifyGraphChange(graph, GRAPH_CHANGE_EDGE_WEIGHT, -1, edgeId, mode, oldWeight, newWeight);
 }
 
-// 设置节点可访问性
-void setNodeAccessible(Graph* graph, int nodeId, int accessible) {
-    if (!graph || !isValidNodeId(nodeId, graph->nodeCount)) return;
-    graph->nodes[nodeId].isActive = accessible;
+// 设置节点可访问性。被removeNode移除的节点恢复时把名称重新放回索引；
+// 名称已被另一个节点占用时拒绝恢复并返回-1
+int setNodeAccessible(Graph* graph, int nodeId, int accessible) {
+    if (!graph || graph->isReadOnly || !isValidNodeId(nodeId, graph->nodeCount)) return -1;
+    
+    Node* node = &graph->nodes[nodeId];
+    int oldState = node->isActive;
+    if (accessible && !oldState) {
+        unsigned int hash = hashStringIgnoreCase(node->name);
+        int slot = nameIndexFind(graph, node->name, hash);
+        if (slot == -1) {
+            nameIndexInsert(graph, nodeId, hash);
+        } else if (graph->nameIndex[slot].nodeId != nodeId) {
+            return -1;
+        }
+    }
+    
+    node->isActive = accessible;
+    if (oldState != accessible) {
+        notifyGraphChange(graph, GRAPH_CHANGE_NODE_ACCESS, nodeId, -1, MODE_WALKING, oldState, accessible);
+    }
+    return 0;
 }
 
 // 设置边可访问性
 void setEdgeAccessible(Graph* graph, int from, int to, int accessible) {
-    if (!graph || !isValidNodeId(from, graph->nodeCount) || 
-        !isValidNodeId(to, graph->nodeCount)) return;
+    int edgeId = findEdge(graph, from, to);
+    if (edgeId == -1 || graph->isReadOnly) return;
     
-    for (int i = 0; i < graph->edgeCount; i++) {
-        if (graph->edges[i].from == from && graph->edges[i].to == to) {
-            graph->edges[i].isAccessible = accessible;
-            break;
-        }
+    int oldState = graph->edges[edgeId].isAccessible;
+    graph->edges[edgeId].isAccessible = accessible;
+    syncFrozenEdge(graph, edgeId);
+    if (oldState != accessible) {
+        notifyGraphChange(graph, GRAPH_CHANGE_EDGE_ACCESS, -1, edgeId, MODE_WALKING, oldState, accessible);
     }
 }
 
 // 移除节点（简化实现，实际应该重新组织数据结构）
 int removeNode(Graph* graph, int nodeId) {
-    if (!graph || !isValidNodeId(nodeId, graph->nodeCount)) return -1;
+    if (!graph || graph->isReadOnly || !isValidNodeId(nodeId, graph->nodeCount)) return -1;
+    
+    // 从名称索引中移除，之后可按同名重新添加节点
+    Node* node = &graph->nodes[nodeId];
+    int slot = nameIndexFind(graph, node->name, hashStringIgnoreCase(node->name));
+    if (slot != -1 && graph->nameIndex[slot].nodeId == nodeId) {
+        nameIndexErase(graph, slot);
+    }
     
     // 设置节点为不活跃状态（简化实现）
-    graph->nodes[nodeId].isActive = 0;
+    int oldState = node->isActive;
+    node->isActive = 0;
+    if (oldState) {
+        notifyGraphChange(graph, GRAPH_CHANGE_NODE_ACCESS, nodeId, -1, MODE_WALKING, oldState, 0);
+    }
     return 0;
 }
 
 // 移除边
 int removeEdge(Graph* graph, int from, int to) {
-    if (!graph || !isValidNodeId(from, graph->nodeCount) || 
+    if (!graph || graph->isReadOnly || !isValidNodeId(from, graph->nodeCount) || 
         !isValidNodeId(to, graph->nodeCount)) return -1;
     
     // 从邻接表中移除
-    AdjListNode* current = graph->adjList[from];
-    AdjListNode* prev = NULL;
+    int current = graph->adjHead[from];
+    int prev = -1;
     
-    while (current) {
-        if (current->dest == to) {
-            if (prev) {
-                prev->next = current->next;
+    while (current != -1) {
+        if (graph->edges[current].to == to) {
+            if (prev != -1) {
+                graph->adjNext[prev] = graph->adjNext[current];
             } else {
-                graph->adjList[from] = current->next;
+                graph->adjHead[from] = graph->adjNext[current];
             }
             
             // 设置边为不可访问（简化实现）
-            graph->edges[current->edgeIndex].isAccessible = 0;
-            free(current);
+            int oldState = graph->edges[current].isAccessible;
+            graph->edges[current].isAccessible = 0;
+            graph->adjNext[current] = -1;
+            graph->isFrozen = 0;  // 拓扑变化，CSR失效
+            if (oldState) {
+                notifyGraphChange(graph, GRAPH_CHANGE_EDGE_ACCESS, -1, current, MODE_WALKING, oldState, 0);
+            }
             return 0;
         }
         prev = current;
-        current = current->next;
+        current = graph->adjNext[current];
     }
     
     return -1;
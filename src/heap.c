@@ -0,0 +1,277 @@
+#include "../include/heap.h"
+#include "../include/utils.h"
+#include <limits.h>
+
+// 创建索引堆（编号范围为 [0, capacity)）
+IndexedHeap* createIndexedHeap(int capacity) {
+    IndexedHeap* heap = (IndexedHeap*)safeMalloc(sizeof(IndexedHeap));
+    if (!heap) return NULL;
+    
+    heap->entries = NULL;
+    heap->position = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+    
+    if (reserveIndexedHeap(heap, maxInt(capacity, 1)) != 0) {
+        destroyIndexedHeap(heap);
+        return NULL;
+    }
+    return heap;
+}
+
+// 销毁索引堆
+void destroyIndexedHeap(IndexedHeap* heap) {
+    if (!heap) return;
+    
+    free(heap->entries);
+    free(heap->position);
+    free(heap);
+}
+
+// 扩展编号范围（已有元素保持不变）
+int reserveIndexedHeap(IndexedHeap* heap, int capacity) {
+    if (!heap || capacity < 0) return -1;
+    if (capacity <= heap->capacity) return 0;
+    
+    heap->entries = (HeapEntry*)safeRealloc(heap->entries, (size_t)capacity * sizeof(HeapEntry));
+    heap->position = (int*)safeRealloc(heap->position, (size_t)capacity * sizeof(int));
+    for (int i = heap->capacity; i < capacity; i++) {
+        heap->position[i] = -1;
+    }
+    heap->capacity = capacity;
+    return 0;
+}
+
+// 清空堆：只重置仍在堆中的元素，代价与剩余元素数成正比
+void clearIndexedHeap(IndexedHeap* heap) {
+    if (!heap) return;
+    
+    for (int i = 0; i < heap->size; i++) {
+        heap->position[heap->entries[i].id] = -1;
+    }
+    heap->size = 0;
+}
+
+// 检查堆是否为空
+int isIndexedHeapEmpty(const IndexedHeap* heap) {
+    return !heap || heap->size == 0;
+}
+
+// 检查编号是否在堆中
+int indexedHeapContains(const IndexedHeap* heap, int id) {
+    return heap && id >= 0 && id < heap->capacity && heap->position[id] != -1;
+}
+
+// 上浮
+static void siftUp(IndexedHeap* heap, int index) {
+    HeapEntry entry = heap->entries[index];
+    
+    while (index > 0) {
+        int parent = (index - 1) / HEAP_ARITY;
+        if (heap->entries[parent].key <= entry.key) break;
+        
+        heap->entries[index] = heap->entries[parent];
+        heap->position[heap->entries[index].id] = index;
+        index = parent;
+    }
+    
+    heap->entries[index] = entry;
+    heap->position[entry.id] = index;
+}
+
+// 下沉
+static void siftDown(IndexedHeap* heap, int index) {
+    HeapEntry entry = heap->entries[index];
+    
+    while (1) {
+        int first = index * HEAP_ARITY + 1;
+        if (first >= heap->size) break;
+        
+        // 在至多HEAP_ARITY个子节点中找最小者
+        int last = minInt(first + HEAP_ARITY, heap->size);
+        int best = first;
+        for (int child = first + 1; child < last; child++) {
+            if (heap->entries[child].key < heap->entries[best].key) {
+                best = child;
+            }
+        }
+        
+        if (heap->entries[best].key >= entry.key) break;
+        
+        heap->entries[index] = heap->entries[best];
+        heap->position[heap->entries[index].id] = index;
+        index = best;
+    }
+    
+    heap->entries[index] = entry;
+    heap->position[entry.id] = index;
+}
+
+// 入堆：编号不在堆中则插入；已在堆中且新键值更小则执行decrease-key，否则忽略
+void indexedHeapPush(IndexedHeap* heap, int id, int key) {
+    if (!heap || id < 0 || id >= heap->capacity) return;
+    
+    int index = heap->position[id];
+    if (index == -1) {
+        index = heap->size++;
+        heap->entries[index].id = id;
+        heap->entries[index].key = key;
+        siftUp(heap, index);
+    } else if (key < heap->entries[index].key) {
+        heap->entries[index].key = key;
+        siftUp(heap, index);
+    }
+}
+
+// 设置键值：编号不在堆中则插入，否则按新键值上浮或下沉（允许增大键值）
+void indexedHeapUpdate(IndexedHeap* heap, int id, int key) {
+    if (!heap || id < 0 || id >= heap->capacity) return;
+    
+    int index = heap->position[id];
+    if (index == -1 || key < heap->entries[index].key) {
+        indexedHeapPush(heap, id, key);
+    } else if (key > heap->entries[index].key) {
+        heap->entries[index].key = key;
+        siftDown(heap, index);
+    }
+}
+
+// 弹出最小元素，返回其编号（堆为空时返回-1），key可为NULL
+int indexedHeapPop(IndexedHeap* heap, int* key) {
+    if (!heap || heap->size == 0) return -1;
+    
+    HeapEntry top = heap->entries[0];
+    heap->position[top.id] = -1;
+    heap->size--;
+    
+    if (heap->size > 0) {
+        heap->entries[0] = heap->entries[heap->size];
+        siftDown(heap, 0);
+    }
+    
+    if (key) *key = top.key;
+    return top.id;
+}
+
+// 查看最小键值（堆为空时返回INT_MAX）
+int indexedHeapTopKey(const IndexedHeap* heap) {
+    if (!heap || heap->size == 0) return INT_MAX;
+    return heap->entries[0].key;
+}
+
+
+// ==================== 单调基数堆 ====================
+
+#define RADIX_BUCKET_INITIAL_CAPACITY 8
+
+// 创建基数堆
+RadixHeap* createRadixHeap() {
+    RadixHeap* heap = (RadixHeap*)safeMalloc(sizeof(RadixHeap));
+    if (!heap) return NULL;
+    
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        heap->buckets[i].items = NULL;
+        heap->buckets[i].size = 0;
+        heap->buckets[i].capacity = 0;
+    }
+    heap->last = 0;
+    heap->size = 0;
+    return heap;
+}
+
+// 销毁基数堆
+void destroyRadixHeap(RadixHeap* heap) {
+    if (!heap) return;
+    
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        free(heap->buckets[i].items);
+    }
+    free(heap);
+}
+
+// 清空基数堆（保留各桶已分配的空间）
+void clearRadixHeap(RadixHeap* heap) {
+    if (!heap) return;
+    
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        heap->buckets[i].size = 0;
+    }
+    heap->last = 0;
+    heap->size = 0;
+}
+
+// 检查基数堆是否为空
+int isRadixHeapEmpty(const RadixHeap* heap) {
+    return !heap || heap->size == 0;
+}
+
+// 计算键值所属的桶：与last相同为0号桶，否则为最高不同位的位置加1
+static int radixBucketIndex(unsigned int key, unsigned int last) {
+    unsigned int diff = key ^ last;
+    if (diff == 0) return 0;
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(diff);
+#else
+    int index = 0;
+    while (diff) {
+        index++;
+        diff >>= 1;
+    }
+    return index;
+#endif
+}
+
+// 向桶中追加元素（容量不足时倍增）
+static void radixBucketAppend(RadixBucket* bucket, int id, unsigned int key) {
+    if (bucket->size == bucket->capacity) {
+        bucket->capacity = bucket->capacity ? bucket->capacity * 2 : RADIX_BUCKET_INITIAL_CAPACITY;
+        bucket->items = (HeapEntry*)safeRealloc(bucket->items, (size_t)bucket->capacity * sizeof(HeapEntry));
+    }
+    bucket->items[bucket->size].id = id;
+    bucket->items[bucket->size].key = (int)key;
+    bucket->size++;
+}
+
+// 入堆（键值须为非负数；小于last的键值按last处理）
+void radixHeapPush(RadixHeap* heap, int id, int key) {
+    if (!heap || key < 0) return;
+    
+    unsigned int k = (unsigned int)key;
+    if (k < heap->last) k = heap->last;
+    
+    radixBucketAppend(&heap->buckets[radixBucketIndex(k, heap->last)], id, k);
+    heap->size++;
+}
+
+// 弹出最小元素，返回其编号（堆为空时返回-1），key可为NULL
+int radixHeapPop(RadixHeap* heap, int* key) {
+    if (!heap || heap->size == 0) return -1;
+    
+    if (heap->buckets[0].size == 0) {
+        // 找到第一个非空桶，以其最小键值为新的last并重新分桶
+        int index = 1;
+        while (heap->buckets[index].size == 0) index++;
+        
+        RadixBucket* bucket = &heap->buckets[index];
+        unsigned int minKey = (unsigned int)bucket->items[0].key;
+        for (int i = 1; i < bucket->size; i++) {
+            if ((unsigned int)bucket->items[i].key < minKey) {
+                minKey = (unsigned int)bucket->items[i].key;
+            }
+        }
+        
+        heap->last = minKey;
+        for (int i = 0; i < bucket->size; i++) {
+            unsigned int k = (unsigned int)bucket->items[i].key;
+            radixBucketAppend(&heap->buckets[radixBucketIndex(k, minKey)], bucket->items[i].id, k);
+        }
+        bucket->size = 0;
+    }
+    
+    RadixBucket* first = &heap->buckets[0];
+    first->size--;
+    heap->size--;
+    
+    if (key) *key = first->items[first->size].key;
+    return first->items[first->size].id;
+}
@@ -0,0 +1,155 @@
+#include "../include/landmarks.h"
+#include "../include/heap.h"
+#include "../include/utils.h"
+
+// 从source出发的全图Dijkstra（reverse为真时沿反向CSR，得到各节点到source的距离），结果写入dist
+static void landmarkDistances(Graph* graph, int source, TransportMode mode, int reverse,
+                              IndexedHeap* heap, int* dist) {
+    const int* offsets = reverse ? graph->rcsrOffsets : graph->csrOffsets;
+    const int* neighbors = reverse ? graph->rcsrSources : graph->csrTargets;
+    const int* weights = reverse ? graph->rcsrWeights[mode] : graph->csrWeights[mode];
+    
+    for (int v = 0; v < graph->nodeCount; v++) {
+        dist[v] = INF;
+    }
+    dist[source] = 0;
+    indexedHeapPush(heap, source, 0);
+    
+    while (!isIndexedHeapEmpty(heap)) {
+        int currentDist;
+        int current = indexedHeapPop(heap, &currentDist);
+        if (!graph->nodes[current].isActive) continue;
+        
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int neighbor = neighbors[i];
+            if (weights[i] == INF || !graph->nodes[neighbor].isActive) continue;
+            
+            int newDist = currentDist + weights[i];
+            if (newDist < dist[neighbor]) {
+                dist[neighbor] = newDist;
+                indexedHeapPush(heap, neighbor, newDist);
+            }
+        }
+    }
+}
+
+// 选点用的距离：往返距离之和（单向不可达的部分按0计），双向都不可达时为INF
+static inline int selectionDistance(int to, int from) {
+    if (to == INF && from == INF) return INF;
+    return (to == INF ? 0 : to) + (from == INF ? 0 : from);
+}
+
+// 构建地标：先取离第一个活跃节点最远的节点作为首个地标，
+// 之后每次选取到已有地标最小距离最大的节点（不同连通分量的节点优先）
+LandmarkSet* buildLandmarks(Graph* graph, int count) {
+    if (!graph || count <= 0) return NULL;
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return NULL;
+    
+    int n = graph->nodeCount;
+    int activeCount = 0;
+    int first = -1;
+    for (int v = 0; v < n; v++) {
+        if (graph->nodes[v].isActive) {
+            activeCount++;
+            if (first == -1) first = v;
+        }
+    }
+    if (activeCount == 0) return NULL;
+    count = minInt(minInt(count, MAX_LANDMARKS), activeCount);
+    
+    LandmarkSet* set = (LandmarkSet*)safeMalloc(sizeof(LandmarkSet));
+    if (!set) return NULL;
+    
+    set->count = count;
+    set->nodeCount = n;
+    set->landmarks = (int*)safeMalloc((size_t)count * sizeof(int));
+    for (int m = 0; m < MODE_COUNT; m++) {
+        set->distTo[m] = (int*)safeMalloc((size_t)n * count * sizeof(int));
+        set->distFrom[m] = (int*)safeMalloc((size_t)n * count * sizeof(int));
+    }
+    
+    IndexedHeap* heap = createIndexedHeap(n);
+    int* dist = (int*)safeMalloc((size_t)n * sizeof(int));
+    int* reverseDist = (int*)safeMalloc((size_t)n * sizeof(int));
+    int* nearest = (int*)safeMalloc((size_t)n * sizeof(int));   // 到已选地标的最小选点距离
+    
+    // 首个地标：离first最远的节点
+    landmarkDistances(graph, first, MODE_WALKING, 0, heap, dist);
+    landmarkDistances(graph, first, MODE_WALKING, 1, heap, reverseDist);
+    for (int v = 0; v < n; v++) {
+        nearest[v] = selectionDistance(reverseDist[v], dist[v]);
+    }
+    nearest[first] = 0;
+    
+    for (int i = 0; i < count; i++) {
+        // 选取nearest最大的活跃节点（已选地标的nearest为0）
+        int landmark = first;
+        for (int v = 0; v < n; v++) {
+            if (graph->nodes[v].isActive && nearest[v] > nearest[landmark]) {
+                landmark = v;
+            }
+        }
+        set->landmarks[i] = landmark;
+        
+        // 计算该地标在各交通方式下的正反向距离，并按节点连续存放
+        for (int m = 0; m < MODE_COUNT; m++) {
+            landmarkDistances(graph, landmark, (TransportMode)m, 0, heap, dist);
+            landmarkDistances(graph, landmark, (TransportMode)m, 1, heap, reverseDist);
+            for (int v = 0; v < n; v++) {
+                set->distFrom[m][v * count + i] = dist[v];
+                set->distTo[m][v * count + i] = reverseDist[v];
+            }
+        }
+        
+        // 首个地标选出后，起始节点first的距离不再参与选点
+        for (int v = 0; v < n; v++) {
+            int d = selectionDistance(set->distTo[MODE_WALKING][v * count + i],
+                                      set->distFrom[MODE_WALKING][v * count + i]);
+            nearest[v] = i == 0 ? d : minInt(nearest[v], d);
+        }
+        nearest[landmark] = 0;
+    }
+    
+    destroyIndexedHeap(heap);
+    free(dist);
+    free(reverseDist);
+    free(nearest);
+    return set;
+}
+
+// 销毁地标
+void destroyLandmarks(LandmarkSet* set) {
+    if (!set) return;
+    
+    free(set->landmarks);
+    for (int m = 0; m < MODE_COUNT; m++) {
+        free(set->distTo[m]);
+        free(set->distFrom[m]);
+    }
+    free(set);
+}
+
+// 距离下界：对每个地标L，d(from,to) >= d(L,to) - d(L,from) 且 d(from,to) >= d(from,L) - d(to,L)，
+// 取所有地标中的最大值；涉及不可达（INF）的项不提供信息，构建后新增的节点返回0
+int landmarkLowerBound(const LandmarkSet* set, TransportMode mode, int from, int to) {
+    if (!set || from < 0 || to < 0 || from >= set->nodeCount || to >= set->nodeCount) {
+        return 0;
+    }
+    
+    int k = set->count;
+    const int* fromTo = set->distTo[mode] + (size_t)from * k;     // d(from, L)
+    const int* targetTo = set->distTo[mode] + (size_t)to * k;     // d(to, L)
+    const int* fromFrom = set->distFrom[mode] + (size_t)from * k; // d(L, from)
+    const int* targetFrom = set->distFrom[mode] + (size_t)to * k; // d(L, to)
+    
+    int bound = 0;
+    for (int i = 0; i < k; i++) {
+        if (targetFrom[i] != INF && fromFrom[i] != INF && targetFrom[i] - fromFrom[i] > bound) {
+            bound = targetFrom[i] - fromFrom[i];
+        }
+        if (fromTo[i] != INF && targetTo[i] != INF && fromTo[i] - targetTo[i] > bound) {
+            bound = fromTo[i] - targetTo[i];
+        }
+    }
+    return bound;
+}
@@ -0,0 +1,446 @@
+#include "../include/loader.h"
+
+// 一行中的字段（指向映射内存，不以'\0'结尾）
+typedef struct {
+    const char* text;
+    int length;
+} Token;
+
+// 清空加载结果
+static void resetLoadStatus(GraphLoadStatus* status) {
+    status->error = ERR_NONE;
+    status->line = 0;
+    status->message[0] = '\0';
+    status->nodeCount = 0;
+    status->edgeCount = 0;
+}
+
+// 记录错误
+static int loadError(GraphLoadStatus* status, ErrorCode error, int line, const char* message, const Token* token) {
+    status->error = error;
+    status->line = line;
+    if (token) {
+        snprintf(status->message, LOADER_MESSAGE_LEN, "%s: %.*s", message, minInt(token->length, 64), token->text);
+    } else {
+        snprintf(status->message, LOADER_MESSAGE_LEN, "%s", message);
+    }
+    return -1;
+}
+
+// 字段是否等于关键字
+static int tokenEquals(const Token* token, const char* keyword) {
+    int length = (int)strlen(keyword);
+    return token->length == length && memcmp(token->text, keyword, (size_t)length) == 0;
+}
+
+// 将字段复制为节点名称（按addNode的规则截断）
+static void tokenToName(const Token* token, char* name) {
+    int length = minInt(token->length, MAX_NAME_LEN - 1);
+    memcpy(name, token->text, (size_t)length);
+    name[length] = '\0';
+}
+
+// 读取*p处的一行并按空白切分字段，*p前进到下一行开头。
+// 以comment开头的行视为空行；返回字段数，字段过多时返回-1
+static int nextLineTokens(const char** p, const char* end, char comment, Token* tokens) {
+    const char* lineEnd = (const char*)memchr(*p, '\n', (size_t)(end - *p));
+    const char* q = *p;
+    *p = lineEnd ? lineEnd + 1 : end;
+    if (!lineEnd) lineEnd = end;
+    if (lineEnd > q && lineEnd[-1] == '\r') lineEnd--;
+    
+    int count = 0;
+    while (q < lineEnd) {
+        while (q < lineEnd && (*q == ' ' || *q == '\t')) q++;
+        if (q == lineEnd) break;
+        if (count == 0 && *q == comment) break;
+        if (count == LOADER_MAX_TOKENS) return -1;
+        
+        tokens[count].text = q;
+        while (q < lineEnd && *q != ' ' && *q != '\t') q++;
+        tokens[count].length = (int)(q - tokens[count].text);
+        count++;
+    }
+    return count;
+}
+
+// 解析整数字段，返回0表示成功
+static int parseIntToken(const Token* token, int* value) {
+    const char* p = token->text;
+    const char* end = p + token->length;
+    int negative = 0;
+    
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end) return -1;
+    
+    long long result = 0;
+    for (; p < end; p++) {
+        if (*p < '0' || *p > '9') return -1;
+        result = result * 10 + (*p - '0');
+        if (result > INT_MAX) return -1;
+    }
+    *value = (int)(negative ? -result : result);
+    return 0;
+}
+
+// 解析小数字段（[符号]数字[.数字][e[符号]数字]），返回0表示成功
+static int parseFloatToken(const Token* token, float* value) {
+    const char* p = token->text;
+    const char* end = p + token->length;
+    int negative = 0;
+    
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    
+    double result = 0.0;
+    int digits = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        result = result * 10.0 + (*p - '0');
+    }
+    if (p < end && *p == '.') {
+        double scale = 0.1;
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+            result += (*p - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+    if (digits == 0) return -1;
+    
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        Token exponentToken = { p + 1, (int)(end - p - 1) };
+        int exponent;
+        if (parseIntToken(&exponentToken, &exponent) != 0 || exponent > 38 || exponent < -38) return -1;
+        result *= pow(10.0, exponent);
+        p = end;
+    }
+    if (p != end) return -1;
+    
+    *value = (float)(negative ? -result : result);
+    return 0;
+}
+
+// 解析一条NODE记录
+static int parseNodeRecord(Graph* graph, const Token* tokens, int count, int line, GraphLoadStatus* status) {
+    if (count != 5) return loadError(status, ERR_FILE_FORMAT, line, "NODE需要4个字段", NULL);
+    
+    float lat, lng;
+    int type;
+    if (parseFloatToken(&tokens[2], &lat) != 0) return loadError(status, ERR_FILE_FORMAT, line, "无效的纬度", &tokens[2]);
+    if (parseFloatToken(&tokens[3], &lng) != 0) return loadError(status, ERR_FILE_FORMAT, line, "无效的经度", &tokens[3]);
+    if (parseIntToken(&tokens[4], &type) != 0 || type < NODE_NORMAL || type > NODE_OBSTACLE) {
+        return loadError(status, ERR_FILE_FORMAT, line, "无效的节点类型", &tokens[4]);
+    }
+    
+    char name[MAX_NAME_LEN];
+    tokenToName(&tokens[1], name);
+    if (addNode(graph, name, lat, lng, (NodeType)type) == -1) {
+        return loadError(status, ERR_INVALID_INPUT, line, "重复的节点名称", &tokens[1]);
+    }
+    status->nodeCount++;
+    return 0;
+}
+
+// 最近一次解析的端点（导出文件通常按起点分组，连续的边共享起点时跳过哈希查找）
+typedef struct {
+    Token token;
+    int nodeId;
+} EndpointCache;
+
+// 经名称索引解析边的端点，未定义返回-1
+static int resolveEndpoint(Graph* graph, const Token* token, EndpointCache* cache) {
+    if (cache->nodeId != -1 && cache->token.length == token->length &&
+        memcmp(cache->token.text, token->text, (size_t)token->length) == 0) {
+        return cache->nodeId;
+    }
+    
+    char name[MAX_NAME_LEN];
+    tokenToName(token, name);
+    int nodeId = findNodeByName(graph, name);
+    if (nodeId != -1) {
+        cache->token = *token;
+        cache->nodeId = nodeId;
+    }
+    return nodeId;
+}
+
+// 解析一条EDGE记录
+static int parseEdgeRecord(Graph* graph, const Token* tokens, int count, int line,
+                           EndpointCache* endpoints, GraphLoadStatus* status) {
+    if (count != 7) return loadError(status, ERR_FILE_FORMAT, line, "EDGE需要6个字段", NULL);
+    
+    int from = resolveEndpoint(graph, &tokens[1], &endpoints[0]);
+    if (from == -1) return loadError(status, ERR_NODE_NOT_FOUND, line, "未定义的起点", &tokens[1]);
+    
+    int to = resolveEndpoint(graph, &tokens[2], &endpoints[1]);
+    if (to == -1) return loadError(status, ERR_NODE_NOT_FOUND, line, "未定义的终点", &tokens[2]);
+    
+    int values[4];
+    for (int i = 0; i < 4; i++) {
+        if (parseIntToken(&tokens[3 + i], &values[i]) != 0 || values[i] < 0) {
+            return loadError(status, ERR_FILE_FORMAT, line, "无效的数值", &tokens[3 + i]);
+        }
+    }
+    
+    if (addEdge(graph, from, to, values[0], values[1], values[2], values[3]) == -1) {
+        return loadError(status, ERR_MEMORY_ALLOCATION, line, "添加边失败", NULL);
+    }
+    status->edgeCount++;
+    return 0;
+}
+
+// 粗略统计NODE/EDGE记录数（只看行首字符，用于预留容量）
+static void countRecords(const char* data, size_t size, int* nodes, int* edges) {
+    const char* p = data;
+    const char* end = data + size;
+    long long nodeLines = 0;
+    long long edgeLines = 0;
+    
+    while (p < end) {
+        if (*p == 'N') nodeLines++;
+        else if (*p == 'E') edgeLines++;
+        
+        const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!lineEnd) break;
+        p = lineEnd + 1;
+    }
+    *nodes = nodeLines > INT_MAX ? INT_MAX : (int)nodeLines;
+    *edges = edgeLines > INT_MAX ? INT_MAX : (int)edgeLines;
+}
+
+// 解析文本格式的图数据
+int parseGraphText(Graph* graph, const char* data, size_t size, GraphLoadStatus* status) {
+    GraphLoadStatus local;
+    if (!status) status = &local;
+    
+    resetLoadStatus(status);
+    if (!graph || (!data && size > 0)) return loadError(status, ERR_INVALID_INPUT, 0, "无效参数", NULL);
+    
+    // 预先按记录行数一次性预留节点、边和索引的容量，避免逐步扩容时的复制和重新哈希
+    int nodeLines, edgeLines;
+    countRecords(data, size, &nodeLines, &edgeLines);
+    if (reserveGraph(graph, graph->nodeCount + nodeLines, graph->edgeCount + edgeLines) != 0) {
+        return loadError(status, ERR_MEMORY_ALLOCATION, 0, "无法预留图的容量", NULL);
+    }
+    
+    EndpointCache endpoints[2] = { { { NULL, 0 }, -1 }, { { NULL, 0 }, -1 } };
+    const char* p = data;
+    const char* end = data + size;
+    int line = 0;
+    
+    while (p < end) {
+        line++;
+        Token tokens[LOADER_MAX_TOKENS];
+        int count = nextLineTokens(&p, end, '#', tokens);
+        if (count < 0) return loadError(status, ERR_FILE_FORMAT, line, "字段过多", NULL);
+        if (count == 0) continue;
+        
+        int result;
+        if (tokenEquals(&tokens[0], "NODE")) {
+            result = parseNodeRecord(graph, tokens, count, line, status);
+        } else if (tokenEquals(&tokens[0], "EDGE")) {
+            result = parseEdgeRecord(graph, tokens, count, line, endpoints, status);
+        } else {
+            result = loadError(status, ERR_FILE_FORMAT, line, "未知的记录类型", &tokens[0]);
+        }
+        if (result != 0) return -1;
+    }
+    
+    freezeGraph(graph);
+    return 0;
+}
+
+// 只读映射待加载的文件，失败时记录错误
+static int mapLoaderFile(const char* path, MappedFile* file, GraphLoadStatus* status) {
+    if (isValidString(path) && mapFileReadOnly(path, file) == 0) return 0;
+    
+    resetLoadStatus(status);
+    status->error = ERR_FILE_IO;
+    snprintf(status->message, LOADER_MESSAGE_LEN, "无法打开文件: %s", path ? path : "(null)");
+    return -1;
+}
+
+// 以内存映射方式读取文件并解析
+int loadGraphFromFile(Graph* graph, const char* path, GraphLoadStatus* status) {
+    GraphLoadStatus local;
+    if (!status) status = &local;
+    
+    MappedFile file;
+    if (mapLoaderFile(path, &file, status) != 0) return -1;
+    
+    int result = parseGraphText(graph, file.data, file.size, status);
+    unmapFile(&file);
+    return result;
+}
+
+// 创建新图并从文件加载
+Graph* loadGraph(const char* path, GraphLoadStatus* status) {
+    Graph* graph = createGraph();
+    if (!graph) return NULL;
+    
+    if (loadGraphFromFile(graph, path, status) != 0) {
+        destroyGraph(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+// 解析DIMACS弧文件：p行给出规模并一次性创建全部节点，之后每条弧直接追加到预留好的数组中
+static int parseDimacsArcs(Graph* graph, const char* data, size_t size, GraphLoadStatus* status) {
+    const char* p = data;
+    const char* end = data + size;
+    int line = 0;
+    int declared = 0;
+    int declaredArcs = 0;
+    int arcCount = 0;
+    
+    while (p < end) {
+        line++;
+        Token tokens[LOADER_MAX_TOKENS];
+        int count = nextLineTokens(&p, end, 'c', tokens);
+        if (count < 0) return loadError(status, ERR_FILE_FORMAT, line, "字段过多", NULL);
+        if (count == 0) continue;
+        
+        if (tokenEquals(&tokens[0], "a")) {
+            int from, to, weight;
+            if (!declared) return loadError(status, ERR_FILE_FORMAT, line, "弧出现在p行之前", NULL);
+            if (count != 4 || parseIntToken(&tokens[1], &from) != 0 || parseIntToken(&tokens[2], &to) != 0 ||
+                parseIntToken(&tokens[3], &weight) != 0) {
+                return loadError(status, ERR_FILE_FORMAT, line, "弧的格式应为 a <起点> <终点> <长度>", NULL);
+            }
+            if (from < 1 || from > graph->nodeCount) return loadError(status, ERR_NODE_NOT_FOUND, line, "起点编号越界", &tokens[1]);
+            if (to < 1 || to > graph->nodeCount) return loadError(status, ERR_NODE_NOT_FOUND, line, "终点编号越界", &tokens[2]);
+            if (weight < 0) return loadError(status, ERR_FILE_FORMAT, line, "无效的弧长", &tokens[3]);
+            if (arcCount == declaredArcs) return loadError(status, ERR_FILE_FORMAT, line, "弧数超过p行声明的数量", NULL);
+            
+            if (addEdge(graph, from - 1, to - 1, weight, weight, weight, weight) == -1) {
+                return loadError(status, ERR_MEMORY_ALLOCATION, line, "添加边失败", NULL);
+            }
+            arcCount++;
+            status->edgeCount++;
+        } else if (tokenEquals(&tokens[0], "p")) {
+            int nodes, arcs;
+            if (declared) return loadError(status, ERR_FILE_FORMAT, line, "重复的p行", NULL);
+            if (count != 4 || !tokenEquals(&tokens[1], "sp") || parseIntToken(&tokens[2], &nodes) != 0 ||
+                parseIntToken(&tokens[3], &arcs) != 0 || nodes < 0 || arcs < 0) {
+                return loadError(status, ERR_FILE_FORMAT, line, "p行的格式应为 p sp <节点数> <弧数>", NULL);
+            }
+            if (reserveGraph(graph, nodes, arcs) != 0) {
+                return loadError(status, ERR_MEMORY_ALLOCATION, line, "无法预留图的容量", NULL);
+            }
+            
+            // DIMACS编号v（从1开始）对应节点v-1，名称为"v<编号>"
+            char name[MAX_NAME_LEN];
+            for (int v = 1; v <= nodes; v++) {
+                snprintf(name, sizeof(name), "v%d", v);
+                if (addNode(graph, name, 0.0f, 0.0f, NODE_NORMAL) == -1) {
+                    return loadError(status, ERR_MEMORY_ALLOCATION, line, "创建节点失败", NULL);
+                }
+            }
+            status->nodeCount = nodes;
+            declaredArcs = arcs;
+            declared = 1;
+        } else {
+            return loadError(status, ERR_FILE_FORMAT, line, "未知的记录类型", &tokens[0]);
+        }
+    }
+    
+    if (!declared) return loadError(status, ERR_FILE_FORMAT, 0, "缺少p行", NULL);
+    // 弧数不足通常是文件被截断
+    if (arcCount != declaredArcs) return loadError(status, ERR_FILE_FORMAT, line, "弧数少于p行声明的数量", NULL);
+    return 0;
+}
+
+// 解析DIMACS坐标文件：v <编号> <x> <y>，x、y为以百万分之一度表示的经度和纬度
+static int parseDimacsCoordinates(Graph* graph, const char* data, size_t size, GraphLoadStatus* status) {
+    const char* p = data;
+    const char* end = data + size;
+    int line = 0;
+    
+    while (p < end) {
+        line++;
+        Token tokens[LOADER_MAX_TOKENS];
+        int count = nextLineTokens(&p, end, 'c', tokens);
+        if (count < 0) return loadError(status, ERR_FILE_FORMAT, line, "字段过多", NULL);
+        if (count == 0) continue;
+        
+        if (tokenEquals(&tokens[0], "v")) {
+            int id, x, y;
+            if (count != 4 || parseIntToken(&tokens[1], &id) != 0 || parseIntToken(&tokens[2], &x) != 0 ||
+                parseIntToken(&tokens[3], &y) != 0) {
+                return loadError(status, ERR_FILE_FORMAT, line, "坐标的格式应为 v <编号> <x> <y>", NULL);
+            }
+            if (id < 1 || id > graph->nodeCount) return loadError(status, ERR_NODE_NOT_FOUND, line, "坐标的节点编号越界", &tokens[1]);
+            
+            Node* node = &graph->nodes[id - 1];
+            node->longitude = (float)(x / 1e6);
+            node->latitude = (float)(y / 1e6);
+        } else if (tokenEquals(&tokens[0], "p")) {
+            int nodes;
+            if (count != 5 || parseIntToken(&tokens[4], &nodes) != 0 || nodes != graph->nodeCount) {
+                return loadError(status, ERR_FILE_FORMAT, line, "坐标文件与弧文件的节点数不一致", NULL);
+            }
+        } else {
+            return loadError(status, ERR_FILE_FORMAT, line, "未知的记录类型", &tokens[0]);
+        }
+    }
+    return 0;
+}
+
+// 从DIMACS文件创建图
+Graph* loadDimacsGraph(const char* grPath, const char* coPath, GraphLoadStatus* status) {
+    GraphLoadStatus local;
+    if (!status) status = &local;
+    resetLoadStatus(status);
+    
+    MappedFile file;
+    if (mapLoaderFile(grPath, &file, status) != 0) return NULL;
+    
+    Graph* graph = createGraph();
+    int result = parseDimacsArcs(graph, file.data, file.size, status);
+    unmapFile(&file);
+    
+    if (result == 0 && coPath) {
+        int nodeCount = status->nodeCount;
+        int edgeCount = status->edgeCount;
+        result = mapLoaderFile(coPath, &file, status);
+        if (result == 0) {
+            result = parseDimacsCoordinates(graph, file.data, file.size, status);
+            unmapFile(&file);
+        }
+        status->nodeCount = nodeCount;
+        status->edgeCount = edgeCount;
+    }
+    
+    if (result != 0) {
+        destroyGraph(graph);
+        return NULL;
+    }
+    freezeGraph(graph);
+    return graph;
+}
+
+// 加载DIMACS弧文件及同名的坐标文件
+Graph* loadDimacsGraphWithCoordinates(const char* grPath, GraphLoadStatus* status) {
+    if (!isValidString(grPath) || strlen(grPath) < 3) return loadDimacsGraph(grPath, NULL, status);
+    
+    size_t length = strlen(grPath);
+    char* coPath = (char*)safeMalloc(length + 1);
+    memcpy(coPath, grPath, length + 1);
+    memcpy(coPath + length - 3, ".co", 3);
+    
+    int hasCoordinates = 0;
+    FILE* fp = fopen(coPath, "rb");
+    if (fp) {
+        hasCoordinates = 1;
+        fclose(fp);
+    }
+    
+    Graph* graph = loadDimacsGraph(grPath, hasCoordinates ? coPath : NULL, status);
+    free(coPath);
+    return graph;
+}
@@ -4,35 +4,149 @@
 #include "../include/graph.h"
 #include "../include/pathfinding.h"
 #include "../include/utils.h"
+#include "../include/loader.h"
+#include "../include/snapshot.h"
+#include "../include/batch.h"
+#include "../include/server.h"
+#include "../include/multimodal.h"
 
 // 函数声明
 void showMenu();
-void initSampleData(Graph* graph);
+void initSampleData(Graph* graph, FILE* stream);
 void handleAddNode(Graph* graph);
 void handleAddEdge(Graph* graph);
 void handleFindPath(Graph* graph);
+void handleMultiModalPath(Graph* graph, const char* startName, const char* endName);
 void handleUpdateWeight(Graph* graph);
 void handleToggleObstacle(Graph* graph);
 void handleShowGraph(Graph* graph);
+int checkWritable(Graph* graph);
+int hasSuffix(const char* str, const char* suffix);
+void printLoadError(FILE* stream, const GraphLoadStatus* status);
+int saveSnapshotWithIndexes(Graph* graph, const char* path);
+int runBatchMode(Graph* graph, const char* queryPath, int threadCount, int printPath);
+int runServeMode(Graph* graph, const char* graphPath, const char* address, int threadCount, int deadlineMs,
+                 int printPath);
 
-int main() {
+int main(int argc, char* argv[]) {
 #ifdef _WIN32
     // 设置控制台为UTF-8编码
     system("chcp 65001 >nul");
 #endif
-    printf("==================================\n");
-    printf("     基于图的路径规划系统\n");
-    printf("==================================\n\n");
-    
-    // 创建图
-    Graph* graph = createGraph();
-    if (!graph) {
-        printf("创建图失败！\n");
-        return 1;
+    
+    // 参数：[数据文件或快照] [--save-snapshot 输出路径] [--batch 查询文件|- [--threads 线程数] [--no-path]]
+    //       [--serve [监听地址] [--threads 线程数] [--deadline 毫秒] [--no-path]]
+    const char* dataPath = NULL;
+    const char* snapshotPath = NULL;
+    const char* batchPath = NULL;
+    const char* serveAddress = NULL;
+    int threadCount = 0;
+    int deadlineMs = SERVER_DEFAULT_DEADLINE_MS;
+    int printPath = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--save-snapshot") == 0 && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchPath = argv[++i];
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            // 监听地址可省略（地址总含有冒号，以区分数据文件）
+            serveAddress = i + 1 < argc && strchr(argv[i + 1], ':') ? argv[++i] : SERVER_DEFAULT_ADDRESS;
+        } else if (strcmp(argv[i], "--deadline") == 0 && i + 1 < argc) {
+            deadlineMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-path") == 0) {
+            printPath = 0;
+        } else {
+            dataPath = argv[i];
+        }
+    }
+    
+    // 批量模式的标准输出只有结果行，服务模式只有日志，提示信息都改写到标准错误
+    FILE* info = batchPath || serveAddress ? stderr : stdout;
+    if (info == stdout) {
+        printf("==================================\n");
+        printf("     基于图的路径规划系统\n");
+        printf("==================================\n\n");
     }
     
-    // 初始化示例数据
-    initSampleData(graph);
+    Graph* graph = NULL;
+    GraphSnapshot* snapshot = NULL;
+    
+    if (dataPath && isGraphSnapshotFile(dataPath)) {
+        // 快照直接映射，无需解析和冻结
+        ErrorCode error;
+        snapshot = openGraphSnapshot(dataPath, &error);
+        if (!snapshot) {
+            fprintf(info, "打开快照失败: %s\n", getErrorMessage(error));
+            return 1;
+        }
+        graph = snapshot->graph;
+        fprintf(info, "已映射快照 %s（%d 个节点、%d 条边，只读）\n\n", dataPath, graph->nodeCount, graph->edgeCount);
+    } else if (dataPath && hasSuffix(dataPath, ".gr")) {
+        // DIMACS弧文件，同名的.co坐标文件存在时一并读取
+        GraphLoadStatus status;
+        graph = loadDimacsGraphWithCoordinates(dataPath, &status);
+        if (!graph) {
+            printLoadError(info, &status);
+            return 1;
+        }
+        fprintf(info, "已从 %s 加载 %d 个节点、%d 条边\n\n", dataPath, status.nodeCount, status.edgeCount);
+    } else {
+        // 创建图
+        graph = createGraph();
+        if (!graph) {
+            printf("创建图失败！\n");
+            return 1;
+        }
+        
+        // 指定了数据文件时从文件加载，否则使用内置示例数据
+        if (dataPath) {
+            GraphLoadStatus status;
+            if (loadGraphFromFile(graph, dataPath, &status) != 0) {
+                printLoadError(info, &status);
+                destroyGraph(graph);
+                return 1;
+            }
+            fprintf(info, "已从 %s 加载 %d 个节点、%d 条边\n\n", dataPath, status.nodeCount, status.edgeCount);
+        } else {
+            initSampleData(graph, info);
+            freezeGraph(graph);
+        }
+    }
+    
+    // 只生成快照时不进入菜单
+    if (snapshotPath) {
+        int result = saveSnapshotWithIndexes(graph, snapshotPath);
+        if (snapshot) {
+            closeGraphSnapshot(snapshot);
+        } else {
+            destroyGraph(graph);
+        }
+        return result == 0 ? 0 : 1;
+    }
+    
+    // 批量模式：处理完全部查询后退出
+    if (batchPath) {
+        int result = runBatchMode(graph, batchPath, threadCount, printPath);
+        if (snapshot) {
+            closeGraphSnapshot(snapshot);
+        } else {
+            destroyGraph(graph);
+        }
+        return result == 0 ? 0 : 1;
+    }
+    
+    // 服务模式：收到SIGINT或SIGTERM后退出
+    if (serveAddress) {
+        int result = runServeMode(graph, dataPath, serveAddress, threadCount, deadlineMs, printPath);
+        if (snapshot) {
+            closeGraphSnapshot(snapshot);
+        } else {
+            destroyGraph(graph);
+        }
+        return result == 0 ? 0 : 1;
+    }
     
     int choice;
     char input[100];
@@ -68,7 +182,11 @@ int main() {
                 break;
             case 0:
                 printf("感谢使用！再见！\n");
-                destroyGraph(graph);
+                if (snapshot) {
+                    closeGraphSnapshot(snapshot);
+                } else {
+                    destroyGraph(graph);
+                }
                 return 0;
             default:
                 printf("无效选择，请重新输入！\n");
@@ -78,7 +196,11 @@ int main() {
         getchar();
     }
     
-    destroyGraph(graph);
+    if (snapshot) {
+        closeGraphSnapshot(snapshot);
+    } else {
+        destroyGraph(graph);
+    }
     return 0;
 }
 
@@ -94,8 +216,8 @@ void showMenu() {
     printf("=======================\n");
 }
 
-void initSampleData(Graph* graph) {
-    printf("正在初始化示例数据...\n");
+void initSampleData(Graph* graph, FILE* stream) {
+    fprintf(stream, "正在初始化示例数据...\n");
     
     // 添加节点（模拟校园地图）
     addNode(graph, "校门口", 40.0001f, 116.0001f, NODE_TRANSPORT_HUB);
@@ -143,8 +265,8 @@ void initSampleData(Graph* graph) {
     addEdge(graph, 5, 6, 320, 256, 320, 192);  // 体育馆 -> 实验楼
     addEdge(graph, 6, 5, 320, 256, 320, 192);  // 实验楼 -> 体育馆
     
-    printf("示例数据初始化完成！\n");
-    printf("已创建校园地图：校门口、图书馆、教学楼、食堂、宿舍区、体育馆、实验楼\n");
+    fprintf(stream, "示例数据初始化完成！\n");
+    fprintf(stream, "已创建校园地图：校门口、图书馆、教学楼、食堂、宿舍区、体育馆、实验楼\n");
 }
 
 void handleAddNode(Graph* graph) {
@@ -153,6 +275,8 @@ void handleAddNode(Graph* graph) {
     int type;
     
     printf("\n=== 添加节点 ===\n");
+    if (!checkWritable(graph)) return;
+    
     printf("输入节点名称: ");
     if (fgets(name, sizeof(name), stdin) == NULL) return;
     
@@ -176,6 +300,7 @@ void handleAddNode(Graph* graph) {
     int nodeId = addNode(graph, name, lat, lng, (NodeType)type);
     if (nodeId != -1) {
         printf("节点添加成功！ID: %d\n", nodeId);
+        freezeGraph(graph);
     } else {
         printf("节点添加失败！可能是图已满或节点名称重复。\n");
     }
@@ -186,6 +311,8 @@ void handleAddEdge(Graph* graph) {
     int distance, timeCost, walkWeight, driveWeight;
     
     printf("\n=== 添加边 ===\n");
+    if (!checkWritable(graph)) return;
+    
     printf("输入起点名称: ");
     if (fgets(fromName, sizeof(fromName), stdin) == NULL) return;
     fromName[strcspn(fromName, "\n")] = 0;
@@ -217,6 +344,7 @@ void handleAddEdge(Graph* graph) {
     int edgeId = addEdge(graph, fromId, toId, distance, timeCost, walkWeight, driveWeight);
     if (edgeId != -1) {
         printf("边添加成功！ID: %d\n", edgeId);
+        freezeGraph(graph);
     } else {
         printf("边添加失败！\n");
     }
@@ -237,10 +365,14 @@ void handleFindPath(Graph* graph) {
     endName[strcspn(endName, "\n")] = 0;
     trimString(endName);
     
-    printf("选择交通方式 (0-步行, 1-驾车): ");
+    printf("选择交通方式 (0-步行, 1-驾车, 2-步行与驾车组合): ");
     scanf("%d", &mode);
     getchar(); // 消费换行符
     
+    if (mode == MODE_COUNT) {
+        handleMultiModalPath(graph, startName, endName);
+        return;
+    }
     if (mode < 0 || mode >= MODE_COUNT) {
         printf("无效的交通方式！\n");
         return;
@@ -249,23 +381,20 @@ void handleFindPath(Graph* graph) {
     printf("选择路径查找算法:\n");
     printf("0 - Dijkstra算法 (传统最短路径)\n");
     printf("1 - A*算法 (启发式搜索，通常更快)\n");
-    printf("请选择 (0-1): ");
+    printf("2 - 双向Dijkstra算法 (从起点和终点同时搜索)\n");
+    printf("3 - 双向A*算法 (双向启发式搜索)\n");
+    printf("请选择 (0-3): ");
     scanf("%d", &algorithm);
     getchar(); // 消费换行符
     
-    if (algorithm < 0 || algorithm > 1) {
+    if (algorithm < 0 || algorithm >= ALGO_COUNT) {
         printf("无效的算法选择！\n");
         return;
     }
     
-    PathResult* result;
-    printf("\n正在使用%s算法搜索路径...\n", algorithm == 0 ? "Dijkstra" : "A*");
-    
-    if (algorithm == 0) {
-        result = findPathByName(graph, startName, endName, (TransportMode)mode);
-    } else {
-        result = findPathByNameAStar(graph, startName, endName, (TransportMode)mode);
-    }
+    printf("\n正在使用%s算法搜索路径...\n", getAlgorithmName((PathAlgorithm)algorithm));
+    PathResult* result = findPathByNameWithAlgorithm(graph, startName, endName,
+                                                     (TransportMode)mode, (PathAlgorithm)algorithm);
     
     if (result && result->isValid) {
         printPath(graph, result);
@@ -285,11 +414,60 @@ void handleFindPath(Graph* graph) {
     freePathResult(result);
 }
 
+// 步行与驾车组合：只在交通枢纽换乘，出发和到达的方式由用户指定
+void handleMultiModalPath(Graph* graph, const char* startName, const char* endName) {
+    int startMode, endMode;
+    
+    int startId = findNodeByName(graph, startName);
+    int endId = findNodeByName(graph, endName);
+    if (startId == -1 || endId == -1) {
+        printf("起点或终点不存在！\n");
+        return;
+    }
+    
+    printf("出发时的交通方式 (0-步行, 1-驾车, 2-任意): ");
+    scanf("%d", &startMode);
+    printf("到达时的交通方式 (0-步行, 1-驾车, 2-任意): ");
+    scanf("%d", &endMode);
+    getchar(); // 消费换行符
+    
+    if (startMode < 0 || startMode > MODE_COUNT || endMode < 0 || endMode > MODE_COUNT) {
+        printf("无效的交通方式！\n");
+        return;
+    }
+    
+    MultiModalOptions options;
+    initMultiModalOptions(&options);
+    if (startMode < MODE_COUNT) options.startModes = MODE_MASK(startMode);
+    if (endMode < MODE_COUNT) options.endModes = MODE_MASK(endMode);
+    
+    if (!graph->isFrozen) freezeGraph(graph);
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount * MODE_COUNT);
+    if (!ws) {
+        printf("内存不足！\n");
+        return;
+    }
+    
+    MultiModalResult result;
+    initMultiModalResult(&result);
+    printf("\n正在搜索步行与驾车组合的路径（换乘代价 %d）...\n", options.switchPenalty);
+    if (multiModalSearch(ws, graph, startId, endId, &options, NULL, &result) == 0 && result.route.isValid) {
+        printMultiModalPath(graph, &result);
+    } else {
+        printf("未找到从 %s 到 %s 的路径！\n", startName, endName);
+    }
+    
+    clearMultiModalResult(&result);
+    destroySearchWorkspace(ws);
+}
+
 void handleUpdateWeight(Graph* graph) {
     char fromName[MAX_NAME_LEN], toName[MAX_NAME_LEN];
     int mode, newWeight;
     
     printf("\n=== 更新边权重 ===\n");
+    if (!checkWritable(graph)) return;
+    
     printf("输入起点名称: ");
     if (fgets(fromName, sizeof(fromName), stdin) == NULL) return;
     fromName[strcspn(fromName, "\n")] = 0;
@@ -323,6 +501,8 @@ void handleToggleObstacle(Graph* graph) {
     int accessible;
     
     printf("\n=== 设置障碍 ===\n");
+    if (!checkWritable(graph)) return;
+    
     printf("输入节点名称: ");
     if (fgets(name, sizeof(name), stdin) == NULL) return;
     name[strcspn(name, "\n")] = 0;
@@ -338,11 +518,96 @@ void handleToggleObstacle(Graph* graph) {
     scanf("%d", &accessible);
     getchar(); // 消费换行符
     
-    setNodeAccessible(graph, nodeId, accessible);
+    if (setNodeAccessible(graph, nodeId, accessible) != 0) {
+        printf("节点可访问性设置失败！\n");
+        return;
+    }
     printf("节点可访问性设置成功！\n");
 }
 
 void handleShowGraph(Graph* graph) {
     printf("\n=== 显示图信息 ===\n");
     printGraph(graph);
-} 
\ No newline at end of file
+} 
+
+// 图可修改时返回1，映射自快照的只读图给出提示并返回0
+int checkWritable(Graph* graph) {
+    if (graph->isReadOnly) {
+        printf("当前图映射自只读快照，不能修改！\n");
+        return 0;
+    }
+    return 1;
+}
+
+// 字符串是否以suffix结尾
+int hasSuffix(const char* str, const char* suffix) {
+    size_t length = strlen(str);
+    size_t suffixLength = strlen(suffix);
+    return length >= suffixLength && strcmp(str + length - suffixLength, suffix) == 0;
+}
+
+// 打印加载错误
+void printLoadError(FILE* stream, const GraphLoadStatus* status) {
+    if (status->line > 0) {
+        fprintf(stream, "加载失败（第%d行）: %s - %s\n", status->line, getErrorMessage(status->error), status->message);
+    } else {
+        fprintf(stream, "加载失败: %s - %s\n", getErrorMessage(status->error), status->message);
+    }
+}
+
+// 构建地标和各交通方式的收缩层次后连同图一起保存为快照
+int saveSnapshotWithIndexes(Graph* graph, const char* path) {
+    printf("正在构建地标和收缩层次...\n");
+    LandmarkSet* landmarks = buildLandmarks(graph, DEFAULT_LANDMARK_COUNT);
+    ContractionHierarchy* hierarchies[MODE_COUNT];
+    for (int m = 0; m < MODE_COUNT; m++) {
+        hierarchies[m] = buildContractionHierarchy(graph, (TransportMode)m);
+    }
+    
+    int result = saveGraphSnapshot(path, graph, landmarks, hierarchies);
+    if (result == 0) {
+        printf("快照已保存到 %s\n", path);
+    } else {
+        printf("保存快照失败: %s\n", getErrorMessage(ERR_FILE_IO));
+    }
+    
+    destroyLandmarks(landmarks);
+    for (int m = 0; m < MODE_COUNT; m++) {
+        destroyContractionHierarchy(hierarchies[m]);
+    }
+    return result;
+}
+
+// 批量查询：从文件或标准输入（"-"）读取查询，结果写到标准输出，汇总写到标准错误
+int runBatchMode(Graph* graph, const char* queryPath, int threadCount, int printPath) {
+    FILE* input = strcmp(queryPath, "-") == 0 ? stdin : fopen(queryPath, "r");
+    if (!input) {
+        fprintf(stderr, "无法打开查询文件: %s\n", queryPath);
+        return -1;
+    }
+    setvbuf(stdout, NULL, _IOFBF, BATCH_OUTPUT_BUFFER);
+    
+    BatchOptions options = { threadCount, printPath };
+    BatchSummary summary;
+    int result = runBatchQueries(graph, input, stdout, &options, &summary);
+    if (result == 0) {
+        printBatchSummary(stderr, &summary);
+    } else {
+        fprintf(stderr, "批量查询失败: 无法启动查询线程\n");
+    }
+    
+    if (input != stdin) fclose(input);
+    return result;
+}
+
+// 路由服务：只加载一次图，之后通过套接字处理请求；指定了数据文件时支持重新加载
+int runServeMode(Graph* graph, const char* graphPath, const char* address, int threadCount, int deadlineMs,
+                 int printPath) {
+    ServerOptions options;
+    options.listenAddress = address;
+    options.graphPath = graphPath;
+    options.threadCount = threadCount;
+    options.defaultDeadlineMs = deadlineMs;
+    options.printPath = printPath;
+    return runRoutingServer(graph, &options);
+}
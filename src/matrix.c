@@ -0,0 +1,266 @@
+#include "../include/matrix.h"
+#include "../include/pathfinding.h"
+#include "../include/utils.h"
+#include <pthread.h>
+
+// 一次矩阵计算的共享状态：除起点分配计数器外均只读，各线程写入矩阵中互不重叠的行
+typedef struct {
+    Graph* graph;
+    const int* sources;
+    int sourceCount;
+    const int* targets;
+    int targetCount;
+    TransportMode mode;
+    const unsigned char* isTarget;  // 节点是否为（活跃的）终点
+    int distinctTargets;            // 去重后的活跃终点数
+    DistanceMatrix* matrix;
+    
+    pthread_mutex_t lock;           // 保护nextSource
+    int nextSource;                 // 下一个待处理的起点下标
+} MatrixJob;
+
+// 创建距离矩阵（所有项初始化为INF）
+DistanceMatrix* createDistanceMatrix(int sourceCount, int targetCount) {
+    if (sourceCount < 0 || targetCount < 0) return NULL;
+    
+    DistanceMatrix* matrix = (DistanceMatrix*)safeMalloc(sizeof(DistanceMatrix));
+    if (!matrix) return NULL;
+    
+    size_t cells = (size_t)sourceCount * targetCount;
+    size_t bytes = (cells > 0 ? cells : 1) * sizeof(int);
+    matrix->sourceCount = sourceCount;
+    matrix->targetCount = targetCount;
+    matrix->costs = (int*)safeMalloc(bytes);
+    matrix->distances = (int*)safeMalloc(bytes);
+    matrix->times = (int*)safeMalloc(bytes);
+    
+    for (size_t i = 0; i < cells; i++) {
+        matrix->costs[i] = INF;
+        matrix->distances[i] = INF;
+        matrix->times[i] = INF;
+    }
+    return matrix;
+}
+
+// 销毁距离矩阵
+void destroyDistanceMatrix(DistanceMatrix* matrix) {
+    if (!matrix) return;
+    
+    free(matrix->costs);
+    free(matrix->distances);
+    free(matrix->times);
+    free(matrix);
+}
+
+// 每个工作线程的缓冲区（按节点数分配，各行复用）
+typedef struct {
+    int* order;                     // 本行搜索中节点被确定的顺序
+    int* distance;                  // 搜索树上从起点到各已确定节点的总距离
+    int* time;                      // 搜索树上从起点到各已确定节点的总时间
+} MatrixScratch;
+
+// 领取下一个起点，全部分配完返回-1
+static int takeSource(MatrixJob* job) {
+    pthread_mutex_lock(&job->lock);
+    int row = job->nextSource < job->sourceCount ? job->nextSource++ : -1;
+    pthread_mutex_unlock(&job->lock);
+    return row;
+}
+
+// 一对多搜索：从第row个起点出发沿CSR运行Dijkstra，所有终点确定后停止，结果写入矩阵第row行
+static void solveRow(MatrixJob* job, SearchWorkspace* ws, MatrixScratch* scratch, int row) {
+    Graph* graph = job->graph;
+    DistanceMatrix* matrix = job->matrix;
+    int source = job->sources[row];
+    const int* weights = graph->csrWeights[job->mode];
+    
+    beginSearch(ws, graph);
+    SearchLabels* labels = &ws->forward;
+    setLabel(labels, source, 0, -1);
+    indexedHeapPush(labels->heap, source, 0);
+    
+    int remaining = job->distinctTargets;
+    int settledCount = 0;
+    while (remaining > 0 && !isIndexedHeapEmpty(labels->heap)) {
+        int current = indexedHeapPop(labels->heap, NULL);
+        
+        if (isSettled(labels, current) || !graph->nodes[current].isActive) continue;
+        markSettled(labels, current);
+        scratch->order[settledCount++] = current;
+        if (job->isTarget[current]) remaining--;
+        
+        int currentDist = labels->dist[current];
+        int last = graph->csrOffsets[current + 1];
+        for (int i = graph->csrOffsets[current]; i < last; i++) {
+            int neighbor = graph->csrTargets[i];
+            int weight = weights[i];
+            
+            if (weight == INF || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) continue;
+            
+            int newDist = currentDist + weight;
+            if (newDist < labelDist(labels, neighbor)) {
+                setLabel(labels, neighbor, newDist, graph->csrEdgeIds[i]);
+                indexedHeapPush(labels->heap, neighbor, newDist);
+            }
+        }
+    }
+    
+    // 前驱总是先于节点本身被确定，按确定顺序扫描一遍即可累加出每个已确定节点的总距离和时间
+    int needTotals = matrix->distances || matrix->times;
+    for (int k = 0; needTotals && k < settledCount; k++) {
+        int v = scratch->order[k];
+        int edgeId = labels->prevEdge[v];
+        if (edgeId == -1) {
+            scratch->distance[v] = 0;
+            scratch->time[v] = 0;
+        } else {
+            const Edge* edge = &graph->edges[edgeId];
+            scratch->distance[v] = scratch->distance[edge->from] + edge->distance;
+            scratch->time[v] = scratch->time[edge->from] + edge->timeCost;
+        }
+    }
+    
+    // 只有已确定的终点距离是最终结果
+    size_t base = (size_t)row * job->targetCount;
+    for (int j = 0; j < job->targetCount; j++) {
+        int target = job->targets[j];
+        int cost = INF;
+        int distance = INF;
+        int time = INF;
+        
+        if (target == source) {
+            cost = distance = time = 0;
+        } else if (isSettled(labels, target)) {
+            cost = labels->dist[target];
+            if (needTotals) {
+                distance = scratch->distance[target];
+                time = scratch->time[target];
+            }
+        }
+        
+        matrix->costs[base + j] = cost;
+        if (matrix->distances) matrix->distances[base + j] = distance;
+        if (matrix->times) matrix->times[base + j] = time;
+    }
+}
+
+// 工作线程：使用自己的工作区，循环领取起点直到分配完
+static void* matrixWorker(void* arg) {
+    MatrixJob* job = (MatrixJob*)arg;
+    
+    SearchWorkspace* ws = createSearchWorkspace(job->graph->nodeCount);
+    if (!ws) return NULL;
+    
+    size_t bytes = (size_t)maxInt(job->graph->nodeCount, 1) * sizeof(int);
+    MatrixScratch scratch;
+    scratch.order = (int*)safeMalloc(bytes);
+    scratch.distance = (int*)safeMalloc(bytes);
+    scratch.time = (int*)safeMalloc(bytes);
+    
+    int row;
+    while ((row = takeSource(job)) != -1) {
+        solveRow(job, ws, &scratch, row);
+    }
+    
+    free(scratch.order);
+    free(scratch.distance);
+    free(scratch.time);
+    destroySearchWorkspace(ws);
+    return NULL;
+}
+
+// 计算距离矩阵
+int computeDistanceMatrix(Graph* graph, const int* sources, int sourceCount,
+                          const int* targets, int targetCount, TransportMode mode,
+                          int threadCount, DistanceMatrix* matrix) {
+    if (!graph || !matrix || !matrix->costs || sourceCount < 0 || targetCount < 0 ||
+        (sourceCount > 0 && !sources) || (targetCount > 0 && !targets) ||
+        matrix->sourceCount != sourceCount || matrix->targetCount != targetCount ||
+        mode < 0 || mode >= MODE_COUNT) {
+        return -1;
+    }
+    for (int i = 0; i < sourceCount; i++) {
+        if (!isValidNodeId(sources[i], graph->nodeCount)) return -1;
+    }
+    for (int j = 0; j < targetCount; j++) {
+        if (!isValidNodeId(targets[j], graph->nodeCount)) return -1;
+    }
+    if (sourceCount == 0) return 0;
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return -1;
+    
+    // 标记终点（去重，不活跃的终点永远不会被确定，不计入）
+    unsigned char* isTarget = (unsigned char*)safeMalloc((size_t)maxInt(graph->nodeCount, 1));
+    memset(isTarget, 0, (size_t)maxInt(graph->nodeCount, 1));
+    int distinctTargets = 0;
+    for (int j = 0; j < targetCount; j++) {
+        int target = targets[j];
+        if (!isTarget[target] && graph->nodes[target].isActive) {
+            isTarget[target] = 1;
+            distinctTargets++;
+        }
+    }
+    
+    MatrixJob job;
+    job.graph = graph;
+    job.sources = sources;
+    job.sourceCount = sourceCount;
+    job.targets = targets;
+    job.targetCount = targetCount;
+    job.mode = mode;
+    job.isTarget = isTarget;
+    job.distinctTargets = distinctTargets;
+    job.matrix = matrix;
+    job.nextSource = 0;
+    pthread_mutex_init(&job.lock, NULL);
+    
+    if (threadCount <= 0) threadCount = getProcessorCount();
+    threadCount = minInt(threadCount, sourceCount);
+    
+    // 调用线程也作为一个工作线程；创建失败的线程由其余线程分担
+    pthread_t* threads = (pthread_t*)safeMalloc((size_t)maxInt(threadCount - 1, 1) * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; i < threadCount - 1; i++) {
+        if (pthread_create(&threads[started], NULL, matrixWorker, &job) == 0) {
+            started++;
+        }
+    }
+    matrixWorker(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    // 所有线程都无法分配工作区时会有起点未处理
+    int failed = job.nextSource < sourceCount;
+    
+    pthread_mutex_destroy(&job.lock);
+    free(threads);
+    free(isTarget);
+    return failed ? -1 : 0;
+}
+
+// 分配并计算距离矩阵
+DistanceMatrix* distanceMatrix(Graph* graph, const int* sources, int sourceCount,
+                               const int* targets, int targetCount, TransportMode mode) {
+    DistanceMatrix* matrix = createDistanceMatrix(sourceCount, targetCount);
+    if (!matrix) return NULL;
+    
+    if (computeDistanceMatrix(graph, sources, sourceCount, targets, targetCount, mode, 0, matrix) != 0) {
+        destroyDistanceMatrix(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+// 一对多：以调用方数组作为1行的矩阵计算
+int oneToMany(Graph* graph, int source, const int* targets, int targetCount, TransportMode mode,
+              int* costs, int* distances, int* times) {
+    if (!costs) return -1;
+    
+    DistanceMatrix row;
+    row.sourceCount = 1;
+    row.targetCount = targetCount;
+    row.costs = costs;
+    row.distances = distances;
+    row.times = times;
+    return computeDistanceMatrix(graph, &source, 1, targets, targetCount, mode, 1, &row);
+}
@@ -0,0 +1,251 @@
+#include "../include/multimodal.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// 状态编号：同一节点的各交通方式相邻存放，换乘时访问的标签位于同一缓存行
+#define STATE_ID(node, mode) ((node) * MODE_COUNT + (mode))
+#define STATE_NODE(state) ((state) / MODE_COUNT)
+#define STATE_MODE(state) ((TransportMode)((state) % MODE_COUNT))
+
+// 前驱的编码：>=0为同层的前驱边，-1为起点，SWITCH_FROM(m)表示在本节点从方式m换乘而来
+#define SWITCH_FROM(mode) (-2 - (mode))
+#define SWITCHED_MODE(prev) ((TransportMode)(-2 - (prev)))
+
+static const char* modeName(TransportMode mode) {
+    return mode == MODE_WALKING ? "步行" : "驾车";
+}
+
+// 默认选项
+void initMultiModalOptions(MultiModalOptions* options) {
+    if (!options) return;
+    
+    options->startModes = MODE_MASK_ALL;
+    options->endModes = MODE_MASK_ALL;
+    options->switchPenalty = MULTIMODAL_DEFAULT_SWITCH_PENALTY;
+}
+
+// 初始化结果
+void initMultiModalResult(MultiModalResult* result) {
+    if (!result) return;
+    
+    result->route.path = NULL;
+    result->route.edges = NULL;
+    result->route.pathLength = 0;
+    result->route.totalDistance = 0;
+    result->route.totalTime = 0;
+    result->route.isValid = 0;
+    result->edgeModes = NULL;
+    result->modeCapacity = 0;
+    result->totalCost = 0;
+    result->switchCount = 0;
+}
+
+// 释放结果持有的交通方式数组
+void clearMultiModalResult(MultiModalResult* result) {
+    if (!result) return;
+    
+    free(result->edgeModes);
+    result->edgeModes = NULL;
+    result->modeCapacity = 0;
+}
+
+// 在分层状态空间上运行Dijkstra，返回第一个被确定的到达状态（-1表示不可达）。
+// 每个状态最多被确定一次，搜索量至多为单一方式的MODE_COUNT倍
+static int runMultiModal(SearchWorkspace* ws, Graph* graph, int start, int end, const MultiModalOptions* options) {
+    SearchLabels* labels = &ws->forward;
+    const int* targets = graph->csrTargets;
+    
+    for (int m = 0; m < MODE_COUNT; m++) {
+        if (!(options->startModes & MODE_MASK(m))) continue;
+        int state = STATE_ID(start, m);
+        setLabel(labels, state, 0, -1);
+        indexedHeapPush(labels->heap, state, 0);
+        SEARCH_STAT_PUSH(ws, labels->heap->size);
+    }
+    
+    int reachedState = -1;
+    while (!isIndexedHeapEmpty(labels->heap)) {
+        int state = indexedHeapPop(labels->heap, NULL);
+        int current = STATE_NODE(state);
+        TransportMode mode = STATE_MODE(state);
+        
+        if (isSettled(labels, state) || !graph->nodes[current].isActive) {
+            SEARCH_STAT_ADD(ws, stalePops, 1);
+            continue;
+        }
+        markSettled(labels, state);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
+        
+        if (current == end && (options->endModes & MODE_MASK(mode))) {
+            reachedState = state;
+            break;
+        }
+        
+        int cost = labels->dist[state];
+        
+        // 同层：沿当前方式可通行的出边扩展
+        const int* weights = graph->csrWeights[mode];
+        int last = graph->csrOffsets[current + 1];
+        SEARCH_STAT_ADD(ws, relaxedEdges, last - graph->csrOffsets[current]);
+        
+        for (int i = graph->csrOffsets[current]; i < last; i++) {
+            int neighbor = targets[i];
+            if (weights[i] == INF || !graph->nodes[neighbor].isActive) continue;
+            
+            int next = STATE_ID(neighbor, mode);
+            int newCost = cost + weights[i];
+            if (newCost < labelDist(labels, next)) {
+                setLabel(labels, next, newCost, graph->csrEdgeIds[i]);
+                indexedHeapPush(labels->heap, next, newCost);
+                SEARCH_STAT_PUSH(ws, labels->heap->size);
+            }
+        }
+        
+        // 跨层：只在交通枢纽换乘
+        if (graph->nodes[current].type != NODE_TRANSPORT_HUB) continue;
+        
+        for (int m = 0; m < MODE_COUNT; m++) {
+            if (m == (int)mode) continue;
+            
+            int next = STATE_ID(current, m);
+            int newCost = cost + options->switchPenalty;
+            if (newCost < labelDist(labels, next)) {
+                setLabel(labels, next, newCost, SWITCH_FROM(mode));
+                indexedHeapPush(labels->heap, next, newCost);
+                SEARCH_STAT_PUSH(ws, labels->heap->size);
+            }
+        }
+    }
+    
+    SEARCH_STAT_FINISH(ws);
+    return reachedState;
+}
+
+// 沿前驱回溯写出路径和每条边的交通方式
+static int writeMultiModalResult(SearchWorkspace* ws, Graph* graph, int reachedState, const PathBuffer* buffer,
+                                 MultiModalResult* result) {
+    PathResult* route = &result->route;
+    route->path = NULL;
+    route->edges = NULL;
+    route->pathLength = 0;
+    route->totalDistance = 0;
+    route->totalTime = 0;
+    route->isValid = 0;
+    result->totalCost = 0;
+    result->switchCount = 0;
+    
+    if (reachedState < 0) return 0;  // 无路径
+    
+    const int* prevEdge = ws->forward.prevEdge;
+    int pathLength = 1;
+    int switchCount = 0;
+    for (int state = reachedState; prevEdge[state] != -1;) {
+        int prev = prevEdge[state];
+        if (prev >= 0) {
+            pathLength++;
+            state = STATE_ID(graph->edges[prev].from, STATE_MODE(state));
+        } else {
+            switchCount++;
+            state = STATE_ID(STATE_NODE(state), SWITCHED_MODE(prev));
+        }
+    }
+    
+    int* path;
+    int* edges;
+    if (reservePathStorage(ws, buffer, pathLength, &path, &edges) != 0) {
+        route->pathLength = pathLength;
+        return -2;
+    }
+    if (result->modeCapacity < pathLength - 1) {
+        int capacity = maxInt(pathLength - 1, result->modeCapacity * 2);
+        result->edgeModes = (TransportMode*)safeRealloc(result->edgeModes, (size_t)capacity * sizeof(TransportMode));
+        result->modeCapacity = capacity;
+    }
+    
+    int state = reachedState;
+    int i = pathLength - 1;
+    path[i] = STATE_NODE(state);
+    while (prevEdge[state] != -1) {
+        int prev = prevEdge[state];
+        if (prev < 0) {
+            state = STATE_ID(STATE_NODE(state), SWITCHED_MODE(prev));
+            continue;
+        }
+        
+        const Edge* edge = &graph->edges[prev];
+        i--;
+        path[i] = edge->from;
+        if (edges) edges[i] = prev;
+        result->edgeModes[i] = STATE_MODE(state);
+        route->totalDistance += edge->distance;
+        route->totalTime += edge->timeCost;
+        state = STATE_ID(edge->from, STATE_MODE(state));
+    }
+    
+    route->path = path;
+    route->edges = edges;
+    route->pathLength = pathLength;
+    route->isValid = 1;
+    result->totalCost = ws->forward.dist[reachedState];
+    result->switchCount = switchCount;
+    return 0;
+}
+
+// 多方式最短路径查询
+int multiModalSearch(SearchWorkspace* ws, Graph* graph, int start, int end, const MultiModalOptions* options,
+                     const PathBuffer* buffer, MultiModalResult* result) {
+    if (!ws || !graph || !options || !result || !isValidNodeId(start, graph->nodeCount) ||
+        !isValidNodeId(end, graph->nodeCount) || !graph->isFrozen ||
+        options->switchPenalty < 0 || options->switchPenalty >= INF / 2 ||
+        !(options->startModes & MODE_MASK_ALL) || !(options->endModes & MODE_MASK_ALL)) {
+        return -1;
+    }
+    
+    // 标签按状态编号存放：先把容量扩展到节点数×MODE_COUNT，beginSearch再按代数戳整体重置
+    if (reserveSearchWorkspace(ws, graph->nodeCount * MODE_COUNT) != 0 || beginSearch(ws, graph) != 0) return -1;
+    
+    int reachedState = runMultiModal(ws, graph, start, end, options);
+    return writeMultiModalResult(ws, graph, reachedState, buffer, result);
+}
+
+// 输出多方式路径
+void printMultiModalPath(Graph* graph, const MultiModalResult* result) {
+    if (!graph || !result || !result->route.isValid) {
+        printf("无效路径或路径不存在！\n");
+        return;
+    }
+    
+    const PathResult* route = &result->route;
+    printf("\n=== 多方式路径信息 ===\n");
+    
+    for (int i = 0; i < route->pathLength - 1; i++) {
+        int first = i;
+        int distance = 0;
+        int time = 0;
+        int last = i;
+        // 合并连续使用同一方式的边
+        while (1) {
+            int edgeId = route->edges ? route->edges[last] : findEdge(graph, route->path[last], route->path[last + 1]);
+            if (edgeId != -1) {
+                distance += graph->edges[edgeId].distance;
+                time += graph->edges[edgeId].timeCost;
+            }
+            if (last + 1 >= route->pathLength - 1 || result->edgeModes[last + 1] != result->edgeModes[i]) break;
+            last++;
+        }
+        
+        printf("%s: ", modeName(result->edgeModes[i]));
+        for (int k = first; k <= last + 1; k++) {
+            printf("%s", graph->nodes[route->path[k]].name);
+            if (k <= last) printf(" → ");
+        }
+        printf(" (%d 米, %d 秒)\n", distance, time);
+        
+        i = last;
+    }
+    
+    printf("总距离: %d 米\n", route->totalDistance);
+    printf("预计时间: %d 秒 (%.1f 分钟)\n", route->totalTime, route->totalTime / 60.0);
+    printf("换乘次数: %d, 总代价: %d\n", result->switchCount, result->totalCost);
+}
@@ -2,13 +2,16 @@
 #include "../include/utils.h"
 #include <math.h>
 
+#define PQ_INITIAL_CAPACITY 16
+
 // 创建优先队列
 PriorityQueue* createPriorityQueue() {
     PriorityQueue* pq = (PriorityQueue*)safeMalloc(sizeof(PriorityQueue));
     if (!pq) return NULL;
     
-    pq->head = NULL;
+    pq->items = (PriorityQueueNode*)safeMalloc(PQ_INITIAL_CAPACITY * sizeof(PriorityQueueNode));
     pq->size = 0;
+    pq->capacity = PQ_INITIAL_CAPACITY;
     return pq;
 }
 
@@ -16,49 +19,50 @@ PriorityQueue* createPriorityQueue() {
 void destroyPriorityQueue(PriorityQueue* pq) {
     if (!pq) return;
     
-    while (pq->head) {
-        PriorityQueueNode* temp = pq->head;
-        pq->head = pq->head->next;
-        free(temp);
-    }
+    free(pq->items);
     free(pq);
 }
 
-// 入队（按距离排序）
+// 入队（按距离上浮）
 void enqueue(PriorityQueue* pq, int nodeId, int distance) {
     if (!pq) return;
     
-    PriorityQueueNode* newNode = (PriorityQueueNode*)safeMalloc(sizeof(PriorityQueueNode));
-    if (!newNode) return;
-    
-    newNode->nodeId = nodeId;
-    newNode->distance = distance;
-    newNode->next = NULL;
+    if (pq->size == pq->capacity) {
+        pq->capacity *= 2;
+        pq->items = (PriorityQueueNode*)safeRealloc(pq->items, pq->capacity * sizeof(PriorityQueueNode));
+    }
     
-    // 按距离插入到正确位置
-    if (!pq->head || distance < pq->head->distance) {
-        newNode->next = pq->head;
-        pq->head = newNode;
-    } else {
-        PriorityQueueNode* current = pq->head;
-        while (current->next && current->next->distance <= distance) {
-            current = current->next;
-        }
-        newNode->next = current->next;
-        current->next = newNode;
+    int index = pq->size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (pq->items[parent].distance <= distance) break;
+        pq->items[index] = pq->items[parent];
+        index = parent;
     }
-    pq->size++;
+    pq->items[index].nodeId = nodeId;
+    pq->items[index].distance = distance;
 }
 
 // 出队
 int dequeue(PriorityQueue* pq) {
-    if (!pq || !pq->head) return -1;
-    
-    PriorityQueueNode* temp = pq->head;
-    int nodeId = temp->nodeId;
-    pq->head = pq->head->next;
-    free(temp);
-    pq->size--;
+    if (!pq || pq->size == 0) return -1;
+    
+    int nodeId = pq->items[0].nodeId;
+    PriorityQueueNode last = pq->items[--pq->size];
+    
+    // 将末尾元素从堆顶下沉
+    int index = 0;
+    while (1) {
+        int child = index * 2 + 1;
+        if (child >= pq->size) break;
+        if (child + 1 < pq->size && pq->items[child + 1].distance < pq->items[child].distance) {
+            child++;
+        }
+        if (pq->items[child].distance >= last.distance) break;
+        pq->items[index] = pq->items[child];
+        index = child;
+    }
+    pq->items[index] = last;
     
     return nodeId;
 }
@@ -68,150 +72,384 @@ int isEmpty(PriorityQueue* pq) {
     return !pq || pq->size == 0;
 }
 
-// Dijkstra算法实现
-PathResult* dijkstra(Graph* graph, int start, int end, TransportMode mode) {
-    if (!graph || !isValidNodeId(start, graph->nodeCount) || 
-        !isValidNodeId(end, graph->nodeCount)) {
+// ==================== 搜索工作区 ====================
+
+// 初始化一个方向的标签（数组由growLabels分配）
+static int initLabels(SearchLabels* labels) {
+    labels->generation = 0;
+    labels->dist = NULL;
+    labels->prevEdge = NULL;
+    labels->reached = NULL;
+    labels->settled = NULL;
+    labels->heap = createIndexedHeap(1);
+    return labels->heap ? 0 : -1;
+}
+
+// 释放一个方向的标签
+static void freeLabels(SearchLabels* labels) {
+    free(labels->dist);
+    free(labels->prevEdge);
+    free(labels->reached);
+    free(labels->settled);
+    destroyIndexedHeap(labels->heap);
+    labels->heap = NULL;
+}
+
+// 将标签数组从oldCapacity扩展到capacity（新增部分标记为未访问）
+static int growLabels(SearchLabels* labels, int oldCapacity, int capacity) {
+    size_t n = (size_t)capacity;
+    labels->dist = (int*)safeRealloc(labels->dist, n * sizeof(int));
+    labels->prevEdge = (int*)safeRealloc(labels->prevEdge, n * sizeof(int));
+    labels->reached = (unsigned int*)safeRealloc(labels->reached, n * sizeof(unsigned int));
+    labels->settled = (unsigned int*)safeRealloc(labels->settled, n * sizeof(unsigned int));
+    
+    // 代数从1开始递增，0永远不等于当前代数
+    memset(labels->reached + oldCapacity, 0, (n - oldCapacity) * sizeof(unsigned int));
+    memset(labels->settled + oldCapacity, 0, (n - oldCapacity) * sizeof(unsigned int));
+    
+    return reserveIndexedHeap(labels->heap, capacity);
+}
+
+// 递增代数使该方向的所有标签在O(1)内失效
+static void resetLabels(SearchLabels* labels, int capacity) {
+    labels->generation++;
+    if (labels->generation == 0) {
+        // 代数回绕时整体清零一次
+        memset(labels->reached, 0, (size_t)capacity * sizeof(unsigned int));
+        memset(labels->settled, 0, (size_t)capacity * sizeof(unsigned int));
+        labels->generation = 1;
+    }
+    clearIndexedHeap(labels->heap);
+}
+
+// 创建搜索工作区（nodeCapacity为预计的节点数，不足时自动扩展）
+SearchWorkspace* createSearchWorkspace(int nodeCapacity) {
+    SearchWorkspace* ws = (SearchWorkspace*)safeMalloc(sizeof(SearchWorkspace));
+    if (!ws) return NULL;
+    
+    ws->capacity = 0;
+    int ok = initLabels(&ws->forward) == 0;
+    ws->backward.heap = NULL;   // 反向标签在首次双向查询时分配
+    ws->radix = createRadixHeap();
+    ws->pathBuffer = NULL;
+    ws->edgeBuffer = NULL;
+    ws->bufferCapacity = 0;
+    ws->stats = NULL;
+    ws->statsStartTime = 0.0;
+    
+    if (!ok || !ws->radix || reserveSearchWorkspace(ws, nodeCapacity) != 0) {
+        destroySearchWorkspace(ws);
         return NULL;
     }
+    return ws;
+}
+
+// 销毁搜索工作区
+void destroySearchWorkspace(SearchWorkspace* ws) {
+    if (!ws) return;
+    
+    if (ws->forward.heap) freeLabels(&ws->forward);
+    if (ws->backward.heap) freeLabels(&ws->backward);
+    destroyRadixHeap(ws->radix);
+    free(ws->pathBuffer);
+    free(ws->edgeBuffer);
+    free(ws);
+}
+
+// 扩展工作区的节点容量（新增部分标记为未访问）
+int reserveSearchWorkspace(SearchWorkspace* ws, int nodeCapacity) {
+    if (!ws || nodeCapacity < 0) return -1;
+    if (nodeCapacity <= ws->capacity) return 0;
     
-    // 初始化距离数组和前驱数组
-    int* dist = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    int* prev = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    int* visited = (int*)safeMalloc(graph->nodeCount * sizeof(int));
+    if (growLabels(&ws->forward, ws->capacity, nodeCapacity) != 0) return -1;
+    if (ws->backward.heap && growLabels(&ws->backward, ws->capacity, nodeCapacity) != 0) return -1;
     
-    if (!dist || !prev || !visited) {
-        free(dist);
-        free(prev);
-        free(visited);
-        return NULL;
+    ws->capacity = nodeCapacity;
+    return 0;
+}
+
+// 指定工作区的统计结构（NULL表示不统计；未以ENABLE_SEARCH_STATS编译时统计结构始终为零）
+void setSearchStats(SearchWorkspace* ws, SearchStats* stats) {
+    if (!ws) return;
+    
+    ws->stats = stats;
+    if (stats) memset(stats, 0, sizeof(SearchStats));
+}
+
+// 开始新的单向查询
+int beginSearch(SearchWorkspace* ws, const Graph* graph) {
+    if (reserveSearchWorkspace(ws, graph->nodeCount) != 0) return -1;
+    
+    resetLabels(&ws->forward, ws->capacity);
+    clearRadixHeap(ws->radix);
+#ifdef ENABLE_SEARCH_STATS
+    if (ws->stats) {
+        memset(ws->stats, 0, sizeof(SearchStats));
+        ws->statsStartTime = getTimeSeconds();
+    }
+#endif
+    return 0;
+}
+
+// 开始新的双向查询（首次调用时分配反向标签），供双向搜索和CH查询使用
+int beginBidirectionalSearch(SearchWorkspace* ws, const Graph* graph) {
+    if (beginSearch(ws, graph) != 0) return -1;
+    
+    if (!ws->backward.heap) {
+        if (initLabels(&ws->backward) != 0 ||
+            growLabels(&ws->backward, 0, ws->capacity) != 0) {
+            return -1;
+        }
+    }
+    resetLabels(&ws->backward, ws->capacity);
+    return 0;
+}
+
+// 优先队列操作：索引堆走decrease-key；基数堆允许重复入队，过期元素出队时按settled丢弃
+static inline int isSearchQueueEmpty(const SearchWorkspace* ws, QueueType type) {
+    return type == QUEUE_RADIX_HEAP ? isRadixHeapEmpty(ws->radix) : isIndexedHeapEmpty(ws->forward.heap);
+}
+
+static inline void searchQueuePush(SearchWorkspace* ws, QueueType type, int id, int key) {
+    if (type == QUEUE_RADIX_HEAP) {
+        radixHeapPush(ws->radix, id, key);
+        SEARCH_STAT_PUSH(ws, ws->radix->size);
+    } else {
+        indexedHeapPush(ws->forward.heap, id, key);
+        SEARCH_STAT_PUSH(ws, ws->forward.heap->size);
+    }
+}
+
+static inline int searchQueuePop(SearchWorkspace* ws, QueueType type) {
+    return type == QUEUE_RADIX_HEAP ? radixHeapPop(ws->radix, NULL) : indexedHeapPop(ws->forward.heap, NULL);
+}
+
+// 取得长度为pathLength的路径存储：buffer不为NULL时使用调用方缓冲区，否则使用（必要时扩展）工作区自带缓冲区
+// 返回0表示成功，-2表示调用方缓冲区不足
+int reservePathStorage(SearchWorkspace* ws, const PathBuffer* buffer, int pathLength, int** path, int** edges) {
+    if (buffer) {
+        if (buffer->capacity < pathLength) return -2;
+        *path = buffer->path;
+        *edges = buffer->edges;
+        return 0;
     }
     
-    // 初始化
-    for (int i = 0; i < graph->nodeCount; i++) {
-        dist[i] = INF;
-        prev[i] = -1;
-        visited[i] = 0;
+    if (ws->bufferCapacity < pathLength) {
+        int capacity = maxInt(pathLength, ws->bufferCapacity * 2);
+        ws->pathBuffer = (int*)safeRealloc(ws->pathBuffer, (size_t)capacity * sizeof(int));
+        ws->edgeBuffer = (int*)safeRealloc(ws->edgeBuffer, (size_t)capacity * sizeof(int));
+        ws->bufferCapacity = capacity;
+    }
+    *path = ws->pathBuffer;
+    *edges = ws->edgeBuffer;
+    return 0;
+}
+
+// 将搜索结果写入result：路径存入buffer（为NULL时使用工作区自带缓冲区）
+// meet为路径经过的汇合节点：单向搜索传终点；双向搜索传两侧相遇的节点（-1表示无路径），
+// 此时meet之后的部分沿反向标签的后继边走到终点。
+// 返回0表示成功，-2表示调用方缓冲区不足（result->pathLength为所需长度）
+static int writeSearchResult(SearchWorkspace* ws, Graph* graph, int meet, int bidirectional,
+                             const PathBuffer* buffer, PathResult* result) {
+    result->path = NULL;
+    result->edges = NULL;
+    result->pathLength = 0;
+    result->totalDistance = 0;
+    result->totalTime = 0;
+    result->isValid = 0;
+    
+    if (meet < 0 || labelDist(&ws->forward, meet) == INF) return 0;  // 无路径
+    
+    const int* prevEdge = ws->forward.prevEdge;
+    const int* nextEdge = bidirectional ? ws->backward.prevEdge : NULL;
+    
+    // 回溯计算路径长度：起点到meet的节点数，加上meet之后到终点的节点数
+    int forwardLength = 1;
+    for (int v = meet; prevEdge[v] != -1; v = graph->edges[prevEdge[v]].from) {
+        forwardLength++;
+    }
+    int pathLength = forwardLength;
+    if (nextEdge) {
+        for (int v = meet; nextEdge[v] != -1; v = graph->edges[nextEdge[v]].to) {
+            pathLength++;
+        }
     }
-    dist[start] = 0;
     
-    // 创建优先队列
-    PriorityQueue* pq = createPriorityQueue();
-    if (!pq) {
-        free(dist);
-        free(prev);
-        free(visited);
-        return NULL;
+    int* path;
+    int* edges;
+    if (reservePathStorage(ws, buffer, pathLength, &path, &edges) != 0) {
+        result->pathLength = pathLength;
+        return -2;
     }
     
-    enqueue(pq, start, 0);
+    // 填充起点到meet的部分（逆序），同时累加总距离和时间
+    int v = meet;
+    for (int i = forwardLength - 1; i > 0; i--) {
+        int edgeId = prevEdge[v];
+        Edge* edge = &graph->edges[edgeId];
+        path[i] = v;
+        if (edges) edges[i - 1] = edgeId;
+        result->totalDistance += edge->distance;
+        result->totalTime += edge->timeCost;
+        v = edge->from;
+    }
+    path[0] = v;
+    
+    // 填充meet到终点的部分（正序）
+    v = meet;
+    for (int i = forwardLength; i < pathLength; i++) {
+        int edgeId = nextEdge[v];
+        Edge* edge = &graph->edges[edgeId];
+        if (edges) edges[i - 1] = edgeId;
+        result->totalDistance += edge->distance;
+        result->totalTime += edge->timeCost;
+        v = edge->to;
+        path[i] = v;
+    }
+    
+    result->path = path;
+    result->edges = edges;
+    result->pathLength = pathLength;
+    result->isValid = 1;
+    return 0;
+}
+
+// 将工作区中的结果复制为独立分配的PathResult（供一次性查询接口返回）
+PathResult* copyPathResult(const PathResult* source) {
+    PathResult* result = (PathResult*)safeMalloc(sizeof(PathResult));
+    if (!result) return NULL;
+    
+    *result = *source;
+    result->path = NULL;
+    result->edges = NULL;
+    
+    if (source->isValid) {
+        result->path = (int*)safeMalloc((size_t)source->pathLength * sizeof(int));
+        result->edges = (int*)safeMalloc((size_t)maxInt(source->pathLength - 1, 1) * sizeof(int));
+        memcpy(result->path, source->path, (size_t)source->pathLength * sizeof(int));
+        memcpy(result->edges, source->edges, (size_t)(source->pathLength - 1) * sizeof(int));
+    }
+    return result;
+}
+
+// ==================== Dijkstra算法实现 ====================
+
+// Dijkstra算法核心（useCSR为真时按CSR顺序扫描邻居）
+static int runDijkstra(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                       QueueType queue, int useCSR) {
+    if (!ws || !graph || !isValidNodeId(start, graph->nodeCount) || 
+        !isValidNodeId(end, graph->nodeCount)) {
+        return -1;
+    }
+    if (beginSearch(ws, graph) != 0) return -1;
+    
+    SearchLabels* labels = &ws->forward;
+    setLabel(labels, start, 0, -1);
+    searchQueuePush(ws, queue, start, 0);
     
     // 主循环
-    while (!isEmpty(pq)) {
-        int current = dequeue(pq);
+    while (!isSearchQueueEmpty(ws, queue)) {
+        int current = searchQueuePop(ws, queue);
         
-        if (visited[current] || !graph->nodes[current].isActive) continue;
-        visited[current] = 1;
+        if (isSettled(labels, current) || !graph->nodes[current].isActive) {
+            SEARCH_STAT_ADD(ws, stalePops, 1);
+            continue;
+        }
+        markSettled(labels, current);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
         
         if (current == end) break;  // 找到目标节点
         
+        int currentDist = labels->dist[current];
+        
+        if (useCSR) {
+            // 顺序扫描连续的目标和权重数组
+            const int* targets = graph->csrTargets;
+            const int* weights = graph->csrWeights[mode];
+            int last = graph->csrOffsets[current + 1];
+            SEARCH_STAT_ADD(ws, relaxedEdges, last - graph->csrOffsets[current]);
+            
+            for (int i = graph->csrOffsets[current]; i < last; i++) {
+                int neighbor = targets[i];
+                int weight = weights[i];
+                
+                if (weight == INF || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) continue;
+                
+                int newDist = currentDist + weight;
+                if (newDist < labelDist(labels, neighbor)) {
+                    setLabel(labels, neighbor, newDist, graph->csrEdgeIds[i]);
+                    searchQueuePush(ws, queue, neighbor, newDist);
+                }
+            }
+            continue;
+        }
+        
         // 遍历邻接节点
-        AdjListNode* adjNode = graph->adjList[current];
-        while (adjNode) {
-            int neighbor = adjNode->dest;
-            Edge* edge = &graph->edges[adjNode->edgeIndex];
+        for (int e = graph->adjHead[current]; e != -1; e = graph->adjNext[e]) {
+            Edge* edge = &graph->edges[e];
+            int neighbor = edge->to;
+            SEARCH_STAT_ADD(ws, relaxedEdges, 1);
             
             // 检查边和节点是否可访问
-            if (!edge->isAccessible || !graph->nodes[neighbor].isActive) {
-                adjNode = adjNode->next;
+            if (!edge->isAccessible || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) {
                 continue;
             }
             
-            int weight = edge->modeWeight[mode];
-            int newDist = dist[current] + weight;
-            
-            if (newDist < dist[neighbor]) {
-                dist[neighbor] = newDist;
-                prev[neighbor] = current;
-                enqueue(pq, neighbor, newDist);
+            int newDist = currentDist + edge->modeWeight[mode];
+            if (newDist < labelDist(labels, neighbor)) {
+                setLabel(labels, neighbor, newDist, e);
+                searchQueuePush(ws, queue, neighbor, newDist);
             }
-            
-            adjNode = adjNode->next;
         }
     }
     
-    // 构建路径结果
-    PathResult* result = (PathResult*)safeMalloc(sizeof(PathResult));
-    if (!result) {
-        destroyPriorityQueue(pq);
-        free(dist);
-        free(prev);
-        free(visited);
-        return NULL;
-    }
-    
-    if (dist[end] == INF) {
-        // 无路径
-        result->path = NULL;
-        result->pathLength = 0;
-        result->totalDistance = 0;
-        result->totalTime = 0;
-        result->isValid = 0;
-    } else {
-        // 回溯构建路径
-        int pathLength = 0;
-        int temp = end;
-        while (temp != -1) {
-            pathLength++;
-            temp = prev[temp];
-        }
-        
-        result->path = (int*)safeMalloc(pathLength * sizeof(int));
-        if (!result->path) {
-            free(result);
-            destroyPriorityQueue(pq);
-            free(dist);
-            free(prev);
-            free(visited);
-            return NULL;
-        }
-        
-        result->pathLength = pathLength;
-        result->totalDistance = 0;
-        result->totalTime = 0;
-        result->isValid = 1;
-        
-        // 填充路径数组（逆序）
-        temp = end;
-        for (int i = pathLength - 1; i >= 0; i--) {
-            result->path[i] = temp;
-            temp = prev[temp];
-        }
-        
-        // 计算总距离和时间
-        for (int i = 0; i < pathLength - 1; i++) {
-            int from = result->path[i];
-            int to = result->path[i + 1];
-            
-            // 找到对应的边
-            for (int j = 0; j < graph->edgeCount; j++) {
-                if (graph->edges[j].from == from && graph->edges[j].to == to) {
-                    result->totalDistance += graph->edges[j].distance;
-                    result->totalTime += graph->edges[j].timeCost;
-                    break;
-                }
-            }
-        }
+    SEARCH_STAT_FINISH(ws);
+    return 0;
+}
+
+// 在工作区上运行Dijkstra（图已冻结时使用CSR结构）
+// 返回0表示完成搜索（result->isValid指示是否可达），-1表示参数错误，-2表示缓冲区不足
+int dijkstraSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                   QueueType queue, const PathBuffer* buffer, PathResult* result) {
+    if (!result) return -1;
+    if (runDijkstra(ws, graph, start, end, mode, queue, graph && graph->isFrozen) != 0) return -1;
+    return writeSearchResult(ws, graph, end, 0, buffer, result);
+}
+
+// 使用临时工作区运行Dijkstra并返回独立分配的结果
+static PathResult* dijkstraOnce(Graph* graph, int start, int end, TransportMode mode, QueueType queue, int useCSR) {
+    if (!graph) return NULL;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    if (!ws) return NULL;
+    
+    PathResult* result = NULL;
+    PathResult local;
+    if (runDijkstra(ws, graph, start, end, mode, queue, useCSR) == 0 &&
+        writeSearchResult(ws, graph, end, 0, NULL, &local) == 0) {
+        result = copyPathResult(&local);
     }
     
-    destroyPriorityQueue(pq);
-    free(dist);
-    free(prev);
-    free(visited);
-    
+    destroySearchWorkspace(ws);
     return result;
 }
 
+// Dijkstra算法（遍历邻接表）
+PathResult* dijkstra(Graph* graph, int start, int end, TransportMode mode) {
+    return dijkstraOnce(graph, start, end, mode, QUEUE_DARY_HEAP, 0);
+}
+
+// Dijkstra算法（遍历冻结后的CSR结构；图未冻结时退回邻接表）
+PathResult* dijkstraCSR(Graph* graph, int start, int end, TransportMode mode) {
+    return dijkstraOnce(graph, start, end, mode, QUEUE_DARY_HEAP, graph && graph->isFrozen);
+}
+
+// 按指定队列类型运行Dijkstra（图已冻结时使用CSR结构）
+// 基数堆要求边权非负，适合modeWeight为小整数的场景
+PathResult* dijkstraWithQueue(Graph* graph, int start, int end, TransportMode mode, QueueType queue) {
+    return dijkstraOnce(graph, start, end, mode, queue, graph && graph->isFrozen);
+}
+
 // 根据名称查找路径
 PathResult* findPathByName(Graph* graph, const char* startName, const char* endName, TransportMode mode) {
     if (!graph || !isValidString(startName) || !isValidString(endName)) {
@@ -225,16 +463,15 @@ PathResult* findPathByName(Graph* graph, const char* startName, const char* endN
         return NULL;
     }
     
-    return dijkstra(graph, startId, endId, mode);
+    return dijkstraCSR(graph, startId, endId, mode);
 }
 
 // 释放路径结果
 void freePathResult(PathResult* result) {
     if (!result) return;
     
-    if (result->path) {
-        free(result->path);
-    }
+    free(result->path);
+    free(result->edges);
     free(result);
 }
 
@@ -273,18 +510,17 @@ void printPathDetails(Graph* graph, PathResult* result, TransportMode mode) {
         int from = result->path[i];
         int to = result->path[i + 1];
         
-        // 找到对应的边
-        for (int j = 0; j < graph->edgeCount; j++) {
-            if (graph->edges[j].from == from && graph->edges[j].to == to) {
-                printf("第%d段: %s → %s\n", i + 1, 
-                       graph->nodes[from].name, graph->nodes[to].name);
-                printf("  距离: %d 米\n", graph->edges[j].distance);
-                printf("  时间: %d 秒\n", graph->edges[j].timeCost);
-                printf("  权重: %d\n", graph->edges[j].modeWeight[mode]);
-                printf("\n");
-                break;
-            }
-        }
+        // 优先使用搜索记录的边，否则按节点对查找
+        int edgeId = result->edges ? result->edges[i] : findEdge(graph, from, to);
+        if (edgeId == -1) continue;
+        
+        Edge* edge = &graph->edges[edgeId];
+        printf("第%d段: %s → %s\n", i + 1, 
+               graph->nodes[from].name, graph->nodes[to].name);
+        printf("  距离: %d 米\n", edge->distance);
+        printf("  时间: %d 秒\n", edge->timeCost);
+        printf("  权重: %d\n", edge->modeWeight[mode]);
+        printf("\n");
     }
     
     printf("总计: %d 米, %d 秒\n", result->totalDistance, result->totalTime);
@@ -297,8 +533,9 @@ AStarPriorityQueue* createAStarPriorityQueue() {
     AStarPriorityQueue* pq = (AStarPriorityQueue*)safeMalloc(sizeof(AStarPriorityQueue));
     if (!pq) return NULL;
     
-    pq->head = NULL;
+    pq->items = (AStarQueueNode*)safeMalloc(PQ_INITIAL_CAPACITY * sizeof(AStarQueueNode));
     pq->size = 0;
+    pq->capacity = PQ_INITIAL_CAPACITY;
     return pq;
 }
 
@@ -306,53 +543,60 @@ AStarPriorityQueue* createAStarPriorityQueue() {
 void destroyAStarPriorityQueue(AStarPriorityQueue* pq) {
     if (!pq) return;
     
-    while (pq->head) {
-        AStarQueueNode* temp = pq->head;
-        pq->head = pq->head->next;
-        free(temp);
-    }
+    free(pq->items);
     free(pq);
 }
 
-// A*优先队列入队（按fCost排序）
+// 比较两个A*队列元素：fCost小者优先，fCost相同时hCost小者优先
+static int astarLess(const AStarQueueNode* a, const AStarQueueNode* b) {
+    return a->fCost < b->fCost || (a->fCost == b->fCost && a->hCost < b->hCost);
+}
+
+// A*优先队列入队（按fCost上浮）
 void astarEnqueue(AStarPriorityQueue* pq, int nodeId, int gCost, int hCost) {
     if (!pq) return;
     
-    AStarQueueNode* newNode = (AStarQueueNode*)safeMalloc(sizeof(AStarQueueNode));
-    if (!newNode) return;
-    
-    newNode->nodeId = nodeId;
-    newNode->gCost = gCost;
-    newNode->hCost = hCost;
-    newNode->fCost = gCost + hCost;
-    newNode->next = NULL;
+    if (pq->size == pq->capacity) {
+        pq->capacity *= 2;
+        pq->items = (AStarQueueNode*)safeRealloc(pq->items, pq->capacity * sizeof(AStarQueueNode));
+    }
     
-    // 按fCost插入到正确位置，fCost相同时按hCost排序
-    if (!pq->head || newNode->fCost < pq->head->fCost || 
-        (newNode->fCost == pq->head->fCost && newNode->hCost < pq->head->hCost)) {
-        newNode->next = pq->head;
-        pq->head = newNode;
-    } else {
-        AStarQueueNode* current = pq->head;
-        while (current->next && (current->next->fCost < newNode->fCost ||
-               (current->next->fCost == newNode->fCost && current->next->hCost <= newNode->hCost))) {
-            current = current->next;
-        }
-        newNode->next = current->next;
-        current->next = newNode;
+    AStarQueueNode newNode;
+    newNode.nodeId = nodeId;
+    newNode.gCost = gCost;
+    newNode.hCost = hCost;
+    newNode.fCost = gCost + hCost;
+    
+    int index = pq->size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!astarLess(&newNode, &pq->items[parent])) break;
+        pq->items[index] = pq->items[parent];
+        index = parent;
     }
-    pq->size++;
+    pq->items[index] = newNode;
 }
 
 // A*优先队列出队
 int astarDequeue(AStarPriorityQueue* pq) {
-    if (!pq || !pq->head) return -1;
-    
-    AStarQueueNode* temp = pq->head;
-    int nodeId = temp->nodeId;
-    pq->head = pq->head->next;
-    free(temp);
-    pq->size--;
+    if (!pq || pq->size == 0) return -1;
+    
+    int nodeId = pq->items[0].nodeId;
+    AStarQueueNode last = pq->items[--pq->size];
+    
+    // 将末尾元素从堆顶下沉
+    int index = 0;
+    while (1) {
+        int child = index * 2 + 1;
+        if (child >= pq->size) break;
+        if (child + 1 < pq->size && astarLess(&pq->items[child + 1], &pq->items[child])) {
+            child++;
+        }
+        if (!astarLess(&pq->items[child], &last)) break;
+        pq->items[index] = pq->items[child];
+        index = child;
+    }
+    pq->items[index] = last;
     
     return nodeId;
 }
@@ -387,165 +631,338 @@ int calculateHeuristic(Graph* graph, int from, int to) {
     return (int)distance;
 }
 
-// A*算法实现
-PathResult* astar(Graph* graph, int start, int end, TransportMode mode) {
-    if (!graph || !isValidNodeId(start, graph->nodeCount) || 
+// 两点间最短路径代价的下界：直线距离乘以该交通方式的weightPerMeter（与modeWeight同单位）。
+// 每条边的权重不小于其直线距离乘以该比值，由三角不等式，向下取整后仍满足一致性。
+// 不直接用以米为单位的calculateHeuristic：权重小于直线距离时它会高估，A*因此错过最短路径
+static inline int weightLowerBound(Graph* graph, TransportMode mode, int from, int to) {
+    if (graph->weightPerMeter[mode] <= 0.0) return 0;
+    double bound = graph->weightPerMeter[mode] * straightLineDistance(graph, from, to);
+    return bound < INF / 4 ? (int)bound : INF / 4;
+}
+
+// 启发式估计：提供地标时使用ALT下界，否则使用坐标直线距离换算的下界（两者都与modeWeight同单位，且满足一致性）
+static inline int estimateDistance(Graph* graph, const LandmarkSet* landmarks, TransportMode mode, int from, int to) {
+    return landmarks ? landmarkLowerBound(landmarks, mode, from, to) : weightLowerBound(graph, mode, from, to);
+}
+
+// A*算法核心（useCSR为真时按CSR顺序扫描邻居，landmarks可为NULL）
+static int runAStar(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                    const LandmarkSet* landmarks, int useCSR) {
+    if (!ws || !graph || !isValidNodeId(start, graph->nodeCount) || 
         !isValidNodeId(end, graph->nodeCount)) {
-        return NULL;
-    }
-    
-    // 初始化数组
-    int* gScore = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    int* fScore = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    int* prev = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    int* visited = (int*)safeMalloc(graph->nodeCount * sizeof(int));
-    
-    if (!gScore || !fScore || !prev || !visited) {
-        free(gScore);
-        free(fScore);
-        free(prev);
-        free(visited);
-        return NULL;
-    }
-    
-    // 初始化
-    for (int i = 0; i < graph->nodeCount; i++) {
-        gScore[i] = INF;
-        fScore[i] = INF;
-        prev[i] = -1;
-        visited[i] = 0;
-    }
-    
-    gScore[start] = 0;
-    fScore[start] = calculateHeuristic(graph, start, end);
-    
-    // 创建A*专用优先队列
-    AStarPriorityQueue* pq = createAStarPriorityQueue();
-    if (!pq) {
-        free(gScore);
-        free(fScore);
-        free(prev);
-        free(visited);
-        return NULL;
+        return -1;
     }
+    if (beginSearch(ws, graph) != 0) return -1;
     
-    astarEnqueue(pq, start, gScore[start], calculateHeuristic(graph, start, end));
+    // 工作区中的dist即gScore；fScore只作为堆的键值
+    SearchLabels* labels = &ws->forward;
+    setLabel(labels, start, 0, -1);
+    indexedHeapPush(labels->heap, start, estimateDistance(graph, landmarks, mode, start, end));
+    SEARCH_STAT_PUSH(ws, labels->heap->size);
     
     // A*主循环
-    while (!isAStarEmpty(pq)) {
-        int current = astarDequeue(pq);
+    while (!isIndexedHeapEmpty(labels->heap)) {
+        int current = indexedHeapPop(labels->heap, NULL);
         
-        if (visited[current] || !graph->nodes[current].isActive) continue;
-        visited[current] = 1;
+        if (isSettled(labels, current) || !graph->nodes[current].isActive) {
+            SEARCH_STAT_ADD(ws, stalePops, 1);
+            continue;
+        }
+        markSettled(labels, current);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
         
         if (current == end) break;  // 找到目标节点
         
+        int currentG = labels->dist[current];
+        
+        if (useCSR) {
+            // 顺序扫描连续的目标和权重数组
+            const int* targets = graph->csrTargets;
+            const int* weights = graph->csrWeights[mode];
+            int last = graph->csrOffsets[current + 1];
+            SEARCH_STAT_ADD(ws, relaxedEdges, last - graph->csrOffsets[current]);
+            
+            for (int i = graph->csrOffsets[current]; i < last; i++) {
+                int neighbor = targets[i];
+                int weight = weights[i];
+                
+                if (weight == INF || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) continue;
+                
+                int tentativeGScore = currentG + weight;
+                if (tentativeGScore < labelDist(labels, neighbor)) {
+                    setLabel(labels, neighbor, tentativeGScore, graph->csrEdgeIds[i]);
+                    indexedHeapPush(labels->heap, neighbor, tentativeGScore + estimateDistance(graph, landmarks, mode, neighbor, end));
+                    SEARCH_STAT_PUSH(ws, labels->heap->size);
+                }
+            }
+            continue;
+        }
+        
         // 遍历邻接节点
-        AdjListNode* adjNode = graph->adjList[current];
-        while (adjNode) {
-            int neighbor = adjNode->dest;
-            Edge* edge = &graph->edges[adjNode->edgeIndex];
+        for (int e = graph->adjHead[current]; e != -1; e = graph->adjNext[e]) {
+            Edge* edge = &graph->edges[e];
+            int neighbor = edge->to;
+            SEARCH_STAT_ADD(ws, relaxedEdges, 1);
             
             // 检查边和节点是否可访问
-            if (!edge->isAccessible || !graph->nodes[neighbor].isActive || visited[neighbor]) {
-                adjNode = adjNode->next;
+            if (!edge->isAccessible || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) {
                 continue;
             }
             
-            int weight = edge->modeWeight[mode];
-            int tentativeGScore = gScore[current] + weight;
-            
-            if (tentativeGScore < gScore[neighbor]) {
+            int tentativeGScore = currentG + edge->modeWeight[mode];
+            if (tentativeGScore < labelDist(labels, neighbor)) {
                 // 找到更好的路径
-                prev[neighbor] = current;
-                gScore[neighbor] = tentativeGScore;
-                int hCost = calculateHeuristic(graph, neighbor, end);
-                fScore[neighbor] = gScore[neighbor] + hCost;
-                
-                astarEnqueue(pq, neighbor, gScore[neighbor], hCost);
+                setLabel(labels, neighbor, tentativeGScore, e);
+                indexedHeapPush(labels->heap, neighbor, tentativeGScore + estimateDistance(graph, landmarks, mode, neighbor, end));
+                SEARCH_STAT_PUSH(ws, labels->heap->size);
             }
-            
-            adjNode = adjNode->next;
         }
     }
     
-    // 构建路径结果
-    PathResult* result = (PathResult*)safeMalloc(sizeof(PathResult));
-    if (!result) {
-        destroyAStarPriorityQueue(pq);
-        free(gScore);
-        free(fScore);
-        free(prev);
-        free(visited);
+    SEARCH_STAT_FINISH(ws);
+    return 0;
+}
+
+// 在工作区上运行A*（图已冻结时使用CSR结构），返回值同dijkstraSearch
+int astarSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                const PathBuffer* buffer, PathResult* result) {
+    return astarSearchWithLandmarks(ws, graph, start, end, mode, NULL, buffer, result);
+}
+
+// 在工作区上运行使用ALT下界的A*（landmarks为NULL时使用直线距离换算的下界），返回值同dijkstraSearch
+int astarSearchWithLandmarks(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                             const LandmarkSet* landmarks, const PathBuffer* buffer, PathResult* result) {
+    if (!result) return -1;
+    if (runAStar(ws, graph, start, end, mode, landmarks, graph && graph->isFrozen) != 0) return -1;
+    return writeSearchResult(ws, graph, end, 0, buffer, result);
+}
+
+// 使用临时工作区运行A*并返回独立分配的结果
+static PathResult* astarOnce(Graph* graph, int start, int end, TransportMode mode,
+                             const LandmarkSet* landmarks, int useCSR) {
+    if (!graph) return NULL;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    if (!ws) return NULL;
+    
+    PathResult* result = NULL;
+    PathResult local;
+    if (runAStar(ws, graph, start, end, mode, landmarks, useCSR) == 0 &&
+        writeSearchResult(ws, graph, end, 0, NULL, &local) == 0) {
+        result = copyPathResult(&local);
+    }
+    
+    destroySearchWorkspace(ws);
+    return result;
+}
+
+// A*算法（遍历邻接表）
+PathResult* astar(Graph* graph, int start, int end, TransportMode mode) {
+    return astarOnce(graph, start, end, mode, NULL, 0);
+}
+
+// A*算法（遍历冻结后的CSR结构；图未冻结时退回邻接表）
+PathResult* astarCSR(Graph* graph, int start, int end, TransportMode mode) {
+    return astarOnce(graph, start, end, mode, NULL, graph && graph->isFrozen);
+}
+
+// 使用ALT下界的A*（图已冻结时使用CSR结构）
+PathResult* astarWithLandmarks(Graph* graph, int start, int end, TransportMode mode, const LandmarkSet* landmarks) {
+    return astarOnce(graph, start, end, mode, landmarks, graph && graph->isFrozen);
+}
+
+// 根据名称使用A*算法查找路径
+PathResult* findPathByNameAStar(Graph* graph, const char* startName, const char* endName, TransportMode mode) {
+    if (!graph || !isValidString(startName) || !isValidString(endName)) {
+        return NULL;
+    }
+    
+    int startId = findNodeByName(graph, startName);
+    int endId = findNodeByName(graph, endName);
+    
+    if (startId == -1 || endId == -1) {
         return NULL;
     }
     
-    if (gScore[end] == INF) {
-        // 无路径
-        result->path = NULL;
-        result->pathLength = 0;
-        result->totalDistance = 0;
-        result->totalTime = 0;
-        result->isValid = 0;
+    return astarCSR(graph, startId, endId, mode);
+} 
+// ==================== 双向搜索 ====================
+
+// 双向搜索的势函数：p(v) = h(v, end) - h(start, v)，即正反两个启发式之差（平均势函数的2倍）。
+// 正向键值取 2*dF(v) + p(v)，反向键值取 2*dB(v) - p(v)，两侧使用同一组约化边权，
+// 因此可以沿用双向Dijkstra的停止条件。两个启发式都必须一致，否则约化边权可能为负，停止时mu还不是最短距离
+static inline int bidirectionalPotential(Graph* graph, TransportMode mode, int start, int end, int v) {
+    return weightLowerBound(graph, mode, v, end) - weightLowerBound(graph, mode, start, v);
+}
+
+// 双向搜索核心（要求图已冻结）：正向沿CSR出边、反向沿反向CSR入边交替扩展，
+// 每次松弛时若节点已被另一侧到达则更新最短路径上界mu。
+// 当两侧堆顶键值之和不小于mu（A*中为2*mu）时，任何未发现的路径都不会更短，搜索结束。
+// meet返回最短路径上两侧相遇的节点（-1表示无路径）
+static int runBidirectional(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                            int useHeuristic, int* meet) {
+    if (!ws || !graph || !graph->isFrozen || !isValidNodeId(start, graph->nodeCount) || 
+        !isValidNodeId(end, graph->nodeCount)) {
+        return -1;
+    }
+    if (beginBidirectionalSearch(ws, graph) != 0) return -1;
+    
+    SearchLabels* forward = &ws->forward;
+    SearchLabels* backward = &ws->backward;
+    int scale = useHeuristic ? 2 : 1;
+    
+    int mu = INF;
+    *meet = -1;
+    
+    setLabel(forward, start, 0, -1);
+    setLabel(backward, end, 0, -1);
+    if (start == end) {
+        mu = 0;
+        *meet = start;
     } else {
-        // 回溯构建路径
-        int pathLength = 0;
-        int temp = end;
-        while (temp != -1) {
-            pathLength++;
-            temp = prev[temp];
-        }
+        int potential = useHeuristic ? bidirectionalPotential(graph, mode, start, end, start) : 0;
+        indexedHeapPush(forward->heap, start, potential);
+        potential = useHeuristic ? bidirectionalPotential(graph, mode, start, end, end) : 0;
+        indexedHeapPush(backward->heap, end, -potential);
+        SEARCH_STAT_ADD(ws, queuePushes, 2);
+    }
+    
+    int expandForward = 1;
+    while (!isIndexedHeapEmpty(forward->heap) && !isIndexedHeapEmpty(backward->heap)) {
+        long long topSum = (long long)indexedHeapTopKey(forward->heap) + indexedHeapTopKey(backward->heap);
+        if (mu != INF && topSum >= (long long)scale * mu) break;
         
-        result->path = (int*)safeMalloc(pathLength * sizeof(int));
-        if (!result->path) {
-            free(result);
-            destroyAStarPriorityQueue(pq);
-            free(gScore);
-            free(fScore);
-            free(prev);
-            free(visited);
-            return NULL;
-        }
+        // 两个方向交替扩展
+        int isForward = expandForward;
+        expandForward = !expandForward;
         
-        result->pathLength = pathLength;
-        result->totalDistance = 0;
-        result->totalTime = 0;
-        result->isValid = 1;
+        SearchLabels* labels = isForward ? forward : backward;
+        SearchLabels* other = isForward ? backward : forward;
+        int current = indexedHeapPop(labels->heap, NULL);
         
-        // 填充路径数组（逆序）
-        temp = end;
-        for (int i = pathLength - 1; i >= 0; i--) {
-            result->path[i] = temp;
-            temp = prev[temp];
+        if (isSettled(labels, current) || !graph->nodes[current].isActive) {
+            SEARCH_STAT_ADD(ws, stalePops, 1);
+            continue;
         }
+        markSettled(labels, current);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
+        
+        const int* offsets = isForward ? graph->csrOffsets : graph->rcsrOffsets;
+        const int* neighbors = isForward ? graph->csrTargets : graph->rcsrSources;
+        const int* edgeIds = isForward ? graph->csrEdgeIds : graph->rcsrEdgeIds;
+        const int* weights = isForward ? graph->csrWeights[mode] : graph->rcsrWeights[mode];
+        int currentDist = labels->dist[current];
+        int last = offsets[current + 1];
+        SEARCH_STAT_ADD(ws, relaxedEdges, last - offsets[current]);
         
-        // 计算总距离和时间
-        for (int i = 0; i < pathLength - 1; i++) {
-            int from = result->path[i];
-            int to = result->path[i + 1];
+        for (int i = offsets[current]; i < last; i++) {
+            int neighbor = neighbors[i];
+            int weight = weights[i];
             
-            // 找到对应的边
-            for (int j = 0; j < graph->edgeCount; j++) {
-                if (graph->edges[j].from == from && graph->edges[j].to == to) {
-                    result->totalDistance += graph->edges[j].distance;
-                    result->totalTime += graph->edges[j].timeCost;
-                    break;
-                }
+            if (weight == INF || isSettled(labels, neighbor) || !graph->nodes[neighbor].isActive) continue;
+            
+            int newDist = currentDist + weight;
+            if (newDist >= labelDist(labels, neighbor)) continue;
+            
+            setLabel(labels, neighbor, newDist, edgeIds[i]);
+            
+            int key = newDist * scale;
+            if (useHeuristic) {
+                int potential = bidirectionalPotential(graph, mode, start, end, neighbor);
+                key += isForward ? potential : -potential;
+            }
+            indexedHeapPush(labels->heap, neighbor, key);
+            SEARCH_STAT_PUSH(ws, forward->heap->size + backward->heap->size);
+            
+            // 另一侧已到达该节点时，得到一条经过它的完整路径
+            int otherDist = labelDist(other, neighbor);
+            if (otherDist != INF && newDist + otherDist < mu) {
+                mu = newDist + otherDist;
+                *meet = neighbor;
             }
         }
     }
     
-    destroyAStarPriorityQueue(pq);
-    free(gScore);
-    free(fScore);
-    free(prev);
-    free(visited);
+    SEARCH_STAT_FINISH(ws);
+    return 0;
+}
+
+// 在工作区上运行双向Dijkstra（图未冻结时退回单向Dijkstra），返回值同dijkstraSearch
+int bidirectionalDijkstraSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                                const PathBuffer* buffer, PathResult* result) {
+    if (!result || !graph) return -1;
+    if (!graph->isFrozen) return dijkstraSearch(ws, graph, start, end, mode, QUEUE_DARY_HEAP, buffer, result);
+    
+    int meet;
+    if (runBidirectional(ws, graph, start, end, mode, 0, &meet) != 0) return -1;
+    return writeSearchResult(ws, graph, meet, 1, buffer, result);
+}
+
+// 在工作区上运行双向A*（图未冻结时退回单向A*），返回值同dijkstraSearch
+int bidirectionalAStarSearch(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+                             const PathBuffer* buffer, PathResult* result) {
+    if (!result || !graph) return -1;
+    if (!graph->isFrozen) return astarSearch(ws, graph, start, end, mode, buffer, result);
+    
+    int meet;
+    if (runBidirectional(ws, graph, start, end, mode, 1, &meet) != 0) return -1;
+    return writeSearchResult(ws, graph, meet, 1, buffer, result);
+}
+
+// 在工作区上按指定算法查找路径，返回值同dijkstraSearch
+int searchPath(SearchWorkspace* ws, Graph* graph, int start, int end, TransportMode mode,
+               PathAlgorithm algorithm, const PathBuffer* buffer, PathResult* result) {
+    switch (algorithm) {
+        case ALGO_DIJKSTRA:
+            return dijkstraSearch(ws, graph, start, end, mode, QUEUE_DARY_HEAP, buffer, result);
+        case ALGO_ASTAR:
+            return astarSearch(ws, graph, start, end, mode, buffer, result);
+        case ALGO_BIDIRECTIONAL_DIJKSTRA:
+            return bidirectionalDijkstraSearch(ws, graph, start, end, mode, buffer, result);
+        case ALGO_BIDIRECTIONAL_ASTAR:
+            return bidirectionalAStarSearch(ws, graph, start, end, mode, buffer, result);
+        default:
+            return -1;
+    }
+}
+
+// 使用临时工作区按指定算法查找路径，返回独立分配的结果
+PathResult* findPath(Graph* graph, int start, int end, TransportMode mode, PathAlgorithm algorithm) {
+    return findPathWithStats(graph, start, end, mode, algorithm, NULL);
+}
+
+// 同findPath，并把本次查询的工作量写入stats（可为NULL）
+PathResult* findPathWithStats(Graph* graph, int start, int end, TransportMode mode, PathAlgorithm algorithm,
+                              SearchStats* stats) {
+    if (!graph) return NULL;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    if (!ws) return NULL;
+    setSearchStats(ws, stats);
+    
+    PathResult* result = NULL;
+    PathResult local;
+    if (searchPath(ws, graph, start, end, mode, algorithm, NULL, &local) == 0) {
+        result = copyPathResult(&local);
+    }
     
+    destroySearchWorkspace(ws);
     return result;
 }
 
-// 根据名称使用A*算法查找路径
-PathResult* findPathByNameAStar(Graph* graph, const char* startName, const char* endName, TransportMode mode) {
+// 双向Dijkstra算法（图未冻结时退回单向Dijkstra）
+PathResult* bidirectionalDijkstra(Graph* graph, int start, int end, TransportMode mode) {
+    return findPath(graph, start, end, mode, ALGO_BIDIRECTIONAL_DIJKSTRA);
+}
+
+// 双向A*算法（图未冻结时退回单向A*）
+PathResult* bidirectionalAStar(Graph* graph, int start, int end, TransportMode mode) {
+    return findPath(graph, start, end, mode, ALGO_BIDIRECTIONAL_ASTAR);
+}
+
+// 根据名称按指定算法查找路径
+PathResult* findPathByNameWithAlgorithm(Graph* graph, const char* startName, const char* endName,
+                                        TransportMode mode, PathAlgorithm algorithm) {
     if (!graph || !isValidString(startName) || !isValidString(endName)) {
         return NULL;
     }
@@ -557,5 +974,16 @@ PathResult* findPathByNameAStar(Graph* graph, const char* startName, const char*
         return NULL;
     }
     
-    return astar(graph, startId, endId, mode);
-} 
\ No newline at end of file
+    return findPath(graph, startId, endId, mode, algorithm);
+}
+
+// 获取算法名称
+const char* getAlgorithmName(PathAlgorithm algorithm) {
+    switch (algorithm) {
+        case ALGO_DIJKSTRA: return "Dijkstra";
+        case ALGO_ASTAR: return "A*";
+        case ALGO_BIDIRECTIONAL_DIJKSTRA: return "双向Dijkstra";
+        case ALGO_BIDIRECTIONAL_ASTAR: return "双向A*";
+        default: return "未知";
+    }
+}
@@ -0,0 +1,396 @@
+#include "../include/routecache.h"
+#include "../include/utils.h"
+
+// ==================== 键与签名 ====================
+
+// 查询键的哈希值（低位选择分片，高位选择桶）
+static unsigned int hashRouteKey(int start, int end, TransportMode mode, PathAlgorithm algorithm) {
+    unsigned int h = (unsigned int)start * 2654435761u;
+    h ^= (unsigned int)end * 2246822519u;
+    h ^= ((unsigned int)mode << 4 | (unsigned int)algorithm) * 3266489917u;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h;
+}
+
+// 编号在64位签名中对应的位
+static unsigned long long signatureBit(int id) {
+    unsigned int h = (unsigned int)id * 2654435761u;
+    return 1ULL << (h >> 26);
+}
+
+// 路径代价（沿路径边累加modeWeight，不可达为INF）
+static int routeCost(const Graph* graph, const PathResult* result, TransportMode mode) {
+    if (!result->isValid) return INF;
+    
+    long long cost = 0;
+    for (int i = 0; i < result->pathLength - 1; i++) {
+        cost += graph->edges[result->edges[i]].modeWeight[mode];
+    }
+    return cost < INF ? (int)cost : INF;
+}
+
+// ==================== 分片内部操作（调用方持有分片锁） ====================
+
+static RouteCacheEntry* findEntry(RouteCacheShard* shard, unsigned int hash, int start, int end,
+                                  TransportMode mode, PathAlgorithm algorithm) {
+    RouteCacheEntry* entry = shard->buckets[(hash >> 4) & (unsigned int)(shard->bucketCount - 1)];
+    while (entry) {
+        if (entry->start == start && entry->end == end && entry->mode == mode && entry->algorithm == algorithm) {
+            return entry;
+        }
+        entry = entry->hashNext;
+    }
+    return NULL;
+}
+
+static void lruUnlink(RouteCacheShard* shard, RouteCacheEntry* entry) {
+    if (entry->lruPrev) entry->lruPrev->lruNext = entry->lruNext;
+    else shard->lruHead = entry->lruNext;
+    if (entry->lruNext) entry->lruNext->lruPrev = entry->lruPrev;
+    else shard->lruTail = entry->lruPrev;
+}
+
+static void lruPushFront(RouteCacheShard* shard, RouteCacheEntry* entry) {
+    entry->lruPrev = NULL;
+    entry->lruNext = shard->lruHead;
+    if (shard->lruHead) shard->lruHead->lruPrev = entry;
+    else shard->lruTail = entry;
+    shard->lruHead = entry;
+}
+
+// 从哈希桶和LRU链表中移除并释放一项
+static void removeEntry(RouteCacheShard* shard, RouteCacheEntry* entry) {
+    unsigned int hash = hashRouteKey(entry->start, entry->end, entry->mode, entry->algorithm);
+    RouteCacheEntry** link = &shard->buckets[(hash >> 4) & (unsigned int)(shard->bucketCount - 1)];
+    while (*link != entry) {
+        link = &(*link)->hashNext;
+    }
+    *link = entry->hashNext;
+    lruUnlink(shard, entry);
+    
+    free(entry->result.path);
+    free(entry->result.edges);
+    free(entry);
+    shard->count--;
+}
+
+// ==================== 失效判断 ====================
+
+// 路径是否经过边edgeId
+static int routeUsesEdge(const RouteCacheEntry* entry, int edgeId) {
+    if (!(entry->edgeSignature & signatureBit(edgeId))) return 0;
+    
+    for (int i = 0; i < entry->result.pathLength - 1; i++) {
+        if (entry->result.edges[i] == edgeId) return 1;
+    }
+    return 0;
+}
+
+// 路径是否经过节点nodeId
+static int routeUsesNode(const RouteCacheEntry* entry, int nodeId) {
+    if (!(entry->nodeSignature & signatureBit(nodeId))) return 0;
+    
+    for (int i = 0; i < entry->result.pathLength; i++) {
+        if (entry->result.path[i] == nodeId) return 1;
+    }
+    return 0;
+}
+
+// 经过u到v（代价weight）的路径是否可能比缓存的路径更短：lb(start,u) + weight + lb(v,end) < cost
+static int mayImprove(const RouteCacheEntry* entry, const LandmarkSet* landmarks, int u, int v, int weight) {
+    if (weight == INF) return 0;
+    
+    long long bound = (long long)weight;
+    if (landmarks) {
+        bound += landmarkLowerBound(landmarks, entry->mode, entry->start, u);
+        bound += landmarkLowerBound(landmarks, entry->mode, v, entry->end);
+    }
+    return bound < entry->cost;
+}
+
+// 一次图修改后缓存项是否可能不再正确
+static int isEntryAffected(const RouteCacheEntry* entry, const Graph* graph, const GraphChange* change,
+                           const LandmarkSet* landmarks) {
+    const Edge* edge = change->edgeId >= 0 ? &graph->edges[change->edgeId] : NULL;
+    
+    switch (change->type) {
+        case GRAPH_CHANGE_NODE_ADDED:
+            return 0;  // 孤立的新节点不影响已有路径
+        case GRAPH_CHANGE_EDGE_ADDED:
+            if (!graph->nodes[edge->from].isActive || !graph->nodes[edge->to].isActive) return 0;
+            return mayImprove(entry, landmarks, edge->from, edge->to, edge->modeWeight[entry->mode]);
+        case GRAPH_CHANGE_EDGE_WEIGHT:
+            if (change->mode != entry->mode) return 0;
+            if (change->newValue > change->oldValue) return routeUsesEdge(entry, change->edgeId);
+            return mayImprove(entry, landmarks, edge->from, edge->to, change->newValue);
+        case GRAPH_CHANGE_EDGE_ACCESS:
+            if (!change->newValue) return routeUsesEdge(entry, change->edgeId);
+            return mayImprove(entry, landmarks, edge->from, edge->to, edge->modeWeight[entry->mode]);
+        case GRAPH_CHANGE_NODE_ACCESS:
+            if (!change->newValue) return routeUsesNode(entry, change->nodeId);
+            return mayImprove(entry, landmarks, change->nodeId, change->nodeId, 0);
+    }
+    return 1;
+}
+
+// 修改是否可能使某些路径变短（此后地标下界不再可靠）
+static int isDecreasingChange(const GraphChange* change) {
+    switch (change->type) {
+        case GRAPH_CHANGE_EDGE_ADDED:
+            return 1;
+        case GRAPH_CHANGE_EDGE_WEIGHT:
+            return change->newValue < change->oldValue;
+        case GRAPH_CHANGE_EDGE_ACCESS:
+        case GRAPH_CHANGE_NODE_ACCESS:
+            return change->newValue != 0;
+        default:
+            return 0;
+    }
+}
+
+// 图变化监听：推进各分片的版本并淘汰受影响的项
+static void onGraphChange(Graph* graph, const GraphChange* change, void* userData) {
+    RouteCache* cache = (RouteCache*)userData;
+    
+    for (int s = 0; s < ROUTE_CACHE_SHARDS; s++) {
+        RouteCacheShard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        shard->version = graph->version;
+        
+        RouteCacheEntry* entry = shard->lruHead;
+        while (entry) {
+            RouteCacheEntry* next = entry->lruNext;
+            if (isEntryAffected(entry, graph, change, cache->landmarks)) {
+                removeEntry(shard, entry);
+                shard->invalidations++;
+            }
+            entry = next;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+    
+    // 地标基于修改前的图：对第一次减小型修改本身仍是有效下界（新路径在该修改之前的部分不经过它），之后不再可靠
+    if (isDecreasingChange(change)) {
+        cache->landmarks = NULL;
+    }
+}
+
+// ==================== 公共接口 ====================
+
+// 创建缓存并注册图变化监听
+RouteCache* createRouteCache(Graph* graph, int capacity) {
+    if (!graph) return NULL;
+    
+    RouteCache* cache = (RouteCache*)safeMalloc(sizeof(RouteCache));
+    if (!cache) return NULL;
+    
+    if (capacity <= 0) capacity = DEFAULT_ROUTE_CACHE_CAPACITY;
+    int shardCapacity = maxInt(1, (capacity + ROUTE_CACHE_SHARDS - 1) / ROUTE_CACHE_SHARDS);
+    int bucketCount = 1;
+    while (bucketCount < shardCapacity * 2) {
+        bucketCount *= 2;
+    }
+    
+    cache->graph = graph;
+    cache->landmarks = NULL;
+    for (int s = 0; s < ROUTE_CACHE_SHARDS; s++) {
+        RouteCacheShard* shard = &cache->shards[s];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->buckets = (RouteCacheEntry**)safeMalloc((size_t)bucketCount * sizeof(RouteCacheEntry*));
+        for (int b = 0; b < bucketCount; b++) {
+            shard->buckets[b] = NULL;
+        }
+        shard->bucketCount = bucketCount;
+        shard->count = 0;
+        shard->capacity = shardCapacity;
+        shard->lruHead = NULL;
+        shard->lruTail = NULL;
+        shard->version = graph->version;
+        shard->hits = 0;
+        shard->misses = 0;
+        shard->insertions = 0;
+        shard->evictions = 0;
+        shard->invalidations = 0;
+        shard->staleInserts = 0;
+    }
+    
+    if (addGraphListener(graph, onGraphChange, cache) != 0) {
+        destroyRouteCache(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+// 销毁缓存
+void destroyRouteCache(RouteCache* cache) {
+    if (!cache) return;
+    
+    removeGraphListener(cache->graph, onGraphChange, cache);
+    clearRouteCache(cache);
+    for (int s = 0; s < ROUTE_CACHE_SHARDS; s++) {
+        pthread_mutex_destroy(&cache->shards[s].lock);
+        free(cache->shards[s].buckets);
+    }
+    free(cache);
+}
+
+// 清空缓存（统计信息保留）
+void clearRouteCache(RouteCache* cache) {
+    if (!cache) return;
+    
+    for (int s = 0; s < ROUTE_CACHE_SHARDS; s++) {
+        RouteCacheShard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        while (shard->lruHead) {
+            removeEntry(shard, shard->lruHead);
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+// 设置地标
+void setRouteCacheLandmarks(RouteCache* cache, const LandmarkSet* landmarks) {
+    if (!cache) return;
+    cache->landmarks = landmarks;
+}
+
+// 查询参数是否有效
+static int isValidRouteKey(const RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm) {
+    return cache && isValidNodeId(start, cache->graph->nodeCount) && isValidNodeId(end, cache->graph->nodeCount) &&
+           mode >= 0 && mode < MODE_COUNT && algorithm >= 0 && algorithm < ALGO_COUNT;
+}
+
+// 在持有分片锁时查找，命中则移到LRU表头并复制结果
+static PathResult* lookupLocked(RouteCacheShard* shard, unsigned int hash, int start, int end,
+                                TransportMode mode, PathAlgorithm algorithm) {
+    RouteCacheEntry* entry = findEntry(shard, hash, start, end, mode, algorithm);
+    if (!entry) {
+        shard->misses++;
+        return NULL;
+    }
+    
+    shard->hits++;
+    lruUnlink(shard, entry);
+    lruPushFront(shard, entry);
+    return copyPathResult(&entry->result);
+}
+
+// 查找缓存
+PathResult* routeCacheLookup(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm) {
+    if (!isValidRouteKey(cache, start, end, mode, algorithm)) return NULL;
+    
+    unsigned int hash = hashRouteKey(start, end, mode, algorithm);
+    RouteCacheShard* shard = &cache->shards[hash & (ROUTE_CACHE_SHARDS - 1)];
+    
+    pthread_mutex_lock(&shard->lock);
+    PathResult* result = lookupLocked(shard, hash, start, end, mode, algorithm);
+    pthread_mutex_unlock(&shard->lock);
+    return result;
+}
+
+// 插入结果
+int routeCacheInsert(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm,
+                     const PathResult* result, unsigned long long version) {
+    if (!isValidRouteKey(cache, start, end, mode, algorithm) || !result) return -1;
+    
+    unsigned int hash = hashRouteKey(start, end, mode, algorithm);
+    RouteCacheShard* shard = &cache->shards[hash & (ROUTE_CACHE_SHARDS - 1)];
+    
+    // 在锁外复制结果并计算签名
+    RouteCacheEntry* entry = (RouteCacheEntry*)safeMalloc(sizeof(RouteCacheEntry));
+    PathResult* copy = copyPathResult(result);
+    entry->start = start;
+    entry->end = end;
+    entry->mode = mode;
+    entry->algorithm = algorithm;
+    entry->version = version;
+    entry->result = *copy;
+    free(copy);
+    entry->cost = routeCost(cache->graph, &entry->result, mode);
+    entry->edgeSignature = 0;
+    entry->nodeSignature = 0;
+    if (entry->result.isValid) {
+        for (int i = 0; i < entry->result.pathLength; i++) {
+            entry->nodeSignature |= signatureBit(entry->result.path[i]);
+        }
+        for (int i = 0; i < entry->result.pathLength - 1; i++) {
+            entry->edgeSignature |= signatureBit(entry->result.edges[i]);
+        }
+    }
+    
+    pthread_mutex_lock(&shard->lock);
+    
+    if (version != shard->version) {
+        shard->staleInserts++;
+        pthread_mutex_unlock(&shard->lock);
+        free(entry->result.path);
+        free(entry->result.edges);
+        free(entry);
+        return 1;
+    }
+    
+    // 已存在时替换旧结果
+    RouteCacheEntry* old = findEntry(shard, hash, start, end, mode, algorithm);
+    if (old) {
+        removeEntry(shard, old);
+    } else if (shard->count >= shard->capacity) {
+        removeEntry(shard, shard->lruTail);
+        shard->evictions++;
+    }
+    
+    RouteCacheEntry** bucket = &shard->buckets[(hash >> 4) & (unsigned int)(shard->bucketCount - 1)];
+    entry->hashNext = *bucket;
+    *bucket = entry;
+    lruPushFront(shard, entry);
+    shard->count++;
+    shard->insertions++;
+    
+    pthread_mutex_unlock(&shard->lock);
+    return 0;
+}
+
+// 先查缓存，未命中时计算并插入
+PathResult* findPathWithRouteCache(RouteCache* cache, int start, int end, TransportMode mode, PathAlgorithm algorithm) {
+    if (!isValidRouteKey(cache, start, end, mode, algorithm)) return NULL;
+    
+    unsigned int hash = hashRouteKey(start, end, mode, algorithm);
+    RouteCacheShard* shard = &cache->shards[hash & (ROUTE_CACHE_SHARDS - 1)];
+    
+    // 未命中时记下当前版本，插入时据此判断计算期间图是否被修改
+    pthread_mutex_lock(&shard->lock);
+    PathResult* result = lookupLocked(shard, hash, start, end, mode, algorithm);
+    unsigned long long version = shard->version;
+    pthread_mutex_unlock(&shard->lock);
+    if (result) return result;
+    
+    result = findPath(cache->graph, start, end, mode, algorithm);
+    if (result) {
+        routeCacheInsert(cache, start, end, mode, algorithm, result, version);
+    }
+    return result;
+}
+
+// 汇总统计信息
+void getRouteCacheStats(RouteCache* cache, RouteCacheStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(RouteCacheStats));
+    if (!cache) return;
+    
+    for (int s = 0; s < ROUTE_CACHE_SHARDS; s++) {
+        RouteCacheShard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        stats->entries += shard->count;
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->insertions += shard->insertions;
+        stats->evictions += shard->evictions;
+        stats->invalidations += shard->invalidations;
+        stats->staleInserts += shard->staleInserts;
+        pthread_mutex_unlock(&shard->lock);
+    }
+    
+    long long lookups = stats->hits + stats->misses;
+    stats->hitRate = lookups > 0 ? (double)stats->hits / lookups : 0.0;
+}
@@ -0,0 +1,910 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "../include/server.h"
+#include "../include/engine.h"
+#include "../include/batch.h"
+#include "../include/loader.h"
+#include "../include/snapshot.h"
+#include "../include/utils.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+typedef struct RoutingServer RoutingServer;
+typedef struct ServerConnection ServerConnection;
+
+// 一份加载好的图及其查询引擎。重新加载后旧实例不再接收新请求，其上的请求全部完成后销毁
+typedef struct {
+    Graph* graph;
+    GraphSnapshot* snapshot;    // 图来自快照时不为NULL
+    QueryEngine* engine;
+    int ownsGraph;              // 图是否由服务加载（初始的图归调用方所有）
+    int pending;                // 已提交、尚未处理完成通知的请求数
+    unsigned int generation;    // 第几次加载（初始为0）
+} GraphInstance;
+
+// 一个请求。响应按到达顺序挂在连接上；无需搜索的请求（命令和错误）创建时即已完成
+typedef struct ServerRequest {
+    RoutingServer* server;
+    ServerConnection* connection;           // 连接已关闭或请求已超时响应时为NULL
+    GraphInstance* instance;                // 执行搜索的图（无需搜索时为NULL）
+    RouteText response;                     // 搜索完成前只由工作线程写入
+    double deadline;                        // 截止时刻（0表示不限）
+    int done;                               // 响应已就绪（事件循环线程维护）
+    int timedOut;                           // 已超过截止时刻仍未完成
+    int expired;                            // 搜索完成时已超过截止时刻（由工作线程设置）
+    struct ServerRequest* next;             // 同一连接中的下一个请求
+    struct ServerRequest* nextCompleted;    // 完成队列中的下一个请求
+} ServerRequest;
+
+struct ServerConnection {
+    int fd;
+    int slot;                               // 在服务连接数组中的位置
+    unsigned int events;                    // 当前注册的epoll事件
+    char readBuffer[SERVER_READ_BUFFER];
+    int readLength;
+    int discarding;                         // 正在丢弃过长的行
+    int readClosed;                         // 不再读取（对方已关闭写端或发送了QUIT）
+    int quit;                               // 收到QUIT，之后的数据被忽略
+    char* output;                           // 待发送的响应 [outputOffset, outputLength)
+    size_t outputLength;
+    size_t outputOffset;
+    size_t outputCapacity;
+    ServerRequest* head;                    // 等待响应的请求（按到达顺序）
+    ServerRequest* tail;
+    int inFlight;                           // 等待响应的请求数
+    int ready;                              // 已在待处理列表中
+    int pausedSlot;                         // 在暂停列表中的位置加1（0表示未暂停）
+};
+
+struct RoutingServer {
+    const ServerOptions* options;
+    int epollFd;
+    int listenFd;
+    int wakeFd;                             // 工作线程完成请求或重新加载结束时写入
+    int signalFd;
+    struct sockaddr_un unixAddress;         // 监听Unix套接字时退出前删除该路径
+    int isUnixSocket;
+    
+    GraphInstance* current;                 // 新请求使用的图
+    GraphInstance** retired;                // 已被替换、仍有请求未完成的图
+    int retiredCount;
+    int retiredCapacity;
+    unsigned int generation;
+    
+    ServerConnection** connections;
+    int connectionCount;
+    int connectionCapacity;
+    ServerConnection** ready;               // 本次唤醒需要处理的连接（有请求完成或被暂停的连接）
+    int readyCount;
+    int readyCapacity;
+    ServerConnection** paused;              // 在途请求达到上限、缓冲区中还有未处理数据的连接
+    int pausedCount;
+    int pausedCapacity;
+    
+    pthread_mutex_t lock;                   // 保护完成队列和重新加载的结果
+    ServerRequest* completed;
+    pthread_t reloadThread;
+    int reloading;                          // 后台加载进行中（事件循环线程维护）
+    int reloadFinished;
+    GraphInstance* reloaded;                // 加载结果（失败时为NULL）
+    
+    double earliestDeadline;                // 未完成请求中最早的截止时刻（0表示没有）
+    int draining;                           // 收到退出信号，等待未完成的请求
+    double drainDeadline;
+    
+    long long requestCount;
+    long long timeoutCount;
+    long long errorCount;
+    long long closedCount;                  // 累计关闭的连接数（用于发现本轮事件中已释放的连接）
+};
+
+// ---------- 图实例 ----------
+
+static GraphInstance* createInstance(Graph* graph, GraphSnapshot* snapshot, int ownsGraph, int threadCount) {
+    QueryEngine* engine = createQueryEngine(graph, threadCount);
+    if (!engine) return NULL;
+    
+    GraphInstance* instance = (GraphInstance*)safeMalloc(sizeof(GraphInstance));
+    instance->graph = graph;
+    instance->snapshot = snapshot;
+    instance->engine = engine;
+    instance->ownsGraph = ownsGraph;
+    instance->pending = 0;
+    instance->generation = 0;
+    return instance;
+}
+
+static void destroyInstance(GraphInstance* instance) {
+    if (!instance) return;
+    
+    destroyQueryEngine(instance->engine);
+    if (instance->ownsGraph) {
+        if (instance->snapshot) {
+            closeGraphSnapshot(instance->snapshot);
+        } else {
+            destroyGraph(instance->graph);
+        }
+    }
+    free(instance);
+}
+
+// 按文件类型加载图（快照、DIMACS .gr 或文本格式）并创建查询引擎
+static GraphInstance* loadInstance(const char* path, int threadCount) {
+    Graph* graph = NULL;
+    GraphSnapshot* snapshot = NULL;
+    size_t length = strlen(path);
+    
+    if (isGraphSnapshotFile(path)) {
+        ErrorCode error;
+        snapshot = openGraphSnapshot(path, &error);
+        if (!snapshot) {
+            fprintf(stderr, "重新加载失败: %s\n", getErrorMessage(error));
+            return NULL;
+        }
+        graph = snapshot->graph;
+    } else {
+        GraphLoadStatus status;
+        if (length > 3 && strcmp(path + length - 3, ".gr") == 0) {
+            graph = loadDimacsGraphWithCoordinates(path, &status);
+        } else {
+            graph = loadGraph(path, &status);
+        }
+        if (!graph) {
+            fprintf(stderr, "重新加载失败（第%d行）: %s\n", status.line, status.message);
+            return NULL;
+        }
+    }
+    
+    GraphInstance* instance = createInstance(graph, snapshot, 1, threadCount);
+    if (!instance) {
+        if (snapshot) {
+            closeGraphSnapshot(snapshot);
+        } else {
+            destroyGraph(graph);
+        }
+    }
+    return instance;
+}
+
+// 请求全部完成后销毁已被替换的图
+static void releaseRetired(RoutingServer* server) {
+    for (int i = 0; i < server->retiredCount; ) {
+        GraphInstance* instance = server->retired[i];
+        if (instance->pending > 0) {
+            i++;
+            continue;
+        }
+        fprintf(stderr, "第%u代图的请求已全部完成，释放旧图\n", instance->generation);
+        destroyInstance(instance);
+        server->retired[i] = server->retired[--server->retiredCount];
+    }
+}
+
+// ---------- 后台重新加载 ----------
+
+static void wakeEventLoop(RoutingServer* server) {
+    unsigned long long one = 1;
+    ssize_t written = write(server->wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+static void* reloadWorker(void* arg) {
+    RoutingServer* server = (RoutingServer*)arg;
+    double begin = getTimeSeconds();
+    GraphInstance* instance = loadInstance(server->options->graphPath, server->options->threadCount);
+    if (instance) {
+        fprintf(stderr, "已重新加载 %s（%d 个节点、%d 条边，%.2f 秒）\n", server->options->graphPath,
+                instance->graph->nodeCount, instance->graph->edgeCount, getTimeSeconds() - begin);
+    }
+    
+    pthread_mutex_lock(&server->lock);
+    server->reloaded = instance;
+    server->reloadFinished = 1;
+    pthread_mutex_unlock(&server->lock);
+    wakeEventLoop(server);
+    return NULL;
+}
+
+// 开始重新加载，返回0表示已开始
+static int startReload(RoutingServer* server) {
+    if (!server->options->graphPath || server->reloading || server->draining) return -1;
+    
+    server->reloadFinished = 0;
+    server->reloaded = NULL;
+    if (pthread_create(&server->reloadThread, NULL, reloadWorker, server) != 0) return -1;
+    server->reloading = 1;
+    return 0;
+}
+
+// 加载线程结束后切换到新图：新请求使用新图，旧图在其请求完成后释放。返回1表示已切换
+static int finishReload(RoutingServer* server) {
+    pthread_mutex_lock(&server->lock);
+    int finished = server->reloadFinished;
+    GraphInstance* instance = server->reloaded;
+    pthread_mutex_unlock(&server->lock);
+    if (!server->reloading || !finished) return 0;
+    
+    pthread_join(server->reloadThread, NULL);
+    server->reloading = 0;
+    if (!instance) return 0;
+    
+    if (server->retiredCount == server->retiredCapacity) {
+        server->retiredCapacity = maxInt(4, server->retiredCapacity * 2);
+        server->retired = (GraphInstance**)safeRealloc(server->retired,
+                                                      (size_t)server->retiredCapacity * sizeof(GraphInstance*));
+    }
+    server->retired[server->retiredCount++] = server->current;
+    instance->generation = ++server->generation;
+    server->current = instance;
+    releaseRetired(server);
+    return 1;
+}
+
+// ---------- 连接与输出 ----------
+
+static void appendOutput(ServerConnection* connection, const char* data, size_t length) {
+    if (connection->outputOffset == connection->outputLength) {
+        connection->outputOffset = 0;
+        connection->outputLength = 0;
+    }
+    if (connection->outputLength + length > connection->outputCapacity) {
+        size_t capacity = connection->outputCapacity ? connection->outputCapacity : 4096;
+        while (connection->outputLength + length > capacity) capacity *= 2;
+        connection->output = (char*)safeRealloc(connection->output, capacity);
+        connection->outputCapacity = capacity;
+    }
+    memcpy(connection->output + connection->outputLength, data, length);
+    connection->outputLength += length;
+}
+
+static void freeRequest(ServerRequest* request) {
+    free(request->response.text);
+    free(request);
+}
+
+// 按请求顺序把已就绪的响应移入发送缓冲区；超时的请求以timeout响应，其搜索完成后再释放
+static void collectResponses(RoutingServer* server, ServerConnection* connection) {
+    while (connection->head && (connection->head->done || connection->head->timedOut)) {
+        ServerRequest* request = connection->head;
+        connection->head = request->next;
+        if (!connection->head) connection->tail = NULL;
+        connection->inFlight--;
+        
+        if (request->done) {
+            appendOutput(connection, request->response.text, (size_t)request->response.length);
+            freeRequest(request);
+        } else {
+            appendOutput(connection, "timeout\n", 8);
+            server->timeoutCount++;
+            request->connection = NULL;
+        }
+    }
+}
+
+// 根据连接状态更新关注的事件：请求过多或待发送数据过多时暂停读取
+static void updateInterest(RoutingServer* server, ServerConnection* connection) {
+    unsigned int events = 0;
+    if (!connection->readClosed && !server->draining && connection->inFlight < SERVER_MAX_PIPELINE &&
+        connection->readLength < SERVER_READ_BUFFER && connection->outputLength - connection->outputOffset < SERVER_MAX_OUTPUT) {
+        events |= EPOLLIN;
+    }
+    if (connection->outputOffset < connection->outputLength) events |= EPOLLOUT;
+    if (events == connection->events) return;
+    
+    struct epoll_event event;
+    event.events = events;
+    event.data.ptr = connection;
+    epoll_ctl(server->epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+    connection->events = events;
+}
+
+// 把连接放入本次唤醒的待处理列表（已在列表中时忽略）
+static void scheduleConnection(RoutingServer* server, ServerConnection* connection) {
+    if (connection->ready) return;
+    
+    if (server->readyCount == server->readyCapacity) {
+        server->readyCapacity = maxInt(16, server->readyCapacity * 2);
+        server->ready = (ServerConnection**)safeRealloc(server->ready,
+                                                       (size_t)server->readyCapacity * sizeof(ServerConnection*));
+    }
+    server->ready[server->readyCount++] = connection;
+    connection->ready = 1;
+}
+
+// 登记或取消连接的暂停状态（在途请求达到上限时缓冲区中剩余的行要等请求完成后处理）
+static void setPaused(RoutingServer* server, ServerConnection* connection, int paused) {
+    if (paused == (connection->pausedSlot != 0)) return;
+    
+    if (paused) {
+        if (server->pausedCount == server->pausedCapacity) {
+            server->pausedCapacity = maxInt(16, server->pausedCapacity * 2);
+            server->paused = (ServerConnection**)safeRealloc(server->paused,
+                                                            (size_t)server->pausedCapacity * sizeof(ServerConnection*));
+        }
+        server->paused[server->pausedCount++] = connection;
+        connection->pausedSlot = server->pausedCount;
+    } else {
+        int slot = connection->pausedSlot - 1;
+        server->paused[slot] = server->paused[--server->pausedCount];
+        server->paused[slot]->pausedSlot = slot + 1;
+        connection->pausedSlot = 0;
+    }
+}
+
+static void closeConnection(RoutingServer* server, ServerConnection* connection) {
+    // 未完成的请求在搜索完成后释放
+    ServerRequest* request = connection->head;
+    while (request) {
+        ServerRequest* next = request->next;
+        if (request->done) {
+            freeRequest(request);
+        } else {
+            request->connection = NULL;
+        }
+        request = next;
+    }
+    
+    setPaused(server, connection, 0);
+    epoll_ctl(server->epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    
+    int slot = connection->slot;
+    server->connections[slot] = server->connections[--server->connectionCount];
+    server->connections[slot]->slot = slot;
+    server->closedCount++;
+    free(connection->output);
+    free(connection);
+}
+
+// 发送缓冲区中的数据，返回-1表示连接已断开
+static int flushOutput(ServerConnection* connection) {
+    while (connection->outputOffset < connection->outputLength) {
+        ssize_t sent = send(connection->fd, connection->output + connection->outputOffset,
+                            connection->outputLength - connection->outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->outputOffset += (size_t)sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 发送并更新连接状态；对方已关闭且响应全部发出时关闭连接
+static void serviceConnection(RoutingServer* server, ServerConnection* connection) {
+    if (flushOutput(connection) != 0) {
+        closeConnection(server, connection);
+        return;
+    }
+    if (connection->readClosed && connection->inFlight == 0 && (connection->quit || connection->readLength == 0) &&
+        connection->outputOffset == connection->outputLength) {
+        closeConnection(server, connection);
+        return;
+    }
+    updateInterest(server, connection);
+}
+
+// ---------- 请求处理 ----------
+
+static ServerRequest* createRequest(RoutingServer* server, ServerConnection* connection) {
+    ServerRequest* request = (ServerRequest*)safeMalloc(sizeof(ServerRequest));
+    memset(request, 0, sizeof(ServerRequest));
+    request->server = server;
+    request->connection = connection;
+    
+    if (connection->tail) {
+        connection->tail->next = request;
+    } else {
+        connection->head = request;
+    }
+    connection->tail = request;
+    connection->inFlight++;
+    return request;
+}
+
+// 立即完成的请求（命令和错误）
+static void respondNow(RoutingServer* server, ServerConnection* connection, const char* text) {
+    ServerRequest* request = createRequest(server, connection);
+    appendRouteText(&request->response, text, (int)strlen(text));
+    request->done = 1;
+}
+
+// 搜索完成回调（在工作线程中执行）：格式化响应并放入完成队列
+static void onRequestDone(int index, const RouteQuery* query, const PathResult* result,
+                          double elapsedSeconds, void* userData) {
+    ServerRequest* request = (ServerRequest*)userData;
+    RoutingServer* server = request->server;
+    (void)index;
+    (void)elapsedSeconds;
+    
+    if (query->deadline > 0.0 && getTimeSeconds() > query->deadline) {
+        appendRouteText(&request->response, "timeout\n", 8);
+        request->expired = 1;
+    } else {
+        formatRouteResult(&request->response, request->instance->graph, query, result, server->options->printPath);
+    }
+    
+    pthread_mutex_lock(&server->lock);
+    int wasEmpty = server->completed == NULL;
+    request->nextCompleted = server->completed;
+    server->completed = request;
+    pthread_mutex_unlock(&server->lock);
+    if (wasEmpty) wakeEventLoop(server);
+}
+
+// 处理完成队列中的请求，涉及的连接放入待处理列表
+static void processCompletions(RoutingServer* server) {
+    unsigned long long count;
+    ssize_t received = read(server->wakeFd, &count, sizeof(count));
+    (void)received;
+    
+    pthread_mutex_lock(&server->lock);
+    ServerRequest* request = server->completed;
+    server->completed = NULL;
+    pthread_mutex_unlock(&server->lock);
+    
+    while (request) {
+        ServerRequest* next = request->nextCompleted;
+        request->done = 1;
+        request->instance->pending--;
+        if (request->expired && request->connection) server->timeoutCount++;
+        
+        ServerConnection* connection = request->connection;
+        if (!connection) {
+            freeRequest(request);
+        } else {
+            scheduleConnection(server, connection);
+        }
+        request = next;
+    }
+    
+    releaseRetired(server);
+}
+
+static void formatStats(RoutingServer* server, char* buffer, size_t size) {
+    const Graph* graph = server->current->graph;
+    snprintf(buffer, size,
+             "stats connections=%d requests=%lld timeouts=%lld errors=%lld generation=%u nodes=%d edges=%d threads=%d\n",
+             server->connectionCount, server->requestCount, server->timeoutCount, server->errorCount,
+             server->current->generation, graph->nodeCount, graph->edgeCount, server->current->engine->threadCount);
+}
+
+// 处理一行请求
+static void handleLine(RoutingServer* server, ServerConnection* connection, char* line) {
+    trimString(line);
+    if (line[0] == '\0') return;
+    server->requestCount++;
+    
+    // 单个单词的行是命令（查询至少有两个字段）
+    if (!strchr(line, ' ') && !strchr(line, '\t')) {
+        char buffer[256];
+        if (stringCompareIgnoreCase(line, "PING") == 0) {
+            respondNow(server, connection, "pong\n");
+        } else if (stringCompareIgnoreCase(line, "STATS") == 0) {
+            formatStats(server, buffer, sizeof(buffer));
+            respondNow(server, connection, buffer);
+        } else if (stringCompareIgnoreCase(line, "RELOAD") == 0) {
+            respondNow(server, connection, startReload(server) == 0 ? "reloading\n" : "error 无法重新加载\n");
+        } else if (stringCompareIgnoreCase(line, "QUIT") == 0) {
+            respondNow(server, connection, "bye\n");
+            connection->quit = 1;
+            connection->readClosed = 1;
+        } else {
+            server->errorCount++;
+            respondNow(server, connection, "error 未知命令\n");
+        }
+        return;
+    }
+    
+    GraphInstance* instance = server->current;
+    RouteQuery query;
+    int deadlineMs = 0;
+    const char* error;
+    if (parseRouteQuery(instance->graph, line, &query, &deadlineMs, &error) != 0) {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "error %s\n", error);
+        server->errorCount++;
+        respondNow(server, connection, buffer);
+        return;
+    }
+    
+    if (deadlineMs == 0) deadlineMs = server->options->defaultDeadlineMs;
+    ServerRequest* request = createRequest(server, connection);
+    request->instance = instance;
+    if (deadlineMs > 0) {
+        request->deadline = getTimeSeconds() + deadlineMs / 1000.0;
+        query.deadline = request->deadline;
+        if (server->earliestDeadline == 0.0 || request->deadline < server->earliestDeadline) {
+            server->earliestDeadline = request->deadline;
+        }
+    }
+    instance->pending++;
+    submitQueryBatch(instance->engine, &query, 1, onRequestDone, request);
+}
+
+// 处理读缓冲区中完整的行（在途请求达到上限时暂停，剩余数据留待之后处理）
+static void processLines(RoutingServer* server, ServerConnection* connection) {
+    int start = 0;
+    while (!connection->quit && connection->inFlight < SERVER_MAX_PIPELINE) {
+        char* newline = memchr(connection->readBuffer + start, '\n', (size_t)(connection->readLength - start));
+        if (!newline) break;
+        
+        *newline = '\0';
+        if (connection->discarding) {
+            connection->discarding = 0;
+        } else {
+            handleLine(server, connection, connection->readBuffer + start);
+        }
+        start = (int)(newline - connection->readBuffer) + 1;
+    }
+    
+    if (connection->quit) {
+        connection->readLength = 0;
+        setPaused(server, connection, 0);
+        return;
+    }
+    connection->readLength -= start;
+    memmove(connection->readBuffer, connection->readBuffer + start, (size_t)connection->readLength);
+    
+    // 缓冲区已满仍没有换行：丢弃该行直到下一个换行
+    if (connection->readLength == SERVER_READ_BUFFER) {
+        if (!connection->discarding) {
+            server->errorCount++;
+            respondNow(server, connection, "error 行过长\n");
+        }
+        connection->discarding = 1;
+        connection->readLength = 0;
+    }
+    setPaused(server, connection, connection->inFlight >= SERVER_MAX_PIPELINE && connection->readLength > 0);
+}
+
+// 在途请求减少后继续处理缓冲区中剩余的行，再发送已就绪的响应
+static void resumeConnection(RoutingServer* server, ServerConnection* connection) {
+    if (connection->readLength > 0) processLines(server, connection);
+    collectResponses(server, connection);
+    serviceConnection(server, connection);
+}
+
+// 处理待处理列表中的连接和被暂停的连接，工作量只与这些连接有关，与空闲连接的数量无关。
+// 处理一个连接最多关闭它自己，列表中其余的连接不受影响
+static void serviceReadyConnections(RoutingServer* server) {
+    for (int i = 0; i < server->pausedCount; i++) {
+        scheduleConnection(server, server->paused[i]);
+    }
+    while (server->readyCount > 0) {
+        ServerConnection* connection = server->ready[--server->readyCount];
+        connection->ready = 0;
+        resumeConnection(server, connection);
+    }
+}
+
+static void handleReadable(RoutingServer* server, ServerConnection* connection) {
+    ssize_t received = recv(connection->fd, connection->readBuffer + connection->readLength,
+                            (size_t)(SERVER_READ_BUFFER - connection->readLength), 0);
+    if (received == 0) {
+        // 对方关闭写端：最后一行可以没有换行；处理完已收到的请求、发送全部响应后再关闭
+        connection->readClosed = 1;
+        if (connection->readLength > 0 && connection->readLength < SERVER_READ_BUFFER &&
+            connection->readBuffer[connection->readLength - 1] != '\n') {
+            connection->readBuffer[connection->readLength++] = '\n';
+        }
+        processLines(server, connection);
+    } else if (received < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            closeConnection(server, connection);
+            return;
+        }
+    } else {
+        connection->readLength += (int)received;
+        processLines(server, connection);
+    }
+    
+    collectResponses(server, connection);
+    serviceConnection(server, connection);
+}
+
+static void acceptConnections(RoutingServer* server) {
+    while (1) {
+        int fd = accept4(server->listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        
+        if (!server->isUnixSocket) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        
+        ServerConnection* connection = (ServerConnection*)safeMalloc(sizeof(ServerConnection));
+        memset(connection, 0, sizeof(ServerConnection));
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            free(connection);
+            continue;
+        }
+        
+        if (server->connectionCount == server->connectionCapacity) {
+            server->connectionCapacity = maxInt(16, server->connectionCapacity * 2);
+            server->connections = (ServerConnection**)safeRealloc(server->connections,
+                                                                 (size_t)server->connectionCapacity * sizeof(ServerConnection*));
+        }
+        connection->slot = server->connectionCount;
+        server->connections[server->connectionCount++] = connection;
+    }
+}
+
+// 把超过截止时刻仍未完成的请求标记为超时，并重新计算最早的截止时刻
+static void expireRequests(RoutingServer* server, double now) {
+    server->earliestDeadline = 0.0;
+    
+    for (int i = 0; i < server->connectionCount; ) {
+        ServerConnection* connection = server->connections[i];
+        int expired = 0;
+        for (ServerRequest* request = connection->head; request; request = request->next) {
+            if (request->done || request->timedOut || request->deadline == 0.0) continue;
+            if (request->deadline <= now) {
+                request->timedOut = 1;
+                expired = 1;
+            } else if (server->earliestDeadline == 0.0 || request->deadline < server->earliestDeadline) {
+                server->earliestDeadline = request->deadline;
+            }
+        }
+        
+        if (expired) {
+            int count = server->connectionCount;
+            resumeConnection(server, connection);
+            if (server->connectionCount < count) continue;  // 连接已关闭，当前位置换成了另一个连接
+        }
+        i++;
+    }
+}
+
+// ---------- 启动与主循环 ----------
+
+// 解析监听地址并开始监听，返回监听套接字，失败返回-1
+static int openListener(RoutingServer* server, const char* address) {
+    if (strncmp(address, "unix:", 5) == 0) {
+        const char* path = address + 5;
+        if (strlen(path) == 0 || strlen(path) >= sizeof(server->unixAddress.sun_path)) return -1;
+        
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        memset(&server->unixAddress, 0, sizeof(server->unixAddress));
+        server->unixAddress.sun_family = AF_UNIX;
+        strcpy(server->unixAddress.sun_path, path);
+        unlink(path);
+        if (bind(fd, (struct sockaddr*)&server->unixAddress, sizeof(server->unixAddress)) != 0 ||
+            listen(fd, SOMAXCONN) != 0) {
+            close(fd);
+            return -1;
+        }
+        server->isUnixSocket = 1;
+        return fd;
+    }
+    
+    const char* colon = strrchr(address, ':');
+    if (!colon) return -1;
+    char host[256];
+    size_t hostLength = (size_t)(colon - address);
+    if (hostLength >= sizeof(host)) return -1;
+    memcpy(host, address, hostLength);
+    host[hostLength] = '\0';
+    
+    struct addrinfo hints;
+    struct addrinfo* addresses;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    if (getaddrinfo(hostLength ? host : NULL, colon + 1, &hints, &addresses) != 0) return -1;
+    
+    int fd = -1;
+    for (struct addrinfo* ai = addresses; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || listen(fd, SOMAXCONN) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+static int addWatch(RoutingServer* server, int fd, void* tag) {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = tag;
+    return epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &event);
+}
+
+// 处理SIGHUP（重新加载）、SIGINT和SIGTERM（停止接受连接，等待未完成的请求）
+static void handleSignal(RoutingServer* server) {
+    struct signalfd_siginfo info;
+    while (read(server->signalFd, &info, sizeof(info)) == (ssize_t)sizeof(info)) {
+        if (info.ssi_signo == SIGHUP) {
+            if (startReload(server) == 0) fprintf(stderr, "收到SIGHUP，开始重新加载\n");
+        } else if (!server->draining) {
+            fprintf(stderr, "收到退出信号，等待未完成的请求...\n");
+            server->draining = 1;
+            server->drainDeadline = getTimeSeconds() + SERVER_DRAIN_SECONDS;
+            epoll_ctl(server->epollFd, EPOLL_CTL_DEL, server->listenFd, NULL);
+            close(server->listenFd);
+            server->listenFd = -1;
+            for (int i = 0; i < server->connectionCount; i++) {
+                updateInterest(server, server->connections[i]);
+            }
+        }
+    }
+}
+
+// 没有未完成的请求和待发送的数据
+static int isIdle(const RoutingServer* server) {
+    for (int i = 0; i < server->connectionCount; i++) {
+        const ServerConnection* connection = server->connections[i];
+        if (connection->inFlight > 0 || connection->outputOffset < connection->outputLength) return 0;
+    }
+    return !server->reloading;
+}
+
+static void runEventLoop(RoutingServer* server) {
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    
+    while (1) {
+        double now = getTimeSeconds();
+        if (server->draining && (isIdle(server) || now >= server->drainDeadline)) break;
+        
+        // 等待到最早的截止时刻（向上取整到毫秒）
+        int timeout = -1;
+        if (server->earliestDeadline > 0.0) {
+            timeout = maxInt(0, (int)((server->earliestDeadline - now) * 1000.0) + 1);
+        }
+        if (server->draining) timeout = timeout < 0 ? 100 : minInt(timeout, 100);
+        
+        int count = epoll_wait(server->epollFd, events, SERVER_MAX_EVENTS, timeout);
+        if (count < 0 && errno != EINTR) break;
+        
+        for (int i = 0; i < count; i++) {
+            void* tag = events[i].data.ptr;
+            long long closed = server->closedCount;
+            if (tag == &server->listenFd) {
+                acceptConnections(server);
+            } else if (tag == &server->wakeFd) {
+                processCompletions(server);
+                serviceReadyConnections(server);
+                // 切换到新图后检查全部连接（只在重新加载时发生）
+                if (finishReload(server)) {
+                    for (int j = 0; j < server->connectionCount; ) {
+                        ServerConnection* connection = server->connections[j];
+                        long long before = server->closedCount;
+                        resumeConnection(server, connection);
+                        if (server->closedCount == before) j++;
+                    }
+                }
+            } else if (tag == &server->signalFd) {
+                handleSignal(server);
+            } else {
+                ServerConnection* connection = (ServerConnection*)tag;
+                if (events[i].events & EPOLLIN) {
+                    handleReadable(server, connection);
+                } else if (events[i].events & EPOLLOUT) {
+                    serviceConnection(server, connection);
+                } else if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(server, connection);
+                }
+            }
+            // 本轮后续事件可能指向已释放的连接，留到下一轮处理（水平触发，不会丢失）
+            if (server->closedCount != closed) break;
+        }
+        
+        if (server->earliestDeadline > 0.0 && getTimeSeconds() >= server->earliestDeadline) {
+            expireRequests(server, getTimeSeconds());
+        }
+    }
+}
+
+int runRoutingServer(Graph* graph, const ServerOptions* options) {
+    if (!graph || !options || !options->listenAddress) return -1;
+    
+    // 信号在创建任何线程之前屏蔽，统一经signalfd在事件循环中处理
+    sigset_t signals;
+    sigset_t previous;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+    
+    RoutingServer server;
+    memset(&server, 0, sizeof(server));
+    server.options = options;
+    server.epollFd = epoll_create1(EPOLL_CLOEXEC);
+    server.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    server.signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    server.listenFd = openListener(&server, options->listenAddress);
+    server.current = createInstance(graph, NULL, 0, options->threadCount);
+    pthread_mutex_init(&server.lock, NULL);
+    
+    int status = 0;
+    if (server.epollFd < 0 || server.wakeFd < 0 || server.signalFd < 0 || server.listenFd < 0 || !server.current ||
+        addWatch(&server, server.listenFd, &server.listenFd) != 0 || addWatch(&server, server.wakeFd, &server.wakeFd) != 0 ||
+        addWatch(&server, server.signalFd, &server.signalFd) != 0) {
+        fprintf(stderr, "无法启动服务: %s\n", server.listenFd < 0 ? "无法监听该地址" : strerror(errno));
+        status = -1;
+    } else {
+        fprintf(stderr, "路由服务已启动: %s（%d 个查询线程，%d 个节点）\n", options->listenAddress,
+                server.current->engine->threadCount, graph->nodeCount);
+        runEventLoop(&server);
+        fprintf(stderr, "路由服务已停止（共 %lld 个请求，%lld 个超时）\n", server.requestCount, server.timeoutCount);
+    }
+    
+    // 关闭连接后再销毁查询引擎（等待在途的搜索完成），最后释放完成队列中的请求
+    while (server.connectionCount > 0) {
+        closeConnection(&server, server.connections[0]);
+    }
+    if (server.reloading) {
+        pthread_join(server.reloadThread, NULL);
+        destroyInstance(server.reloaded);
+    }
+    destroyInstance(server.current);
+    for (int i = 0; i < server.retiredCount; i++) {
+        destroyInstance(server.retired[i]);
+    }
+    ServerRequest* request = server.completed;
+    while (request) {
+        ServerRequest* next = request->nextCompleted;
+        freeRequest(request);
+        request = next;
+    }
+    
+    if (server.listenFd >= 0) close(server.listenFd);
+    if (server.isUnixSocket) unlink(server.unixAddress.sun_path);
+    if (server.signalFd >= 0) close(server.signalFd);
+    if (server.wakeFd >= 0) close(server.wakeFd);
+    if (server.epollFd >= 0) close(server.epollFd);
+    pthread_mutex_destroy(&server.lock);
+    free(server.connections);
+    free(server.ready);
+    free(server.paused);
+    free(server.retired);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return status;
+}
+
+#else
+
+// epoll、eventfd和signalfd只在Linux上可用
+int runRoutingServer(Graph* graph, const ServerOptions* options) {
+    (void)graph;
+    (void)options;
+    fprintf(stderr, "路由服务只支持Linux\n");
+    return -1;
+}
+
+#endif
@@ -0,0 +1,415 @@
+#include "../include/snapshot.h"
+#include <stdint.h>
+
+#define SNAPSHOT_MAGIC "GRPHSNAP"
+#define SNAPSHOT_MAGIC_LEN 8
+#define SNAPSHOT_ENDIAN_TAG 0x01020304u
+
+// 每种交通方式的收缩层次占用的段
+enum {
+    HIERARCHY_RANK = 0,
+    HIERARCHY_ARCS,
+    HIERARCHY_UP_OFFSETS,
+    HIERARCHY_UP_EDGES,
+    HIERARCHY_DOWN_OFFSETS,
+    HIERARCHY_DOWN_EDGES,
+    HIERARCHY_SECTION_COUNT
+};
+
+// 段编号（按交通方式区分的数组各占MODE_COUNT个连续编号）
+enum {
+    SECTION_NODES = 0,
+    SECTION_EDGES,
+    SECTION_ADJ_HEAD,
+    SECTION_ADJ_NEXT,
+    SECTION_NAME_INDEX,
+    SECTION_EDGE_INDEX,
+    SECTION_CSR_OFFSETS,
+    SECTION_CSR_TARGETS,
+    SECTION_CSR_EDGE_IDS,
+    SECTION_CSR_WEIGHTS,
+    SECTION_EDGE_SLOT = SECTION_CSR_WEIGHTS + MODE_COUNT,
+    SECTION_RCSR_OFFSETS,
+    SECTION_RCSR_SOURCES,
+    SECTION_RCSR_EDGE_IDS,
+    SECTION_RCSR_WEIGHTS,
+    SECTION_EDGE_REVERSE_SLOT = SECTION_RCSR_WEIGHTS + MODE_COUNT,
+    SECTION_LANDMARKS,
+    SECTION_LANDMARK_DIST_TO,
+    SECTION_LANDMARK_DIST_FROM = SECTION_LANDMARK_DIST_TO + MODE_COUNT,
+    SECTION_HIERARCHIES = SECTION_LANDMARK_DIST_FROM + MODE_COUNT,
+    SECTION_COUNT = SECTION_HIERARCHIES + MODE_COUNT * HIERARCHY_SECTION_COUNT
+};
+
+// 段在文件中的位置
+typedef struct {
+    uint64_t offset;
+    uint64_t size;
+} SnapshotSection;
+
+// 文件头（按写入平台的字节序存放；名称索引中的哈希值依赖hashStringIgnoreCase，其实现变化时须提升版本）
+typedef struct {
+    char magic[SNAPSHOT_MAGIC_LEN];
+    uint32_t version;
+    uint32_t endianTag;
+    uint32_t headerSize;
+    uint32_t nodeSize;                          // 以下尺寸用于拒绝结构体布局不同的平台
+    uint32_t edgeSize;
+    uint32_t arcSize;
+    uint32_t queryEdgeSize;
+    uint32_t modeCount;
+    uint64_t fileSize;
+    
+    int32_t nodeCount;
+    int32_t edgeCount;
+    int32_t csrSlotCount;                       // CSR中的边数（被移除的边不在CSR中）
+    int32_t nameIndexCapacity;
+    int32_t edgeIndexCapacity;
+    int32_t landmarkCount;                      // 0表示没有地标
+    int32_t hierarchyPresent[MODE_COUNT];
+    int32_t hierarchyArcCount[MODE_COUNT];
+    int32_t hierarchyShortcutCount[MODE_COUNT];
+    int32_t hierarchyEdgeCount[MODE_COUNT];
+    int32_t hierarchyUpCount[MODE_COUNT];
+    int32_t hierarchyDownCount[MODE_COUNT];
+    
+    SnapshotSection sections[SECTION_COUNT];
+} SnapshotHeader;
+
+// 向上对齐到段边界
+static uint64_t alignSection(uint64_t position) {
+    return (position + GRAPH_SNAPSHOT_ALIGNMENT - 1) / GRAPH_SNAPSHOT_ALIGNMENT * GRAPH_SNAPSHOT_ALIGNMENT;
+}
+
+// 按文件头中的计数计算各段应有的字节数，计数非法时返回-1
+static int computeSectionSizes(const SnapshotHeader* header, uint64_t sizes[SECTION_COUNT]) {
+    if (header->nodeCount < 0 || header->edgeCount < 0 || header->csrSlotCount < 0 ||
+        header->csrSlotCount > header->edgeCount || header->nameIndexCapacity < 0 ||
+        header->edgeIndexCapacity < 0 || header->landmarkCount < 0 || header->landmarkCount > MAX_LANDMARKS) {
+        return -1;
+    }
+    
+    uint64_t n = (uint64_t)header->nodeCount;
+    uint64_t m = (uint64_t)header->edgeCount;
+    uint64_t slots = (uint64_t)header->csrSlotCount;
+    uint64_t k = (uint64_t)header->landmarkCount;
+    
+    memset(sizes, 0, SECTION_COUNT * sizeof(uint64_t));
+    sizes[SECTION_NODES] = n * sizeof(Node);
+    sizes[SECTION_EDGES] = m * sizeof(Edge);
+    sizes[SECTION_ADJ_HEAD] = n * sizeof(int);
+    sizes[SECTION_ADJ_NEXT] = m * sizeof(int);
+    sizes[SECTION_NAME_INDEX] = (uint64_t)header->nameIndexCapacity * sizeof(NameIndexSlot);
+    sizes[SECTION_EDGE_INDEX] = (uint64_t)header->edgeIndexCapacity * sizeof(EdgeIndexSlot);
+    sizes[SECTION_CSR_OFFSETS] = (n + 1) * sizeof(int);
+    sizes[SECTION_CSR_TARGETS] = slots * sizeof(int);
+    sizes[SECTION_CSR_EDGE_IDS] = slots * sizeof(int);
+    sizes[SECTION_EDGE_SLOT] = m * sizeof(int);
+    sizes[SECTION_RCSR_OFFSETS] = (n + 1) * sizeof(int);
+    sizes[SECTION_RCSR_SOURCES] = slots * sizeof(int);
+    sizes[SECTION_RCSR_EDGE_IDS] = slots * sizeof(int);
+    sizes[SECTION_EDGE_REVERSE_SLOT] = m * sizeof(int);
+    sizes[SECTION_LANDMARKS] = k * sizeof(int);
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        sizes[SECTION_CSR_WEIGHTS + mode] = slots * sizeof(int);
+        sizes[SECTION_RCSR_WEIGHTS + mode] = slots * sizeof(int);
+        sizes[SECTION_LANDMARK_DIST_TO + mode] = n * k * sizeof(int);
+        sizes[SECTION_LANDMARK_DIST_FROM + mode] = n * k * sizeof(int);
+        
+        if (!header->hierarchyPresent[mode]) continue;
+        if (header->hierarchyArcCount[mode] < 0 || header->hierarchyUpCount[mode] < 0 ||
+            header->hierarchyDownCount[mode] < 0) {
+            return -1;
+        }
+        uint64_t* hierarchy = &sizes[SECTION_HIERARCHIES + mode * HIERARCHY_SECTION_COUNT];
+        hierarchy[HIERARCHY_RANK] = n * sizeof(int);
+        hierarchy[HIERARCHY_ARCS] = (uint64_t)header->hierarchyArcCount[mode] * sizeof(CHArc);
+        hierarchy[HIERARCHY_UP_OFFSETS] = (n + 1) * sizeof(int);
+        hierarchy[HIERARCHY_UP_EDGES] = (uint64_t)header->hierarchyUpCount[mode] * sizeof(CHQueryEdge);
+        hierarchy[HIERARCHY_DOWN_OFFSETS] = (n + 1) * sizeof(int);
+        hierarchy[HIERARCHY_DOWN_EDGES] = (uint64_t)header->hierarchyDownCount[mode] * sizeof(CHQueryEdge);
+    }
+    return 0;
+}
+
+// 写入零字节直到文件位置到达target
+static int writePadding(FILE* fp, uint64_t* position, uint64_t target) {
+    static const char zeros[GRAPH_SNAPSHOT_ALIGNMENT] = { 0 };
+    while (*position < target) {
+        size_t chunk = (size_t)(target - *position);
+        if (chunk > sizeof(zeros)) chunk = sizeof(zeros);
+        if (fwrite(zeros, 1, chunk, fp) != chunk) return -1;
+        *position += chunk;
+    }
+    return 0;
+}
+
+// 保存快照
+int saveGraphSnapshot(const char* path, Graph* graph, const LandmarkSet* landmarks,
+                      ContractionHierarchy* const hierarchies[MODE_COUNT]) {
+    if (!isValidString(path) || !graph) return -1;
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return -1;
+    if (landmarks && landmarks->nodeCount != graph->nodeCount) return -1;
+    
+    int n = graph->nodeCount;
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN);
+    header.version = GRAPH_SNAPSHOT_VERSION;
+    header.endianTag = SNAPSHOT_ENDIAN_TAG;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.nodeSize = sizeof(Node);
+    header.edgeSize = sizeof(Edge);
+    header.arcSize = sizeof(CHArc);
+    header.queryEdgeSize = sizeof(CHQueryEdge);
+    header.modeCount = MODE_COUNT;
+    header.nodeCount = n;
+    header.edgeCount = graph->edgeCount;
+    header.csrSlotCount = graph->csrOffsets[n];
+    header.nameIndexCapacity = graph->nameIndexCapacity;
+    header.edgeIndexCapacity = graph->edgeIndexCapacity;
+    header.landmarkCount = landmarks ? landmarks->count : 0;
+    
+    // 各段的数据来源
+    const void* sources[SECTION_COUNT];
+    memset(sources, 0, sizeof(sources));
+    sources[SECTION_NODES] = graph->nodes;
+    sources[SECTION_EDGES] = graph->edges;
+    sources[SECTION_ADJ_HEAD] = graph->adjHead;
+    sources[SECTION_ADJ_NEXT] = graph->adjNext;
+    sources[SECTION_NAME_INDEX] = graph->nameIndex;
+    sources[SECTION_EDGE_INDEX] = graph->edgeIndex;
+    sources[SECTION_CSR_OFFSETS] = graph->csrOffsets;
+    sources[SECTION_CSR_TARGETS] = graph->csrTargets;
+    sources[SECTION_CSR_EDGE_IDS] = graph->csrEdgeIds;
+    sources[SECTION_EDGE_SLOT] = graph->edgeSlot;
+    sources[SECTION_RCSR_OFFSETS] = graph->rcsrOffsets;
+    sources[SECTION_RCSR_SOURCES] = graph->rcsrSources;
+    sources[SECTION_RCSR_EDGE_IDS] = graph->rcsrEdgeIds;
+    sources[SECTION_EDGE_REVERSE_SLOT] = graph->edgeReverseSlot;
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        sources[SECTION_CSR_WEIGHTS + mode] = graph->csrWeights[mode];
+        sources[SECTION_RCSR_WEIGHTS + mode] = graph->rcsrWeights[mode];
+        if (landmarks) {
+            sources[SECTION_LANDMARK_DIST_TO + mode] = landmarks->distTo[mode];
+            sources[SECTION_LANDMARK_DIST_FROM + mode] = landmarks->distFrom[mode];
+        }
+        
+        const ContractionHierarchy* ch = hierarchies ? hierarchies[mode] : NULL;
+        if (!ch) continue;
+        if ((int)ch->mode != mode || ch->nodeCount != n || ch->edgeCount != graph->edgeCount) return -1;
+        
+        header.hierarchyPresent[mode] = 1;
+        header.hierarchyArcCount[mode] = ch->arcCount;
+        header.hierarchyShortcutCount[mode] = ch->shortcutCount;
+        header.hierarchyEdgeCount[mode] = ch->edgeCount;
+        header.hierarchyUpCount[mode] = ch->upOffsets[n];
+        header.hierarchyDownCount[mode] = ch->downOffsets[n];
+        
+        const void** hierarchy = &sources[SECTION_HIERARCHIES + mode * HIERARCHY_SECTION_COUNT];
+        hierarchy[HIERARCHY_RANK] = ch->rank;
+        hierarchy[HIERARCHY_ARCS] = ch->arcs;
+        hierarchy[HIERARCHY_UP_OFFSETS] = ch->upOffsets;
+        hierarchy[HIERARCHY_UP_EDGES] = ch->upEdges;
+        hierarchy[HIERARCHY_DOWN_OFFSETS] = ch->downOffsets;
+        hierarchy[HIERARCHY_DOWN_EDGES] = ch->downEdges;
+    }
+    if (landmarks) sources[SECTION_LANDMARKS] = landmarks->landmarks;
+    
+    // 排布各段
+    uint64_t sizes[SECTION_COUNT];
+    if (computeSectionSizes(&header, sizes) != 0) return -1;
+    
+    uint64_t position = alignSection(sizeof(SnapshotHeader));
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        header.sections[i].offset = position;
+        header.sections[i].size = sizes[i];
+        position = alignSection(position + sizes[i]);
+    }
+    header.fileSize = position;
+    
+    // 写入临时文件后改名，避免截断其他进程正在映射的文件
+    size_t pathLength = strlen(path);
+    char* tempPath = (char*)safeMalloc(pathLength + 5);
+    memcpy(tempPath, path, pathLength);
+    memcpy(tempPath + pathLength, ".tmp", 5);
+    
+    FILE* fp = fopen(tempPath, "wb");
+    if (!fp) {
+        free(tempPath);
+        return -1;
+    }
+    
+    int failed = fwrite(&header, sizeof(header), 1, fp) != 1;
+    position = sizeof(header);
+    for (int i = 0; i < SECTION_COUNT && !failed; i++) {
+        failed = writePadding(fp, &position, header.sections[i].offset) != 0;
+        if (!failed && sizes[i] > 0) {
+            failed = fwrite(sources[i], 1, (size_t)sizes[i], fp) != (size_t)sizes[i];
+            position += sizes[i];
+        }
+    }
+    if (!failed) failed = writePadding(fp, &position, header.fileSize) != 0;
+    if (fclose(fp) != 0) failed = 1;
+
+#ifdef _WIN32
+    if (!failed) remove(path);  // Windows下rename不覆盖已有文件
+#endif
+    if (!failed && rename(tempPath, path) != 0) failed = 1;
+    if (failed) remove(tempPath);
+    free(tempPath);
+    return failed ? -1 : 0;
+}
+
+// 校验文件头和段表（只检查固定大小的元数据，与图的规模无关）
+static int validateHeader(const SnapshotHeader* header, size_t fileSize) {
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN) != 0 ||
+        header->version != GRAPH_SNAPSHOT_VERSION || header->endianTag != SNAPSHOT_ENDIAN_TAG ||
+        header->headerSize != sizeof(SnapshotHeader) || header->nodeSize != sizeof(Node) ||
+        header->edgeSize != sizeof(Edge) || header->arcSize != sizeof(CHArc) ||
+        header->queryEdgeSize != sizeof(CHQueryEdge) || header->modeCount != MODE_COUNT ||
+        header->fileSize != fileSize) {
+        return -1;
+    }
+    
+    uint64_t sizes[SECTION_COUNT];
+    if (computeSectionSizes(header, sizes) != 0) return -1;
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        const SnapshotSection* section = &header->sections[i];
+        if (section->size != sizes[i] || section->offset % GRAPH_SNAPSHOT_ALIGNMENT != 0 ||
+            section->offset < sizeof(SnapshotHeader) || section->offset > fileSize ||
+            section->size > fileSize - section->offset) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 打开快照
+GraphSnapshot* openGraphSnapshot(const char* path, ErrorCode* error) {
+    ErrorCode localError;
+    if (!error) error = &localError;
+    *error = ERR_NONE;
+    
+    MappedFile file;
+    if (!isValidString(path) || mapFileReadOnly(path, &file) != 0) {
+        *error = ERR_FILE_IO;
+        return NULL;
+    }
+    
+    const SnapshotHeader* header = (const SnapshotHeader*)file.data;
+    if (file.size < sizeof(SnapshotHeader) || validateHeader(header, file.size) != 0) {
+        unmapFile(&file);
+        *error = ERR_FILE_FORMAT;
+        return NULL;
+    }
+    
+    // 指针修正：图的数组直接指向映射内存（映射为只读，由isReadOnly阻止写入）
+    char* base = (char*)file.data;
+    #define SECTION_POINTER(type, id) ((type*)(void*)(base + header->sections[id].offset))
+    
+    int n = header->nodeCount;
+    if (SECTION_POINTER(int, SECTION_CSR_OFFSETS)[n] != header->csrSlotCount ||
+        SECTION_POINTER(int, SECTION_RCSR_OFFSETS)[n] != header->csrSlotCount) {
+        unmapFile(&file);
+        *error = ERR_FILE_FORMAT;
+        return NULL;
+    }
+    
+    Graph* graph = (Graph*)safeMalloc(sizeof(Graph));
+    memset(graph, 0, sizeof(Graph));
+    graph->nodeCount = n;
+    graph->edgeCount = header->edgeCount;
+    graph->nodeCapacity = n;
+    graph->edgeCapacity = header->edgeCount;
+    graph->nodes = SECTION_POINTER(Node, SECTION_NODES);
+    graph->edges = SECTION_POINTER(Edge, SECTION_EDGES);
+    graph->adjHead = SECTION_POINTER(int, SECTION_ADJ_HEAD);
+    graph->adjNext = SECTION_POINTER(int, SECTION_ADJ_NEXT);
+    graph->nameIndex = SECTION_POINTER(NameIndexSlot, SECTION_NAME_INDEX);
+    graph->nameIndexCapacity = header->nameIndexCapacity;
+    graph->edgeIndex = SECTION_POINTER(EdgeIndexSlot, SECTION_EDGE_INDEX);
+    graph->edgeIndexCapacity = header->edgeIndexCapacity;
+    graph->isFrozen = 1;
+    graph->csrOffsets = SECTION_POINTER(int, SECTION_CSR_OFFSETS);
+    graph->csrTargets = SECTION_POINTER(int, SECTION_CSR_TARGETS);
+    graph->csrEdgeIds = SECTION_POINTER(int, SECTION_CSR_EDGE_IDS);
+    graph->edgeSlot = SECTION_POINTER(int, SECTION_EDGE_SLOT);
+    graph->rcsrOffsets = SECTION_POINTER(int, SECTION_RCSR_OFFSETS);
+    graph->rcsrSources = SECTION_POINTER(int, SECTION_RCSR_SOURCES);
+    graph->rcsrEdgeIds = SECTION_POINTER(int, SECTION_RCSR_EDGE_IDS);
+    graph->edgeReverseSlot = SECTION_POINTER(int, SECTION_EDGE_REVERSE_SLOT);
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        graph->csrWeights[mode] = SECTION_POINTER(int, SECTION_CSR_WEIGHTS + mode);
+        graph->rcsrWeights[mode] = SECTION_POINTER(int, SECTION_RCSR_WEIGHTS + mode);
+    }
+    graph->isReadOnly = 1;
+    computeWeightPerMeter(graph);
+    
+    GraphSnapshot* snapshot = (GraphSnapshot*)safeMalloc(sizeof(GraphSnapshot));
+    snapshot->file = file;
+    snapshot->graph = graph;
+    snapshot->landmarks = NULL;
+    
+    if (header->landmarkCount > 0) {
+        LandmarkSet* set = (LandmarkSet*)safeMalloc(sizeof(LandmarkSet));
+        set->count = header->landmarkCount;
+        set->nodeCount = n;
+        set->landmarks = SECTION_POINTER(int, SECTION_LANDMARKS);
+        for (int mode = 0; mode < MODE_COUNT; mode++) {
+            set->distTo[mode] = SECTION_POINTER(int, SECTION_LANDMARK_DIST_TO + mode);
+            set->distFrom[mode] = SECTION_POINTER(int, SECTION_LANDMARK_DIST_FROM + mode);
+        }
+        snapshot->landmarks = set;
+    }
+    
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        snapshot->hierarchies[mode] = NULL;
+        if (!header->hierarchyPresent[mode]) continue;
+        
+        int first = SECTION_HIERARCHIES + mode * HIERARCHY_SECTION_COUNT;
+        ContractionHierarchy* ch = (ContractionHierarchy*)safeMalloc(sizeof(ContractionHierarchy));
+        ch->mode = (TransportMode)mode;
+        ch->nodeCount = n;
+        ch->edgeCount = header->hierarchyEdgeCount[mode];
+        ch->rank = SECTION_POINTER(int, first + HIERARCHY_RANK);
+        ch->arcs = SECTION_POINTER(CHArc, first + HIERARCHY_ARCS);
+        ch->arcCount = header->hierarchyArcCount[mode];
+        ch->shortcutCount = header->hierarchyShortcutCount[mode];
+        ch->upOffsets = SECTION_POINTER(int, first + HIERARCHY_UP_OFFSETS);
+        ch->upEdges = SECTION_POINTER(CHQueryEdge, first + HIERARCHY_UP_EDGES);
+        ch->downOffsets = SECTION_POINTER(int, first + HIERARCHY_DOWN_OFFSETS);
+        ch->downEdges = SECTION_POINTER(CHQueryEdge, first + HIERARCHY_DOWN_EDGES);
+        snapshot->hierarchies[mode] = ch;
+    }
+    #undef SECTION_POINTER
+    
+    return snapshot;
+}
+
+// 关闭快照（图上注册的监听者随图一起释放）
+void closeGraphSnapshot(GraphSnapshot* snapshot) {
+    if (!snapshot) return;
+    
+    destroyGraph(snapshot->graph);
+    free(snapshot->landmarks);
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        free(snapshot->hierarchies[mode]);
+    }
+    unmapFile(&snapshot->file);
+    free(snapshot);
+}
+
+// 文件是否以快照魔数开头
+int isGraphSnapshotFile(const char* path) {
+    if (!isValidString(path)) return 0;
+    
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    
+    char magic[SNAPSHOT_MAGIC_LEN];
+    int matched = fread(magic, 1, SNAPSHOT_MAGIC_LEN, fp) == SNAPSHOT_MAGIC_LEN &&
+                  memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN) == 0;
+    fclose(fp);
+    return matched;
+}
@@ -0,0 +1,312 @@
+#include "../include/spt.h"
+#include "../include/heap.h"
+#include "../include/utils.h"
+
+// ==================== 最短路径树 ====================
+
+// 构建单源最短路径树
+ShortestPathTree* buildShortestPathTree(Graph* graph, int source, TransportMode mode) {
+    if (!graph || !isValidNodeId(source, graph->nodeCount) || mode < 0 || mode >= MODE_COUNT) {
+        return NULL;
+    }
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return NULL;
+    
+    int n = graph->nodeCount;
+    ShortestPathTree* tree = (ShortestPathTree*)safeMalloc(sizeof(ShortestPathTree));
+    if (!tree) return NULL;
+    
+    tree->source = source;
+    tree->mode = mode;
+    tree->nodeCount = n;
+    tree->dist = (int*)safeMalloc((size_t)n * sizeof(int));
+    tree->prevNode = (int*)safeMalloc((size_t)n * sizeof(int));
+    tree->prevEdge = (int*)safeMalloc((size_t)n * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        tree->dist[v] = INF;
+        tree->prevNode[v] = -1;
+        tree->prevEdge[v] = -1;
+    }
+    
+    IndexedHeap* heap = createIndexedHeap(n);
+    if (!heap) {
+        destroyShortestPathTree(tree);
+        return NULL;
+    }
+    
+    // 与点对点Dijkstra一致：不活跃的节点不会被扩展，也不会被到达（起点除外）
+    const int* weights = graph->csrWeights[mode];
+    tree->dist[source] = 0;
+    indexedHeapPush(heap, source, 0);
+    while (!isIndexedHeapEmpty(heap)) {
+        int current = indexedHeapPop(heap, NULL);
+        if (!graph->nodes[current].isActive) continue;
+        
+        int currentDist = tree->dist[current];
+        int last = graph->csrOffsets[current + 1];
+        for (int i = graph->csrOffsets[current]; i < last; i++) {
+            int neighbor = graph->csrTargets[i];
+            int weight = weights[i];
+            
+            if (weight == INF || !graph->nodes[neighbor].isActive) continue;
+            
+            int newDist = currentDist + weight;
+            if (newDist < tree->dist[neighbor]) {
+                tree->dist[neighbor] = newDist;
+                tree->prevNode[neighbor] = current;
+                tree->prevEdge[neighbor] = graph->csrEdgeIds[i];
+                indexedHeapPush(heap, neighbor, newDist);
+            }
+        }
+    }
+    
+    destroyIndexedHeap(heap);
+    return tree;
+}
+
+// 销毁最短路径树
+void destroyShortestPathTree(ShortestPathTree* tree) {
+    if (!tree) return;
+    
+    free(tree->dist);
+    free(tree->prevNode);
+    free(tree->prevEdge);
+    free(tree);
+}
+
+// 沿前驱回溯路径
+PathResult* extractTreePath(const ShortestPathTree* tree, const Graph* graph, int target) {
+    if (!tree || !graph || !isValidNodeId(target, graph->nodeCount)) return NULL;
+    
+    PathResult* result = (PathResult*)safeMalloc(sizeof(PathResult));
+    if (!result) return NULL;
+    
+    result->path = NULL;
+    result->edges = NULL;
+    result->pathLength = 0;
+    result->totalDistance = 0;
+    result->totalTime = 0;
+    result->isValid = 0;
+    
+    if (target >= tree->nodeCount || tree->dist[target] == INF) return result;  // 不可达
+    
+    int pathLength = 1;
+    for (int v = target; tree->prevEdge[v] != -1; v = tree->prevNode[v]) {
+        pathLength++;
+    }
+    
+    result->path = (int*)safeMalloc((size_t)pathLength * sizeof(int));
+    result->edges = (int*)safeMalloc((size_t)maxInt(pathLength - 1, 1) * sizeof(int));
+    
+    int v = target;
+    for (int i = pathLength - 1; i > 0; i--) {
+        const Edge* edge = &graph->edges[tree->prevEdge[v]];
+        result->path[i] = v;
+        result->edges[i - 1] = tree->prevEdge[v];
+        result->totalDistance += edge->distance;
+        result->totalTime += edge->timeCost;
+        v = tree->prevNode[v];
+    }
+    result->path[0] = v;
+    result->pathLength = pathLength;
+    result->isValid = 1;
+    return result;
+}
+
+// ==================== 最短路径树缓存 ====================
+
+// 树中节点v的代价（构建后新增的节点视为不可达）
+static int treeDist(const ShortestPathTree* tree, int v) {
+    return v < tree->nodeCount ? tree->dist[v] : INF;
+}
+
+// 节点v是否被树到达并扩展过（不活跃的起点虽有代价但不扩展）
+static int isExpanded(const ShortestPathTree* tree, const Graph* graph, int v) {
+    return treeDist(tree, v) != INF && graph->nodes[v].isActive;
+}
+
+// 经过边edgeId能否得到比树中更短的路径（用于边权减小、边恢复通行或新增边）
+static int edgeImprovesTree(const ShortestPathTree* tree, const Graph* graph, int edgeId) {
+    const Edge* edge = &graph->edges[edgeId];
+    if (!edge->isAccessible || !graph->nodes[edge->to].isActive ||
+        !isExpanded(tree, graph, edge->from)) {
+        return 0;
+    }
+    return (long long)tree->dist[edge->from] + edge->modeWeight[tree->mode] < treeDist(tree, edge->to);
+}
+
+// 边edgeId是否为树边
+static int isTreeEdge(const ShortestPathTree* tree, const Graph* graph, int edgeId) {
+    int to = graph->edges[edgeId].to;
+    return to < tree->nodeCount && tree->prevEdge[to] == edgeId;
+}
+
+// 节点恢复可访问后树是否可能变化：它是起点，或存在从已扩展节点进入它的可通行边
+static int nodeImprovesTree(const ShortestPathTree* tree, const Graph* graph, int nodeId) {
+    if (nodeId == tree->source) return 1;
+    
+    if (graph->isFrozen) {
+        for (int i = graph->rcsrOffsets[nodeId]; i < graph->rcsrOffsets[nodeId + 1]; i++) {
+            if (graph->rcsrWeights[tree->mode][i] != INF && isExpanded(tree, graph, graph->rcsrSources[i])) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    
+    for (int e = 0; e < graph->edgeCount; e++) {
+        const Edge* edge = &graph->edges[e];
+        if (edge->to == nodeId && edge->isAccessible && isExpanded(tree, graph, edge->from)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 一次图修改后树是否可能不再正确
+static int isTreeAffected(const ShortestPathTree* tree, const Graph* graph, const GraphChange* change) {
+    switch (change->type) {
+        case GRAPH_CHANGE_NODE_ADDED:
+            return 0;  // 孤立的新节点不影响已有路径
+        case GRAPH_CHANGE_EDGE_ADDED:
+            return edgeImprovesTree(tree, graph, change->edgeId);
+        case GRAPH_CHANGE_EDGE_WEIGHT:
+            if (change->mode != tree->mode) return 0;
+            if (change->newValue > change->oldValue) return isTreeEdge(tree, graph, change->edgeId);
+            return edgeImprovesTree(tree, graph, change->edgeId);
+        case GRAPH_CHANGE_EDGE_ACCESS:
+            if (!change->newValue) return isTreeEdge(tree, graph, change->edgeId);
+            return edgeImprovesTree(tree, graph, change->edgeId);
+        case GRAPH_CHANGE_NODE_ACCESS:
+            if (!change->newValue) return treeDist(tree, change->nodeId) != INF;
+            return nodeImprovesTree(tree, graph, change->nodeId);
+    }
+    return 1;
+}
+
+// 移除第slot棵树（与最后一棵交换）
+static void removeCachedTree(SPTCache* cache, int slot) {
+    destroyShortestPathTree(cache->trees[slot]);
+    cache->count--;
+    cache->trees[slot] = cache->trees[cache->count];
+    cache->lastUsed[slot] = cache->lastUsed[cache->count];
+}
+
+// 图变化监听：淘汰受影响的树
+static void onGraphChange(Graph* graph, const GraphChange* change, void* userData) {
+    SPTCache* cache = (SPTCache*)userData;
+    
+    for (int i = cache->count - 1; i >= 0; i--) {
+        if (isTreeAffected(cache->trees[i], graph, change)) {
+            removeCachedTree(cache, i);
+            cache->invalidations++;
+        }
+    }
+}
+
+// 创建缓存并注册图变化监听
+SPTCache* createSPTCache(Graph* graph, int capacity) {
+    if (!graph) return NULL;
+    
+    SPTCache* cache = (SPTCache*)safeMalloc(sizeof(SPTCache));
+    if (!cache) return NULL;
+    
+    if (capacity <= 0) capacity = DEFAULT_SPT_CACHE_CAPACITY;
+    
+    cache->graph = graph;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->trees = (ShortestPathTree**)safeMalloc((size_t)capacity * sizeof(ShortestPathTree*));
+    cache->lastUsed = (unsigned long long*)safeMalloc((size_t)capacity * sizeof(unsigned long long));
+    cache->clock = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->invalidations = 0;
+    
+    if (addGraphListener(graph, onGraphChange, cache) != 0) {
+        free(cache->trees);
+        free(cache->lastUsed);
+        free(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+// 销毁缓存（须在图销毁之前调用）
+void destroySPTCache(SPTCache* cache) {
+    if (!cache) return;
+    
+    removeGraphListener(cache->graph, onGraphChange, cache);
+    clearSPTCache(cache);
+    free(cache->trees);
+    free(cache->lastUsed);
+    free(cache);
+}
+
+// 清空缓存
+void clearSPTCache(SPTCache* cache) {
+    if (!cache) return;
+    
+    for (int i = 0; i < cache->count; i++) {
+        destroyShortestPathTree(cache->trees[i]);
+    }
+    cache->count = 0;
+}
+
+// 取得最短路径树
+const ShortestPathTree* getCachedTree(SPTCache* cache, int source, TransportMode mode) {
+    if (!cache) return NULL;
+    
+    for (int i = 0; i < cache->count; i++) {
+        ShortestPathTree* tree = cache->trees[i];
+        if (tree->source == source && tree->mode == mode) {
+            cache->lastUsed[i] = ++cache->clock;
+            cache->hits++;
+            return tree;
+        }
+    }
+    
+    ShortestPathTree* tree = buildShortestPathTree(cache->graph, source, mode);
+    if (!tree) return NULL;
+    cache->misses++;
+    
+    // 容量已满时淘汰最久未用的树
+    int slot = cache->count;
+    if (cache->count == cache->capacity) {
+        slot = 0;
+        for (int i = 1; i < cache->count; i++) {
+            if (cache->lastUsed[i] < cache->lastUsed[slot]) slot = i;
+        }
+        destroyShortestPathTree(cache->trees[slot]);
+    } else {
+        cache->count++;
+    }
+    
+    cache->trees[slot] = tree;
+    cache->lastUsed[slot] = ++cache->clock;
+    return tree;
+}
+
+// 经缓存查找路径
+PathResult* findPathCached(SPTCache* cache, int start, int end, TransportMode mode) {
+    if (!cache || !isValidNodeId(end, cache->graph->nodeCount)) return NULL;
+    
+    const ShortestPathTree* tree = getCachedTree(cache, start, mode);
+    if (!tree) return NULL;
+    return extractTreePath(tree, cache->graph, end);
+}
+
+// 根据名称经缓存查找路径
+PathResult* findPathByNameCached(SPTCache* cache, const char* startName, const char* endName, TransportMode mode) {
+    if (!cache || !isValidString(startName) || !isValidString(endName)) {
+        return NULL;
+    }
+    
+    int startId = findNodeByName(cache->graph, startName);
+    int endId = findNodeByName(cache->graph, endName);
+    
+    if (startId == -1 || endId == -1) {
+        return NULL;
+    }
+    
+    return findPathCached(cache, startId, endId, mode);
+}
@@ -0,0 +1,434 @@
+#include "../include/timedep.h"
+#include "../include/utils.h"
+
+#define TIME_PROFILE_INITIAL_CAPACITY 16
+
+// 用边的最小行程时间更新启发式系数（系数只降不升，始终是所有边的下界）
+static void lowerSecondsPerMeter(TimeProfileSet* set, const Graph* graph, int edgeId, int minTravelTime) {
+    const Edge* edge = &graph->edges[edgeId];
+    double length = straightLineDistance(graph, edge->from, edge->to);
+    if (length <= 0.0) return;
+    
+    double ratio = maxInt(minTravelTime, 0) / length;
+    if (set->secondsPerMeter < 0.0 || ratio < set->secondsPerMeter) set->secondsPerMeter = ratio;
+}
+
+// 向下取整的整数除法（divisor > 0）
+static inline long long floorDivide(long long dividend, long long divisor) {
+    long long quotient = dividend / divisor;
+    if (dividend % divisor != 0 && dividend < 0) quotient--;
+    return quotient;
+}
+
+// 剖面在一天中时刻x的行程时间：先定位x所在的区间，再线性插值（向下取整，保持FIFO）
+static inline int evaluateProfileAt(const TimeProfileSet* set, int profile, int x) {
+    const TimeBreakpoint* points = set->points + set->profileOffsets[profile];
+    int count = set->profileOffsets[profile + 1] - set->profileOffsets[profile];  // 含哨兵，至少为2
+    int k = 0;
+    
+    if (count <= TIME_PROFILE_SCAN_LIMIT) {
+        // 哨兵的时刻为周期，循环必然终止
+        while (points[k + 1].time <= x) k++;
+    } else {
+        // 保持 points[low].time <= x < points[high].time
+        int low = 0;
+        int high = count - 1;
+        while (high - low > 1) {
+            int middle = (low + high) / 2;
+            if (points[middle].time <= x) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        k = low;
+    }
+    
+    const TimeBreakpoint* a = &points[k];
+    const TimeBreakpoint* b = &points[k + 1];
+    long long rise = (long long)(b->travelTime - a->travelTime) * (x - a->time);
+    return a->travelTime + (int)floorDivide(rise, b->time - a->time);
+}
+
+// 创建剖面集合
+TimeProfileSet* createTimeProfileSet(Graph* graph) {
+    if (!graph) return NULL;
+    if (!graph->isFrozen && freezeGraph(graph) != 0) return NULL;
+    
+    TimeProfileSet* set = (TimeProfileSet*)safeMalloc(sizeof(TimeProfileSet));
+    set->nodeCount = graph->nodeCount;
+    set->edgeCount = graph->edgeCount;
+    set->slotCount = graph->csrOffsets[graph->nodeCount];
+    set->edgeProfile = (int*)safeMalloc((size_t)maxInt(graph->edgeCount, 1) * sizeof(int));
+    set->arcs = (TimeArc*)safeMalloc((size_t)maxInt(set->slotCount, 1) * sizeof(TimeArc));
+    set->profileCapacity = TIME_PROFILE_INITIAL_CAPACITY;
+    set->profileCount = 0;
+    set->profileOffsets = (int*)safeMalloc((size_t)(set->profileCapacity + 1) * sizeof(int));
+    set->profileOffsets[0] = 0;
+    set->pointCapacity = TIME_PROFILE_INITIAL_CAPACITY;
+    set->pointCount = 0;
+    set->points = (TimeBreakpoint*)safeMalloc((size_t)set->pointCapacity * sizeof(TimeBreakpoint));
+    set->secondsPerMeter = -1.0;
+    
+    for (int e = 0; e < graph->edgeCount; e++) {
+        set->edgeProfile[e] = -1;
+        lowerSecondsPerMeter(set, graph, e, graph->edges[e].timeCost);
+    }
+    for (int i = 0; i < set->slotCount; i++) {
+        set->arcs[i].profile = -1;
+        set->arcs[i].timeCost = graph->edges[graph->csrEdgeIds[i]].timeCost;
+    }
+    
+    // 没有长度为正的边时启发式恒为0
+    if (set->secondsPerMeter < 0.0) set->secondsPerMeter = 0.0;
+    return set;
+}
+
+// 销毁剖面集合
+void destroyTimeProfileSet(TimeProfileSet* set) {
+    if (!set) return;
+    
+    free(set->edgeProfile);
+    free(set->arcs);
+    free(set->profileOffsets);
+    free(set->points);
+    free(set);
+}
+
+// 添加剖面（校验后连同哨兵断点追加到断点池）
+int addTimeProfile(TimeProfileSet* set, const TimeBreakpoint* points, int count) {
+    if (!set || !points || count < 1 || count > TIME_PROFILE_MAX_POINTS || points[0].time != 0) return -1;
+    
+    for (int i = 0; i < count; i++) {
+        if (points[i].time >= TIME_PROFILE_PERIOD || points[i].travelTime < 0 || points[i].travelTime >= INF / 4) {
+            return -1;
+        }
+        
+        // 下一个断点（最后一个断点之后是下一周期的时刻0）
+        long long nextTime = i + 1 < count ? points[i + 1].time : TIME_PROFILE_PERIOD;
+        long long nextTravel = i + 1 < count ? points[i + 1].travelTime : points[0].travelTime;
+        if (nextTime <= points[i].time) return -1;
+        
+        // FIFO：到达时刻 time + travelTime 不随出发时刻减小
+        if (nextTime + nextTravel < points[i].time + (long long)points[i].travelTime) return -1;
+    }
+    
+    if (set->profileCount == set->profileCapacity) {
+        set->profileCapacity *= 2;
+        set->profileOffsets = (int*)safeRealloc(set->profileOffsets, (size_t)(set->profileCapacity + 1) * sizeof(int));
+    }
+    if (set->pointCount + count + 1 > set->pointCapacity) {
+        int capacity = set->pointCapacity;
+        while (set->pointCount + count + 1 > capacity) capacity *= 2;
+        set->points = (TimeBreakpoint*)safeRealloc(set->points, (size_t)capacity * sizeof(TimeBreakpoint));
+        set->pointCapacity = capacity;
+    }
+    
+    memcpy(set->points + set->pointCount, points, (size_t)count * sizeof(TimeBreakpoint));
+    set->pointCount += count;
+    set->points[set->pointCount].time = TIME_PROFILE_PERIOD;
+    set->points[set->pointCount].travelTime = points[0].travelTime;
+    set->pointCount++;
+    
+    set->profileOffsets[++set->profileCount] = set->pointCount;
+    return set->profileCount - 1;
+}
+
+// 为边指定剖面
+int setEdgeTimeProfile(TimeProfileSet* set, const Graph* graph, int edgeId, int profileId) {
+    if (!set || !graph || set->edgeCount != graph->edgeCount || edgeId < 0 || edgeId >= set->edgeCount ||
+        profileId < -1 || profileId >= set->profileCount) {
+        return -1;
+    }
+    
+    set->edgeProfile[edgeId] = profileId;
+    int slot = graph->edgeSlot[edgeId];
+    if (slot >= 0) set->arcs[slot].profile = profileId;
+    
+    if (profileId >= 0) {
+        int minTravelTime = INF;
+        for (int i = set->profileOffsets[profileId]; i < set->profileOffsets[profileId + 1]; i++) {
+            minTravelTime = minInt(minTravelTime, set->points[i].travelTime);
+        }
+        lowerSecondsPerMeter(set, graph, edgeId, minTravelTime);
+    }
+    return 0;
+}
+
+// 剖面在出发时刻的行程时间
+int evaluateTimeProfile(const TimeProfileSet* set, int profileId, int departureTime) {
+    if (!set || profileId < 0 || profileId >= set->profileCount || departureTime < 0) return INF;
+    return evaluateProfileAt(set, profileId, departureTime % TIME_PROFILE_PERIOD);
+}
+
+// 边在出发时刻的行程时间
+int getEdgeTravelTime(const TimeProfileSet* set, const Graph* graph, int edgeId, int departureTime) {
+    if (!set || !graph || edgeId < 0 || edgeId >= set->edgeCount || edgeId >= graph->edgeCount ||
+        departureTime < 0) {
+        return INF;
+    }
+    
+    int profile = set->edgeProfile[edgeId];
+    if (profile < 0) return graph->edges[edgeId].timeCost;
+    return evaluateProfileAt(set, profile, departureTime % TIME_PROFILE_PERIOD);
+}
+
+// ==================== 剖面文件 ====================
+
+static int profileLoadError(GraphLoadStatus* status, ErrorCode error, int line, const char* message,
+                            const char* detail) {
+    status->error = error;
+    status->line = line;
+    if (detail) {
+        snprintf(status->message, LOADER_MESSAGE_LEN, "%s: %.64s", message, detail);
+    } else {
+        snprintf(status->message, LOADER_MESSAGE_LEN, "%s", message);
+    }
+    return -1;
+}
+
+// 解析"<时刻>:<行程时间>"
+static int parseBreakpoint(const char* text, TimeBreakpoint* point) {
+    char* end;
+    long time = strtol(text, &end, 10);
+    if (end == text || *end != ':') return -1;
+    
+    const char* value = end + 1;
+    long travelTime = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || time < 0 || time >= TIME_PROFILE_PERIOD ||
+        travelTime < 0 || travelTime >= INF / 4) {
+        return -1;
+    }
+    
+    point->time = (int)time;
+    point->travelTime = (int)travelTime;
+    return 0;
+}
+
+// 从文本文件读取剖面
+int loadTimeProfiles(TimeProfileSet* set, Graph* graph, const char* path, GraphLoadStatus* status) {
+    if (!status) return -1;
+    status->error = ERR_NONE;
+    status->line = 0;
+    status->message[0] = '\0';
+    status->nodeCount = 0;
+    status->edgeCount = 0;
+    
+    if (!set || !graph || !path || set->edgeCount != graph->edgeCount) {
+        return profileLoadError(status, ERR_INVALID_INPUT, 0, "参数无效或剖面与图不匹配", NULL);
+    }
+    FILE* file = fopen(path, "r");
+    if (!file) return profileLoadError(status, ERR_FILE_IO, 0, "无法打开文件", path);
+    
+    char* line = (char*)safeMalloc(TIME_PROFILE_LINE_LEN);
+    TimeBreakpoint* points = (TimeBreakpoint*)safeMalloc(TIME_PROFILE_MAX_POINTS * sizeof(TimeBreakpoint));
+    int lineNumber = 0;
+    int result = 0;
+    
+    while (fgets(line, TIME_PROFILE_LINE_LEN, file)) {
+        lineNumber++;
+        if (!strchr(line, '\n') && !feof(file)) {
+            result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber, "行过长", NULL);
+            break;
+        }
+        
+        char* keyword = strtok(line, " \t\r\n");
+        if (!keyword || keyword[0] == '#') continue;
+        if (strcmp(keyword, "PROFILE") != 0) {
+            result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber, "未知的记录类型", keyword);
+            break;
+        }
+        
+        char* fromName = strtok(NULL, " \t\r\n");
+        char* toName = strtok(NULL, " \t\r\n");
+        if (!fromName || !toName) {
+            result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber, "PROFILE需要起点、终点和至少一个断点", NULL);
+            break;
+        }
+        int from = findNodeByName(graph, fromName);
+        int to = findNodeByName(graph, toName);
+        int edgeId = from == -1 || to == -1 ? -1 : findEdge(graph, from, to);
+        if (edgeId == -1) {
+            result = profileLoadError(status, ERR_EDGE_NOT_FOUND, lineNumber, "边不存在",
+                                      from == -1 ? fromName : toName);
+            break;
+        }
+        
+        int count = 0;
+        char* token;
+        while ((token = strtok(NULL, " \t\r\n")) != NULL) {
+            if (count == TIME_PROFILE_MAX_POINTS) {
+                result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber, "断点过多", NULL);
+                break;
+            }
+            if (parseBreakpoint(token, &points[count]) != 0) {
+                result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber, "无效的断点", token);
+                break;
+            }
+            count++;
+        }
+        if (result != 0) break;
+        
+        int profile = addTimeProfile(set, points, count);
+        if (profile < 0) {
+            result = profileLoadError(status, ERR_FILE_FORMAT, lineNumber,
+                                      "剖面无效（须从时刻0开始、时刻递增且满足FIFO）", NULL);
+            break;
+        }
+        setEdgeTimeProfile(set, graph, edgeId, profile);
+        status->edgeCount++;
+    }
+    
+    if (result == 0 && ferror(file)) result = profileLoadError(status, ERR_FILE_IO, lineNumber, "读取失败", NULL);
+    free(points);
+    free(line);
+    fclose(file);
+    return result;
+}
+
+// ==================== 时间相关的搜索 ====================
+
+// 剩余行程时间的下界
+static inline int timeHeuristic(const Graph* graph, const TimeProfileSet* profiles, int from, int to) {
+    double bound = profiles->secondsPerMeter * straightLineDistance(graph, from, to);
+    return bound < INF / 4 ? (int)bound : INF / 4;
+}
+
+// 时间相关搜索核心：标签为到达时刻，扫描出边时按到达当前节点的时刻查剖面。
+// FIFO保证Dijkstra中已确定的节点不会再改进；A*在浮点误差使启发式略不一致时重新打开节点
+static int runTimeDependent(SearchWorkspace* ws, Graph* graph, const TimeProfileSet* profiles, int start, int end,
+                            TransportMode mode, int departureTime, int useHeuristic) {
+    if (!ws || !graph || !profiles || !isValidNodeId(start, graph->nodeCount) ||
+        !isValidNodeId(end, graph->nodeCount) || departureTime < 0 || departureTime >= INF / 2 ||
+        !graph->isFrozen || profiles->nodeCount != graph->nodeCount || profiles->edgeCount != graph->edgeCount ||
+        profiles->slotCount != graph->csrOffsets[graph->nodeCount]) {
+        return -1;
+    }
+    if (beginSearch(ws, graph) != 0) return -1;
+    
+    SearchLabels* labels = &ws->forward;
+    const int* targets = graph->csrTargets;
+    const int* weights = graph->csrWeights[mode];
+    const TimeArc* arcs = profiles->arcs;
+    
+    setLabel(labels, start, departureTime, -1);
+    indexedHeapPush(labels->heap, start, departureTime + (useHeuristic ? timeHeuristic(graph, profiles, start, end) : 0));
+    SEARCH_STAT_PUSH(ws, labels->heap->size);
+    
+    while (!isIndexedHeapEmpty(labels->heap)) {
+        int current = indexedHeapPop(labels->heap, NULL);
+        
+        if (isSettled(labels, current) || !graph->nodes[current].isActive) {
+            SEARCH_STAT_ADD(ws, stalePops, 1);
+            continue;
+        }
+        markSettled(labels, current);
+        SEARCH_STAT_ADD(ws, settledNodes, 1);
+        
+        if (current == end) break;
+        
+        int arrival = labels->dist[current];
+        int timeOfDay = arrival % TIME_PROFILE_PERIOD;
+        int last = graph->csrOffsets[current + 1];
+        SEARCH_STAT_ADD(ws, relaxedEdges, last - graph->csrOffsets[current]);
+        
+        for (int i = graph->csrOffsets[current]; i < last; i++) {
+            int neighbor = targets[i];
+            if (weights[i] == INF || !graph->nodes[neighbor].isActive) continue;
+            
+            int travelTime = arcs[i].profile < 0 ? arcs[i].timeCost : evaluateProfileAt(profiles, arcs[i].profile, timeOfDay);
+            int newArrival = arrival + travelTime;
+            if (newArrival < labelDist(labels, neighbor)) {
+                labels->settled[neighbor] = 0;  // 0永远不等于当前代数
+                setLabel(labels, neighbor, newArrival, graph->csrEdgeIds[i]);
+                indexedHeapPush(labels->heap, neighbor,
+                                newArrival + (useHeuristic ? timeHeuristic(graph, profiles, neighbor, end) : 0));
+                SEARCH_STAT_PUSH(ws, labels->heap->size);
+            }
+        }
+    }
+    
+    SEARCH_STAT_FINISH(ws);
+    return 0;
+}
+
+// 沿前驱边回溯写出路径，totalTime为到达时刻减去出发时刻
+static int writeTimeDependentResult(SearchWorkspace* ws, Graph* graph, int end, int departureTime,
+                                    const PathBuffer* buffer, PathResult* result) {
+    result->path = NULL;
+    result->edges = NULL;
+    result->pathLength = 0;
+    result->totalDistance = 0;
+    result->totalTime = 0;
+    result->isValid = 0;
+    
+    int arrival = labelDist(&ws->forward, end);
+    if (arrival == INF) return 0;  // 无路径
+    
+    const int* prevEdge = ws->forward.prevEdge;
+    int pathLength = 1;
+    for (int v = end; prevEdge[v] != -1; v = graph->edges[prevEdge[v]].from) {
+        pathLength++;
+    }
+    
+    int* path;
+    int* edges;
+    if (reservePathStorage(ws, buffer, pathLength, &path, &edges) != 0) {
+        result->pathLength = pathLength;
+        return -2;
+    }
+    
+    int v = end;
+    for (int i = pathLength - 1; i > 0; i--) {
+        int edgeId = prevEdge[v];
+        path[i] = v;
+        if (edges) edges[i - 1] = edgeId;
+        result->totalDistance += graph->edges[edgeId].distance;
+        v = graph->edges[edgeId].from;
+    }
+    path[0] = v;
+    
+    result->path = path;
+    result->edges = edges;
+    result->pathLength = pathLength;
+    result->totalTime = arrival - departureTime;
+    result->isValid = 1;
+    return 0;
+}
+
+// 时间相关的Dijkstra
+int timeDependentDijkstraSearch(SearchWorkspace* ws, Graph* graph, const TimeProfileSet* profiles,
+                                int start, int end, TransportMode mode, int departureTime,
+                                const PathBuffer* buffer, PathResult* result) {
+    if (!result) return -1;
+    if (runTimeDependent(ws, graph, profiles, start, end, mode, departureTime, 0) != 0) return -1;
+    return writeTimeDependentResult(ws, graph, end, departureTime, buffer, result);
+}
+
+// 时间相关的A*
+int timeDependentAStarSearch(SearchWorkspace* ws, Graph* graph, const TimeProfileSet* profiles,
+                             int start, int end, TransportMode mode, int departureTime,
+                             const PathBuffer* buffer, PathResult* result) {
+    if (!result) return -1;
+    if (runTimeDependent(ws, graph, profiles, start, end, mode, departureTime, 1) != 0) return -1;
+    return writeTimeDependentResult(ws, graph, end, departureTime, buffer, result);
+}
+
+// 使用临时工作区查询并返回独立分配的结果
+PathResult* findTimeDependentPath(Graph* graph, const TimeProfileSet* profiles, int start, int end,
+                                  TransportMode mode, int departureTime, PathAlgorithm algorithm) {
+    if (!graph || (algorithm != ALGO_DIJKSTRA && algorithm != ALGO_ASTAR)) return NULL;
+    
+    SearchWorkspace* ws = createSearchWorkspace(graph->nodeCount);
+    if (!ws) return NULL;
+    
+    PathResult* result = NULL;
+    PathResult local;
+    if (runTimeDependent(ws, graph, profiles, start, end, mode, departureTime, algorithm == ALGO_ASTAR) == 0 &&
+        writeTimeDependentResult(ws, graph, end, departureTime, NULL, &local) == 0) {
+        result = copyPathResult(&local);
+    }
+    
+    destroySearchWorkspace(ws);
+    return result;
+}
@@ -1,5 +1,15 @@
 #include "../include/utils.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#endif
+
 // 输入验证函数
 int isValidNodeId(int nodeId, int maxNodes) {
     return nodeId >= 0 && nodeId < maxNodes;
@@ -35,34 +45,34 @@ void toLowerCase(char* str) {
     if (!str) return;
     
     for (int i = 0; str[i]; i++) {
-        str[i] = tolower(str[i]);
+        str[i] = (char)tolower((unsigned char)str[i]);
     }
 }
 
 int stringCompareIgnoreCase(const char* str1, const char* str2) {
     if (!str1 || !str2) return -1;
     
-    char* temp1 = (char*)safeMalloc(strlen(str1) + 1);
-    char* temp2 = (char*)safeMalloc(strlen(str2) + 1);
-    
-    if (!temp1 || !temp2) {
-        free(temp1);
-        free(temp2);
-        return -1;
+    // 逐字符折叠比较，无需分配临时副本
+    const unsigned char* p1 = (const unsigned char*)str1;
+    const unsigned char* p2 = (const unsigned char*)str2;
+    while (*p1 && tolower(*p1) == tolower(*p2)) {
+        p1++;
+        p2++;
     }
     
-    strcpy(temp1, str1);
-    strcpy(temp2, str2);
-    
-    toLowerCase(temp1);
-    toLowerCase(temp2);
-    
-    int result = strcmp(temp1, temp2);
-    
-    free(temp1);
-    free(temp2);
+    return tolower(*p1) - tolower(*p2);
+}
+
+// 大小写折叠后的FNV-1a哈希，与stringCompareIgnoreCase的相等判定一致
+unsigned int hashStringIgnoreCase(const char* str) {
+    unsigned int hash = 2166136261u;
+    if (!str) return hash;
     
-    return result;
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        hash ^= (unsigned int)tolower(*p);
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
 // 数学工具函数
@@ -101,6 +111,97 @@ void* safeRealloc(void* ptr, size_t size) {
     return newPtr;
 }
 
+// 获取可用的处理器核数（无法获取时返回1）
+int getProcessorCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+// 单调时钟读数（秒）
+double getTimeSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+// 以只读方式映射整个文件，返回0表示成功
+int mapFileReadOnly(const char* path, MappedFile* file) {
+    if (!path || !file) return -1;
+    
+    file->data = NULL;
+    file->size = 0;
+    
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return -1;
+    
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return -1;
+    }
+    file->size = (size_t)size.QuadPart;
+    
+    if (file->size > 0) {
+        HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            file->data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(handle);
+    return (file->size == 0 || file->data) ? 0 : -1;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    file->size = (size_t)info.st_size;
+    
+    if (file->size > 0) {
+        void* data = mmap(NULL, file->size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        file->data = (const char*)data;
+    }
+    close(fd);  // 映射在关闭文件后依然有效
+    return 0;
+#endif
+}
+
+// 解除文件映射
+void unmapFile(MappedFile* file) {
+    if (!file || !file->data) return;
+    
+#ifdef _WIN32
+    UnmapViewOfFile(file->data);
+#else
+    munmap((void*)file->data, file->size);
+#endif
+    file->data = NULL;
+    file->size = 0;
+}
+
 // 错误处理
 const char* getErrorMessage(ErrorCode error) {
     switch (error) {
@@ -118,6 +219,10 @@ const char* getErrorMessage(ErrorCode error) {
             return "图已满";
         case ERR_PATH_NOT_FOUND:
             return "路径未找到";
+        case ERR_FILE_IO:
+            return "文件读取失败";
+        case ERR_FILE_FORMAT:
+            return "文件格式错误";
         default:
             return "未知错误";
     }
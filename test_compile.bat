@@ -28,6 +28,126 @@ if errorlevel 1 (
     exit /b 1
 )
 
+echo 编译 heap.c...
+gcc -std=c99 -Iinclude -c src/heap.c -o heap.o
+if errorlevel 1 (
+    echo heap.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 ch.c...
+gcc -std=c99 -Iinclude -c src/ch.c -o ch.o
+if errorlevel 1 (
+    echo ch.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 landmarks.c...
+gcc -std=c99 -Iinclude -c src/landmarks.c -o landmarks.o
+if errorlevel 1 (
+    echo landmarks.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 matrix.c...
+gcc -std=c99 -Iinclude -c src/matrix.c -o matrix.o
+if errorlevel 1 (
+    echo matrix.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 engine.c...
+gcc -std=c99 -Iinclude -c src/engine.c -o engine.o
+if errorlevel 1 (
+    echo engine.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 spt.c...
+gcc -std=c99 -Iinclude -c src/spt.c -o spt.o
+if errorlevel 1 (
+    echo spt.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 routecache.c...
+gcc -std=c99 -Iinclude -c src/routecache.c -o routecache.o
+if errorlevel 1 (
+    echo routecache.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 dynspt.c...
+gcc -std=c99 -Iinclude -c src/dynspt.c -o dynspt.o
+if errorlevel 1 (
+    echo dynspt.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 loader.c...
+gcc -std=c99 -Iinclude -c src/loader.c -o loader.o
+if errorlevel 1 (
+    echo loader.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 snapshot.c...
+gcc -std=c99 -Iinclude -c src/snapshot.c -o snapshot.o
+if errorlevel 1 (
+    echo snapshot.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 generator.c...
+gcc -std=c99 -Iinclude -c src/generator.c -o generator.o
+if errorlevel 1 (
+    echo generator.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 batch.c...
+gcc -std=c99 -Iinclude -c src/batch.c -o batch.o
+if errorlevel 1 (
+    echo batch.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 server.c...
+gcc -std=c99 -Iinclude -c src/server.c -o server.o
+if errorlevel 1 (
+    echo server.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 timedep.c...
+gcc -std=c99 -Iinclude -c src/timedep.c -o timedep.o
+if errorlevel 1 (
+    echo timedep.c 编译失败
+    pause
+    exit /b 1
+)
+
+echo 编译 multimodal.c...
+gcc -std=c99 -Iinclude -c src/multimodal.c -o multimodal.o
+if errorlevel 1 (
+    echo multimodal.c 编译失败
+    pause
+    exit /b 1
+)
+
 echo 编译 main.c...
 gcc -std=c99 -Iinclude -c src/main.c -o main.o
 if errorlevel 1 (
@@ -37,7 +157,7 @@ if errorlevel 1 (
 )
 
 echo 链接...
-gcc utils.o graph.o pathfinding.o main.o -o PathFinding.exe -lm
+gcc utils.o graph.o pathfinding.o heap.o ch.o landmarks.o matrix.o engine.o spt.o routecache.o dynspt.o loader.o snapshot.o generator.o batch.o server.o timedep.o multimodal.o main.o -o PathFinding.exe -lm -lpthread
 if errorlevel 1 (
     echo 链接失败
     pause
@@ -0,0 +1,734 @@
+// 路径查找基准测试：加载或生成图，按固定种子生成随机查询和按Dijkstra秩分层的查询，
+// 依次运行各搜索引擎，以JSON输出吞吐量、延迟分位数、确定的节点数和峰值内存；
+// 指定--dynamic时再对图做随机修改，逐次核对增量维护的最短路径树与重新构建的结果。
+// 用法见 printUsage，结果写到标准输出，进度信息写到标准错误
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/graph.h"
+#include "../include/pathfinding.h"
+#include "../include/landmarks.h"
+#include "../include/ch.h"
+#include "../include/spt.h"
+#include "../include/dynspt.h"
+#include "../include/loader.h"
+#include "../include/snapshot.h"
+#include "../include/generator.h"
+#include "../include/timedep.h"
+#include "../include/utils.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#define DEFAULT_GRID_SIZE 256
+#define DEFAULT_QUERY_COUNT 1000
+#define DEFAULT_RANK_SOURCES 20
+#define DEFAULT_SEED 42
+
+// 一次查询
+typedef struct {
+    int start;
+    int end;
+    int rank;       // Dijkstra秩的以2为底的对数（随机查询为-1）
+    int departure;  // 时间相关查询的出发时刻（一天中的秒数）
+} BenchQuery;
+
+// 基准测试的运行环境
+typedef struct {
+    Graph* graph;
+    TransportMode mode;
+    SearchWorkspace* ws;
+    const LandmarkSet* landmarks;
+    const ContractionHierarchy* ch;
+    const TimeProfileSet* profiles;
+    int departure;          // 当前查询的出发时刻
+} BenchContext;
+
+// 搜索引擎
+typedef struct {
+    const char* name;
+    int bidirectional;      // 是否使用反向标签（统计确定的节点数时需要）
+    int needsLandmarks;
+    int needsHierarchy;
+    int timeDependent;      // 按出发时刻搜索最早到达路径（代价为行程时间，以td-dijkstra为正确性基准）
+    int (*run)(BenchContext* ctx, int start, int end, PathResult* result);
+} BenchEngine;
+
+// 一个引擎在一组查询上的测量结果
+typedef struct {
+    double* latencies;      // 每次查询的耗时（秒）
+    long long* settled;     // 每次查询确定的节点数
+    int* costs;             // 每次查询的路径代价（不可达为INF）
+    SearchStats* stats;     // 每次查询的搜索计数（未以ENABLE_SEARCH_STATS编译时为NULL）
+} BenchRun;
+
+static unsigned long long rngState = DEFAULT_SEED;
+
+// xorshift64随机数
+static unsigned long long nextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+static int runDijkstra(BenchContext* ctx, int start, int end, PathResult* result) {
+    return dijkstraSearch(ctx->ws, ctx->graph, start, end, ctx->mode, QUEUE_DARY_HEAP, NULL, result);
+}
+
+static int runDijkstraRadix(BenchContext* ctx, int start, int end, PathResult* result) {
+    return dijkstraSearch(ctx->ws, ctx->graph, start, end, ctx->mode, QUEUE_RADIX_HEAP, NULL, result);
+}
+
+static int runAStar(BenchContext* ctx, int start, int end, PathResult* result) {
+    return astarSearch(ctx->ws, ctx->graph, start, end, ctx->mode, NULL, result);
+}
+
+static int runALT(BenchContext* ctx, int start, int end, PathResult* result) {
+    return astarSearchWithLandmarks(ctx->ws, ctx->graph, start, end, ctx->mode, ctx->landmarks, NULL, result);
+}
+
+static int runBidirectionalDijkstra(BenchContext* ctx, int start, int end, PathResult* result) {
+    return bidirectionalDijkstraSearch(ctx->ws, ctx->graph, start, end, ctx->mode, NULL, result);
+}
+
+static int runBidirectionalAStar(BenchContext* ctx, int start, int end, PathResult* result) {
+    return bidirectionalAStarSearch(ctx->ws, ctx->graph, start, end, ctx->mode, NULL, result);
+}
+
+static int runCH(BenchContext* ctx, int start, int end, PathResult* result) {
+    return chSearch(ctx->ws, ctx->ch, ctx->graph, start, end, NULL, result);
+}
+
+static int runTimeDependentDijkstra(BenchContext* ctx, int start, int end, PathResult* result) {
+    return timeDependentDijkstraSearch(ctx->ws, ctx->graph, ctx->profiles, start, end, ctx->mode, ctx->departure,
+                                       NULL, result);
+}
+
+static int runTimeDependentAStar(BenchContext* ctx, int start, int end, PathResult* result) {
+    return timeDependentAStarSearch(ctx->ws, ctx->graph, ctx->profiles, start, end, ctx->mode, ctx->departure,
+                                    NULL, result);
+}
+
+// 第一个引擎作为正确性基准（时间相关的引擎以td-dijkstra为基准）
+static const BenchEngine engines[] = {
+    { "dijkstra",       0, 0, 0, 0, runDijkstra },
+    { "dijkstra-radix", 0, 0, 0, 0, runDijkstraRadix },
+    { "astar",          0, 0, 0, 0, runAStar },
+    { "alt",            0, 1, 0, 0, runALT },
+    { "bidijkstra",     1, 0, 0, 0, runBidirectionalDijkstra },
+    { "biastar",        1, 0, 0, 0, runBidirectionalAStar },
+    { "ch",             1, 0, 1, 0, runCH },
+    { "td-dijkstra",    0, 0, 0, 1, runTimeDependentDijkstra },
+    { "td-astar",       0, 0, 0, 1, runTimeDependentAStar }
+};
+#define ENGINE_COUNT ((int)(sizeof(engines) / sizeof(engines[0])))
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+            "用法: %s [选项]\n"
+            "  --graph <文件>        加载图（文本格式、DIMACS .gr 或快照），缺省时生成网格图\n"
+            "  --grid <边长>         生成的扰动网格图边长（默认%d，参见gengraph）\n"
+            "  --queries <数量>      随机查询数（默认%d）\n"
+            "  --rank-sources <数量> 按Dijkstra秩分层的查询的起点数（默认%d，0表示不做）\n"
+            "  --seed <种子>         随机种子（默认%d）\n"
+            "  --mode <walking|driving>  交通方式（默认driving）\n"
+            "  --landmarks <数量>    ALT的地标数（默认%d）\n"
+            "  --engines <a,b,...>   只运行指定的引擎\n"
+            "  --no-ch               不构建收缩层次（跳过ch引擎）\n"
+            "  --random-weights <最小>,<最大>  把所选交通方式的边权重改为该区间内的随机值，\n"
+            "                        权重可能小于直线距离，用于检查启发式是否仍为下界\n"
+            "  --profiles <文件|rush> 时间相关的行程时间剖面（rush为每条边生成早晚高峰剖面），\n"
+            "                        指定时运行td-dijkstra和td-astar，出发时刻在一天中随机选取\n"
+            "  --dynamic <次数>      最后对图做指定次数的随机修改（权重、阻断、节点、增删边），\n"
+            "                        每次修改后将动态最短路径树与重新构建的树比较，不一致时返回非零\n",
+            program, DEFAULT_GRID_SIZE, DEFAULT_QUERY_COUNT, DEFAULT_RANK_SOURCES, DEFAULT_SEED,
+            DEFAULT_LANDMARK_COUNT);
+}
+
+// 按代价排序节点（代价相同时按编号）
+static const int* sortDist;
+
+static int compareByDist(const void* a, const void* b) {
+    int u = *(const int*)a;
+    int v = *(const int*)b;
+    if (sortDist[u] != sortDist[v]) return sortDist[u] < sortDist[v] ? -1 : 1;
+    return (u > v) - (u < v);
+}
+
+// 生成按Dijkstra秩分层的查询：从随机起点做完整的Dijkstra，终点取确定顺序中第2^r个节点
+static int generateRankQueries(Graph* graph, TransportMode mode, int sources, BenchQuery** queries) {
+    int n = graph->nodeCount;
+    int capacity = sources * 32;
+    int count = 0;
+    int* order = (int*)safeMalloc((size_t)maxInt(n, 1) * sizeof(int));
+    *queries = (BenchQuery*)safeMalloc((size_t)maxInt(capacity, 1) * sizeof(BenchQuery));
+    
+    for (int i = 0; i < sources && n > 0; i++) {
+        int source = (int)(nextRandom() % (unsigned long long)n);
+        ShortestPathTree* tree = buildShortestPathTree(graph, source, mode);
+        if (!tree) continue;
+        
+        int reached = 0;
+        for (int v = 0; v < n; v++) {
+            if (tree->dist[v] != INF) order[reached++] = v;
+        }
+        sortDist = tree->dist;
+        qsort(order, (size_t)reached, sizeof(int), compareByDist);
+        
+        for (int r = 1; r < 31 && (1 << r) < reached; r++) {
+            (*queries)[count].start = source;
+            (*queries)[count].end = order[1 << r];
+            (*queries)[count].rank = r;
+            count++;
+        }
+        destroyShortestPathTree(tree);
+    }
+    
+    free(order);
+    return count;
+}
+
+// 路径在指定交通方式下的代价
+static int pathCost(const Graph* graph, const PathResult* result, TransportMode mode) {
+    if (!result->isValid) return INF;
+    
+    long long cost = 0;
+    for (int i = 0; i + 1 < result->pathLength; i++) {
+        cost += graph->edges[result->edges[i]].modeWeight[mode];
+    }
+    return cost >= INF ? INF : (int)cost;
+}
+
+// 上一次查询确定的节点数（未启用搜索统计时使用，按工作区的代数戳统计，不计入查询耗时）
+static long long countSettled(const BenchContext* ctx, int bidirectional) {
+    const SearchLabels* labels[2] = { &ctx->ws->forward, bidirectional ? &ctx->ws->backward : NULL };
+    long long settled = 0;
+    
+    for (int i = 0; i < 2; i++) {
+        if (!labels[i] || !labels[i]->settled) continue;
+        for (int v = 0; v < ctx->graph->nodeCount; v++) {
+            if (labels[i]->settled[v] == labels[i]->generation) settled++;
+        }
+    }
+    return settled;
+}
+
+// 在一组查询上运行引擎
+static void runEngine(BenchContext* ctx, const BenchEngine* engine, const BenchQuery* queries, int count, BenchRun* run) {
+    run->latencies = (double*)safeMalloc((size_t)maxInt(count, 1) * sizeof(double));
+    run->settled = (long long*)safeMalloc((size_t)maxInt(count, 1) * sizeof(long long));
+    run->costs = (int*)safeMalloc((size_t)maxInt(count, 1) * sizeof(int));
+    run->stats = SEARCH_STATS_ENABLED ?
+        (SearchStats*)safeMalloc((size_t)maxInt(count, 1) * sizeof(SearchStats)) : NULL;
+    
+    for (int i = 0; i < count; i++) {
+        if (run->stats) setSearchStats(ctx->ws, &run->stats[i]);
+        PathResult result;
+        ctx->departure = queries[i].departure;
+        double begin = getTimeSeconds();
+        int status = engine->run(ctx, queries[i].start, queries[i].end, &result);
+        run->latencies[i] = getTimeSeconds() - begin;
+        
+        if (engine->timeDependent) {
+            run->costs[i] = status == 0 && result.isValid ? result.totalTime : INF;
+        } else {
+            run->costs[i] = status == 0 ? pathCost(ctx->graph, &result, ctx->mode) : INF;
+        }
+        run->settled[i] = run->stats ? run->stats[i].settledNodes : countSettled(ctx, engine->bidirectional);
+    }
+    setSearchStats(ctx->ws, NULL);
+}
+
+static void freeBenchRun(BenchRun* run) {
+    free(run->latencies);
+    free(run->settled);
+    free(run->costs);
+    free(run->stats);
+}
+
+static int compareDouble(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// 已排序数组的分位数（最近秩法）
+static double percentile(const double* sorted, int count, double p) {
+    if (count == 0) return 0.0;
+    int index = (int)(p * count + 0.999999) - 1;
+    return sorted[maxInt(0, minInt(index, count - 1))];
+}
+
+// 输出JSON字符串
+static void printJsonString(const char* text) {
+    putchar('"');
+    for (const char* p = text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            printf("\\%c", *p);
+        } else if ((unsigned char)*p < 0x20) {
+            printf("\\u%04x", *p);
+        } else {
+            putchar(*p);
+        }
+    }
+    putchar('"');
+}
+
+// 输出一组查询的统计（rank为-1时统计全部查询，否则只统计该秩的查询），reference为基准代价
+static void printSummary(const BenchRun* run, const BenchQuery* queries, int count, int rank, const int* reference) {
+    double* sorted = (double*)safeMalloc((size_t)maxInt(count, 1) * sizeof(double));
+    double total = 0.0;
+    long long settled = 0;
+    SearchStats sum;
+    int selected = 0;
+    int mismatches = 0;
+    
+    memset(&sum, 0, sizeof(sum));
+    for (int i = 0; i < count; i++) {
+        if (rank >= 0 && queries[i].rank != rank) continue;
+        sorted[selected++] = run->latencies[i];
+        total += run->latencies[i];
+        settled += run->settled[i];
+        if (reference && run->costs[i] != reference[i]) mismatches++;
+        if (run->stats) {
+            sum.relaxedEdges += run->stats[i].relaxedEdges;
+            sum.queuePushes += run->stats[i].queuePushes;
+            sum.stalePops += run->stats[i].stalePops;
+            sum.maxQueueSize = maxInt(sum.maxQueueSize, run->stats[i].maxQueueSize);
+        }
+    }
+    qsort(sorted, (size_t)selected, sizeof(double), compareDouble);
+    
+    printf("\"queries\": %d, \"qps\": %.1f, ", selected, total > 0.0 ? selected / total : 0.0);
+    printf("\"latency_us\": {\"mean\": %.2f, \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f}, ",
+           selected ? total / selected * 1e6 : 0.0, percentile(sorted, selected, 0.50) * 1e6,
+           percentile(sorted, selected, 0.95) * 1e6, percentile(sorted, selected, 0.99) * 1e6,
+           selected ? sorted[selected - 1] * 1e6 : 0.0);
+    printf("\"settled_mean\": %.1f, ", selected ? (double)settled / selected : 0.0);
+    if (run->stats) {
+        double divisor = selected ? (double)selected : 1.0;
+        printf("\"relaxed_mean\": %.1f, \"pushes_mean\": %.1f, \"stale_pops_mean\": %.1f, \"max_queue\": %d, ",
+               sum.relaxedEdges / divisor, sum.queuePushes / divisor, sum.stalePops / divisor, sum.maxQueueSize);
+    }
+    printf("\"mismatches\": %d", mismatches);
+    free(sorted);
+}
+
+// 峰值常驻内存（KB），不支持时返回-1
+static long getPeakRSS(void) {
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// 把每条边在mode下的权重改为[minWeight, maxWeight]内的随机值
+static void randomizeWeights(Graph* graph, TransportMode mode, int minWeight, int maxWeight) {
+    for (int e = 0; e < graph->edgeCount; e++) {
+        const Edge* edge = &graph->edges[e];
+        int weight = minWeight + (int)(nextRandom() % (unsigned long long)(maxWeight - minWeight + 1));
+        updateEdgeWeight(graph, edge->from, edge->to, mode, weight);
+    }
+}
+
+// 对图做一次随机修改（权重增减、边阻断或恢复、节点阻断或恢复、新增捷径边、删除边）
+static void applyRandomChange(Graph* graph, TransportMode mode) {
+    Edge* edge = &graph->edges[nextRandom() % (unsigned long long)graph->edgeCount];
+    int from = edge->from;
+    int to = edge->to;
+    
+    switch (nextRandom() % 5) {
+        case 0: {
+            int weight = edge->modeWeight[mode];
+            int newWeight = maxInt(1, (int)((long long)weight * (int)(50 + nextRandom() % 151) / 100));
+            updateEdgeWeight(graph, from, to, mode, newWeight);
+            break;
+        }
+        case 1:
+            setEdgeAccessible(graph, from, to, !graph->edges[findEdge(graph, from, to)].isAccessible);
+            break;
+        case 2:
+            setNodeAccessible(graph, to, !graph->nodes[to].isActive);
+            break;
+        case 3: {
+            // 沿to的一条出边再走一步，加一条代价在两段之和上下浮动的边
+            int next = graph->adjHead[to];
+            if (next == -1) break;
+            const Edge* second = &graph->edges[next];
+            int scale = (int)(80 + nextRandom() % 41);
+            addEdge(graph, from, second->to, edge->distance + second->distance, edge->timeCost + second->timeCost,
+                    (int)((long long)(edge->modeWeight[MODE_WALKING] + second->modeWeight[MODE_WALKING]) * scale / 100),
+                    (int)((long long)(edge->modeWeight[MODE_DRIVING] + second->modeWeight[MODE_DRIVING]) * scale / 100));
+            break;
+        }
+        default:
+            removeEdge(graph, from, to);
+            break;
+    }
+}
+
+// 动态最短路径树的正确性核对：随机修改图，每次修改后与重新构建的树逐节点比较代价。
+// 只计时修改本身（含监听者中的修复），核对用的重新构建单独计时。返回代价不一致的修改次数
+static int runDynamicCheck(Graph* graph, TransportMode mode, int changes) {
+    int source = (int)(nextRandom() % (unsigned long long)graph->nodeCount);
+    DynamicSPT* dyn = createDynamicSPT(graph, source, mode);
+    if (!dyn) {
+        printf(",\n  \"dynamic\": null");
+        return 0;
+    }
+    
+    double* latencies = (double*)safeMalloc((size_t)maxInt(changes, 1) * sizeof(double));
+    double repairTotal = 0.0;
+    double rebuildTotal = 0.0;
+    long long touched = 0;
+    int mismatches = 0;
+    
+    for (int i = 0; i < changes; i++) {
+        long long before = dyn->repairs;
+        double begin = getTimeSeconds();
+        applyRandomChange(graph, mode);
+        latencies[i] = getTimeSeconds() - begin;
+        repairTotal += latencies[i];
+        if (dyn->repairs != before) touched += dyn->lastTouched;
+        
+        begin = getTimeSeconds();
+        ShortestPathTree* fresh = buildShortestPathTree(graph, source, mode);
+        rebuildTotal += getTimeSeconds() - begin;
+        if (!fresh) {
+            mismatches++;
+            continue;
+        }
+        for (int v = 0; v < fresh->nodeCount; v++) {
+            if (v >= dyn->tree->nodeCount || dyn->tree->dist[v] != fresh->dist[v]) {
+                mismatches++;
+                break;
+            }
+        }
+        destroyShortestPathTree(fresh);
+    }
+    qsort(latencies, (size_t)changes, sizeof(double), compareDouble);
+    
+    printf(",\n  \"dynamic\": {\"changes\": %d, \"source\": %d, \"edges\": %d, ", changes, source, graph->edgeCount);
+    printf("\"repair_us\": {\"mean\": %.2f, \"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f}, ",
+           changes ? repairTotal / changes * 1e6 : 0.0, percentile(latencies, changes, 0.50) * 1e6,
+           percentile(latencies, changes, 0.99) * 1e6, changes ? latencies[changes - 1] * 1e6 : 0.0);
+    printf("\"rebuild_us_mean\": %.2f, \"touched_mean\": %.1f, \"mismatches\": %d}",
+           changes ? rebuildTotal / changes * 1e6 : 0.0, changes ? (double)touched / changes : 0.0, mismatches);
+    
+    free(latencies);
+    destroyDynamicSPT(dyn);
+    return mismatches;
+}
+
+// 为每条边生成早晚高峰剖面：平峰为静态的timeCost，7:30和18:00前后按随机倍数（1.3~2.0）变慢，
+// 倍数导致剖面不满足FIFO的边（极长的边）保持静态。返回指定了剖面的边数
+static int buildRushHourProfiles(TimeProfileSet* set, Graph* graph) {
+    static const int times[] = { 0, 6 * 3600, 7 * 3600 + 1800, 9 * 3600, 16 * 3600 + 1800, 18 * 3600, 19 * 3600 + 1800 };
+    static const int peak[] = { 0, 0, 1, 0, 0, 1, 0 };
+    TimeBreakpoint points[7];
+    int assigned = 0;
+    
+    for (int e = 0; e < graph->edgeCount; e++) {
+        int timeCost = graph->edges[e].timeCost;
+        int factor = 1300 + (int)(nextRandom() % 701);  // 千分比
+        for (int i = 0; i < 7; i++) {
+            points[i].time = times[i];
+            points[i].travelTime = peak[i] ? (int)((long long)timeCost * factor / 1000) : timeCost;
+        }
+        int profile = addTimeProfile(set, points, 7);
+        if (profile >= 0 && setEdgeTimeProfile(set, graph, e, profile) == 0) assigned++;
+    }
+    return assigned;
+}
+
+// 引擎是否在--engines列表中（列表为NULL时全部运行）
+static int isEngineSelected(const char* list, const char* name) {
+    if (!list) return 1;
+    
+    size_t length = strlen(name);
+    for (const char* p = list; *p; ) {
+        const char* comma = strchr(p, ',');
+        size_t itemLength = comma ? (size_t)(comma - p) : strlen(p);
+        if (itemLength == length && strncmp(p, name, length) == 0) return 1;
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* graphPath = NULL;
+    const char* engineList = NULL;
+    const char* profilePath = NULL;
+    int gridSize = DEFAULT_GRID_SIZE;
+    int queryCount = DEFAULT_QUERY_COUNT;
+    int rankSources = DEFAULT_RANK_SOURCES;
+    int landmarkCount = DEFAULT_LANDMARK_COUNT;
+    int buildHierarchy = 1;
+    int dynamicChanges = 0;
+    int minRandomWeight = 0;
+    int maxRandomWeight = 0;
+    unsigned long long seed = DEFAULT_SEED;
+    TransportMode mode = MODE_DRIVING;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--no-ch") == 0) {
+            buildHierarchy = 0;
+            continue;
+        }
+        if (!value) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        if (strcmp(argv[i], "--graph") == 0) {
+            graphPath = value;
+        } else if (strcmp(argv[i], "--grid") == 0) {
+            gridSize = atoi(value);
+        } else if (strcmp(argv[i], "--queries") == 0) {
+            queryCount = atoi(value);
+        } else if (strcmp(argv[i], "--rank-sources") == 0) {
+            rankSources = atoi(value);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "--mode") == 0) {
+            mode = strcmp(value, "walking") == 0 ? MODE_WALKING : MODE_DRIVING;
+        } else if (strcmp(argv[i], "--landmarks") == 0) {
+            landmarkCount = atoi(value);
+        } else if (strcmp(argv[i], "--engines") == 0) {
+            engineList = value;
+        } else if (strcmp(argv[i], "--profiles") == 0) {
+            profilePath = value;
+        } else if (strcmp(argv[i], "--dynamic") == 0) {
+            dynamicChanges = atoi(value);
+        } else if (strcmp(argv[i], "--random-weights") == 0) {
+            if (sscanf(value, "%d,%d", &minRandomWeight, &maxRandomWeight) != 2 || minRandomWeight < 1 ||
+                maxRandomWeight < minRandomWeight || maxRandomWeight >= INF / 4) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (gridSize < 2 || queryCount < 0 || rankSources < 0 || landmarkCount < 1 || landmarkCount > MAX_LANDMARKS ||
+        dynamicChanges < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    rngState = seed ? seed : DEFAULT_SEED;
+    
+    // 加载或生成图
+    Graph* graph = NULL;
+    GraphSnapshot* snapshot = NULL;
+    double loadBegin = getTimeSeconds();
+    if (!graphPath) {
+        GeneratorConfig config;
+        initGeneratorConfig(&config, GENERATOR_GRID, gridSize * gridSize, seed);
+        graph = generateGraph(&config);
+    } else if (isGraphSnapshotFile(graphPath)) {
+        snapshot = openGraphSnapshot(graphPath, NULL);
+        graph = snapshot ? snapshot->graph : NULL;
+    } else {
+        GraphLoadStatus status;
+        size_t length = strlen(graphPath);
+        if (length > 3 && strcmp(graphPath + length - 3, ".gr") == 0) {
+            graph = loadDimacsGraphWithCoordinates(graphPath, &status);
+        } else {
+            graph = loadGraph(graphPath, &status);
+        }
+        if (!graph) fprintf(stderr, "第%d行: %s\n", status.line, status.message);
+    }
+    if (!graph || graph->nodeCount == 0) {
+        fprintf(stderr, "无法加载图或图为空: %s\n", graphPath ? graphPath : "grid");
+        return 1;
+    }
+    if (dynamicChanges > 0 && (graph->isReadOnly || graph->edgeCount == 0)) {
+        fprintf(stderr, "--dynamic需要可修改且有边的图（快照是只读的）\n");
+        return 1;
+    }
+    if (maxRandomWeight > 0) {
+        if (graph->isReadOnly) {
+            fprintf(stderr, "--random-weights需要可修改的图（快照是只读的）\n");
+            return 1;
+        }
+        randomizeWeights(graph, mode, minRandomWeight, maxRandomWeight);
+    }
+    double loadSeconds = getTimeSeconds() - loadBegin;
+    int n = graph->nodeCount;
+    fprintf(stderr, "图: %d 个节点、%d 条边（%.2f 秒）\n", n, graph->edgeCount, loadSeconds);
+    
+    // 预处理（快照中已有的直接使用）
+    const LandmarkSet* landmarks = snapshot ? snapshot->landmarks : NULL;
+    const ContractionHierarchy* ch = snapshot ? snapshot->hierarchies[mode] : NULL;
+    LandmarkSet* builtLandmarks = NULL;
+    ContractionHierarchy* builtHierarchy = NULL;
+    double landmarkSeconds = 0.0;
+    double hierarchySeconds = 0.0;
+    
+    if (!landmarks && isEngineSelected(engineList, "alt")) {
+        double begin = getTimeSeconds();
+        builtLandmarks = buildLandmarks(graph, landmarkCount);
+        landmarkSeconds = getTimeSeconds() - begin;
+        landmarks = builtLandmarks;
+    }
+    if (!ch && buildHierarchy && isEngineSelected(engineList, "ch")) {
+        fprintf(stderr, "正在构建收缩层次...\n");
+        double begin = getTimeSeconds();
+        builtHierarchy = buildContractionHierarchy(graph, mode);
+        hierarchySeconds = getTimeSeconds() - begin;
+        ch = builtHierarchy;
+    }
+    
+    // 时间相关的行程时间剖面
+    TimeProfileSet* profiles = NULL;
+    int profiledEdges = 0;
+    double profileSeconds = 0.0;
+    if (profilePath) {
+        double begin = getTimeSeconds();
+        profiles = createTimeProfileSet(graph);
+        if (strcmp(profilePath, "rush") == 0) {
+            profiledEdges = buildRushHourProfiles(profiles, graph);
+        } else {
+            GraphLoadStatus status;
+            if (loadTimeProfiles(profiles, graph, profilePath, &status) != 0) {
+                fprintf(stderr, "无法读取剖面（第%d行）: %s\n", status.line, status.message);
+                return 1;
+            }
+            profiledEdges = status.edgeCount;
+        }
+        profileSeconds = getTimeSeconds() - begin;
+    }
+    
+    // 查询集合：随机查询在前，分层查询在后
+    BenchQuery* rankQueries = NULL;
+    int rankCount = generateRankQueries(graph, mode, rankSources, &rankQueries);
+    int total = queryCount + rankCount;
+    BenchQuery* queries = (BenchQuery*)safeMalloc((size_t)maxInt(total, 1) * sizeof(BenchQuery));
+    for (int i = 0; i < queryCount; i++) {
+        queries[i].start = (int)(nextRandom() % (unsigned long long)n);
+        queries[i].end = (int)(nextRandom() % (unsigned long long)n);
+        queries[i].rank = -1;
+    }
+    if (rankCount > 0) memcpy(queries + queryCount, rankQueries, (size_t)rankCount * sizeof(BenchQuery));
+    free(rankQueries);
+    
+    int maxRank = 0;
+    for (int i = queryCount; i < total; i++) {
+        maxRank = maxInt(maxRank, queries[i].rank);
+    }
+    for (int i = 0; i < total; i++) {
+        queries[i].departure = profiles ? (int)(nextRandom() % TIME_PROFILE_PERIOD) : 0;
+    }
+    
+    BenchContext ctx = { graph, mode, createSearchWorkspace(n), landmarks, ch, profiles, 0 };
+    
+    printf("{\n  \"graph\": {\"source\": ");
+    printJsonString(graphPath ? graphPath : "grid");
+    printf(", \"nodes\": %d, \"edges\": %d, \"load_seconds\": %.3f},\n", n, graph->edgeCount, loadSeconds);
+    printf("  \"config\": {\"queries\": %d, \"rank_queries\": %d, \"seed\": %llu, \"mode\": \"%s\", \"search_stats\": %s},\n",
+           queryCount, rankCount, seed, mode == MODE_WALKING ? "walking" : "driving",
+           SEARCH_STATS_ENABLED ? "true" : "false");
+    printf("  \"preprocessing\": {\"landmarks\": %d, \"landmark_seconds\": %.3f, \"ch\": %s, \"ch_seconds\": %.3f",
+           landmarks ? landmarks->count : 0, landmarkSeconds, ch ? "true" : "false", hierarchySeconds);
+    if (profiles) {
+        printf(", \"profiled_edges\": %d, \"profiles\": %d, \"breakpoints\": %d, \"profile_bytes\": %lld, \"profile_seconds\": %.3f",
+               profiledEdges, profiles->profileCount, profiles->pointCount,
+               (long long)profiles->pointCount * (long long)sizeof(TimeBreakpoint) +
+               (long long)(profiles->profileCount + 1) * (long long)sizeof(int) +
+               (long long)profiles->slotCount * (long long)sizeof(TimeArc) + (long long)profiles->edgeCount * (long long)sizeof(int),
+               profileSeconds);
+    }
+    printf("},\n");
+    printf("  \"engines\": [");
+    
+    // 第一个引擎（Dijkstra）的结果作为正确性基准
+    BenchRun reference;
+    BenchRun timeReference;
+    runEngine(&ctx, &engines[0], queries, total, &reference);
+    memset(&timeReference, 0, sizeof(timeReference));
+    
+    int printed = 0;
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        const BenchEngine* engine = &engines[e];
+        if (!isEngineSelected(engineList, engine->name)) continue;
+        if ((engine->needsLandmarks && !landmarks) || (engine->needsHierarchy && !ch) ||
+            (engine->timeDependent && !profiles)) {
+            continue;
+        }
+        
+        fprintf(stderr, "运行 %s...\n", engine->name);
+        BenchRun run;
+        if (e == 0) {
+            run = reference;
+        } else {
+            runEngine(&ctx, engine, queries, total, &run);
+        }
+        
+        // 时间相关的引擎以第一个运行的时间相关引擎为基准
+        const BenchRun* baseline = &reference;
+        if (engine->timeDependent) {
+            if (!timeReference.costs) {
+                timeReference.costs = (int*)safeMalloc((size_t)maxInt(total, 1) * sizeof(int));
+                memcpy(timeReference.costs, run.costs, (size_t)total * sizeof(int));
+            }
+            baseline = &timeReference;
+        }
+        
+        printf("%s\n    {\"name\": \"%s\", ", printed++ ? "," : "", engine->name);
+        printSummary(&run, queries, queryCount, -1, baseline->costs);
+        printf(",\n     \"ranks\": [");
+        for (int r = 1; r <= maxRank; r++) {
+            BenchRun ranked = { run.latencies + queryCount, run.settled + queryCount, run.costs + queryCount,
+                                run.stats ? run.stats + queryCount : NULL };
+            printf("%s\n       {\"rank\": %d, ", r > 1 ? "," : "", 1 << r);
+            printSummary(&ranked, queries + queryCount, rankCount, r, baseline->costs + queryCount);
+            printf("}");
+        }
+        printf("%s]}", maxRank > 0 ? "\n     " : "");
+        
+        if (e != 0) freeBenchRun(&run);
+    }
+    freeBenchRun(&reference);
+    free(timeReference.costs);
+    printf("\n  ]");
+    
+    // 动态修改放在最后：修改后的图不再与地标、收缩层次和剖面一致
+    int dynamicMismatches = 0;
+    if (dynamicChanges > 0) {
+        fprintf(stderr, "核对动态最短路径树（%d 次修改）...\n", dynamicChanges);
+        dynamicMismatches = runDynamicCheck(graph, mode, dynamicChanges);
+    }
+    
+    long peakRSS = getPeakRSS();
+    printf(",\n  \"peak_rss_kb\": ");
+    if (peakRSS >= 0) {
+        printf("%ld\n}\n", peakRSS);
+    } else {
+        printf("null\n}\n");
+    }
+    
+    destroySearchWorkspace(ctx.ws);
+    free(queries);
+    destroyLandmarks(builtLandmarks);
+    destroyContractionHierarchy(builtHierarchy);
+    destroyTimeProfileSet(profiles);
+    if (snapshot) {
+        closeGraphSnapshot(snapshot);
+    } else {
+        destroyGraph(graph);
+    }
+    return dynamicMismatches ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+// 合成图生成器：按类型、规模和随机种子生成路网，写成文本格式（NODE/EDGE）或二进制快照。
+// 文本格式流式写出，不在内存中构建图，可生成上千万条边；快照需要先在内存中构建图。
+// 用法见 printUsage，进度信息写到标准错误
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/graph.h"
+#include "../include/generator.h"
+#include "../include/landmarks.h"
+#include "../include/ch.h"
+#include "../include/snapshot.h"
+#include "../include/utils.h"
+
+#define DEFAULT_NODE_COUNT 100000
+#define DEFAULT_SEED 42
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+            "用法: %s [选项] -o <输出文件>\n"
+            "  --type <grid|geometric|highway>  图的类型（默认grid）\n"
+            "  --nodes <数量>        目标节点数（默认%d）\n"
+            "  --seed <种子>         随机种子（默认%d）\n"
+            "  --spacing <米>        平均节点间距（默认100）\n"
+            "  --jitter <比例>       网格节点位置的扰动幅度，0到0.5（默认0.25）\n"
+            "  --drop <比例>         网格路段的随机删除比例（默认0.05）\n"
+            "  --degree <度数>       几何图的平均度数（默认6）\n"
+            "  --arterial <间隔>     每隔多少行/列一条主干道，0表示没有（默认8）\n"
+            "  --highway <间隔>      分层路网中每隔多少行/列一条高速（默认32）\n"
+            "  --snapshot            输出二进制快照而不是文本\n"
+            "  --landmarks <数量>    快照中附带的地标数（默认不附带）\n"
+            "  --ch                  快照中附带两种交通方式的收缩层次\n",
+            program, DEFAULT_NODE_COUNT, DEFAULT_SEED);
+}
+
+// 在内存中生成图并保存为快照
+static int writeSnapshot(const GeneratorConfig* config, const char* path, int landmarkCount, int withHierarchy) {
+    Graph* graph = generateGraph(config);
+    if (!graph) {
+        fprintf(stderr, "生成图失败\n");
+        return -1;
+    }
+    fprintf(stderr, "图: %d 个节点、%d 条边\n", graph->nodeCount, graph->edgeCount);
+    
+    LandmarkSet* landmarks = landmarkCount > 0 ? buildLandmarks(graph, landmarkCount) : NULL;
+    ContractionHierarchy* hierarchies[MODE_COUNT] = { NULL };
+    if (withHierarchy) {
+        for (int m = 0; m < MODE_COUNT; m++) {
+            fprintf(stderr, "正在构建收缩层次（%s）...\n", m == MODE_WALKING ? "步行" : "驾车");
+            hierarchies[m] = buildContractionHierarchy(graph, (TransportMode)m);
+        }
+    }
+    
+    int status = saveGraphSnapshot(path, graph, landmarks, hierarchies);
+    if (status != 0) fprintf(stderr, "无法写入快照: %s\n", path);
+    
+    for (int m = 0; m < MODE_COUNT; m++) {
+        destroyContractionHierarchy(hierarchies[m]);
+    }
+    destroyLandmarks(landmarks);
+    destroyGraph(graph);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    const char* outputPath = NULL;
+    int type = GENERATOR_GRID;
+    int nodeCount = DEFAULT_NODE_COUNT;
+    unsigned long long seed = DEFAULT_SEED;
+    int snapshot = 0;
+    int landmarkCount = 0;
+    int withHierarchy = 0;
+    
+    // 先确定类型，其余参数覆盖该类型的默认值
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--type") == 0) type = parseGeneratorType(argv[i + 1]);
+    }
+    if (type < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    GeneratorConfig config;
+    initGeneratorConfig(&config, (GeneratorType)type, nodeCount, seed);
+    
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--snapshot") == 0) {
+            snapshot = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--ch") == 0) {
+            withHierarchy = 1;
+            continue;
+        }
+        if (!value) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            outputPath = value;
+        } else if (strcmp(argv[i], "--type") == 0) {
+            // 已在上面处理
+        } else if (strcmp(argv[i], "--nodes") == 0) {
+            config.nodeCount = atoi(value);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            config.seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "--spacing") == 0) {
+            config.spacing = atof(value);
+        } else if (strcmp(argv[i], "--jitter") == 0) {
+            config.jitter = atof(value);
+        } else if (strcmp(argv[i], "--drop") == 0) {
+            config.dropRate = atof(value);
+        } else if (strcmp(argv[i], "--degree") == 0) {
+            config.degree = atof(value);
+        } else if (strcmp(argv[i], "--arterial") == 0) {
+            config.arterialEvery = atoi(value);
+        } else if (strcmp(argv[i], "--highway") == 0) {
+            config.highwayEvery = atoi(value);
+        } else if (strcmp(argv[i], "--landmarks") == 0) {
+            landmarkCount = atoi(value);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (!outputPath || landmarkCount < 0 || landmarkCount > MAX_LANDMARKS) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    double begin = getTimeSeconds();
+    if (snapshot) {
+        if (writeSnapshot(&config, outputPath, landmarkCount, withHierarchy) != 0) return 1;
+        fprintf(stderr, "已写入快照 %s（%.2f 秒）\n", outputPath, getTimeSeconds() - begin);
+    } else {
+        long long edgeCount = 0;
+        if (writeGeneratedGraph(&config, outputPath, &edgeCount) != 0) {
+            fprintf(stderr, "参数无效或无法写入文件: %s\n", outputPath);
+            return 1;
+        }
+        fprintf(stderr, "已写入 %s: %lld 条边（%.2f 秒）\n", outputPath, edgeCount, getTimeSeconds() - begin);
+    }
+    return 0;
+}
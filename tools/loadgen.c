@@ -0,0 +1,368 @@
+// 路由服务的压测客户端：建立多个连接，每个连接保持固定数量的流水线请求，
+// 统计吞吐量、延迟分位数以及各类响应的数量。查询来自文件（循环使用）或随机生成的"n<编号>"节点对
+// （与gengraph生成的节点名称一致）。用法见 printUsage，结果写到标准输出
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../include/utils.h"
+
+#define DEFAULT_ADDRESS "127.0.0.1:7070"
+#define LOADGEN_LINE_LEN 512
+#define LOADGEN_READ_BUFFER 65536
+
+typedef struct {
+    int fd;
+    char* output;               // 待发送的请求 [outputOffset, outputLength)
+    size_t outputLength;
+    size_t outputOffset;
+    size_t outputCapacity;
+    char input[LOADGEN_READ_BUFFER];
+    int inputLength;
+    double* sendTimes;          // 已发送、未收到响应的请求的发送时刻（环形队列）
+    int head;
+    int inFlight;
+} Connection;
+
+typedef struct {
+    long long ok;
+    long long unreachable;
+    long long timeout;
+    long long error;
+    double* latencies;
+    long long latencyCount;
+} LoadStats;
+
+static unsigned long long randomState;
+
+static unsigned long long nextRandom(void) {
+    // splitmix64
+    unsigned long long z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+            "用法: %s [选项] (--nodes <节点数> | --queries <查询文件>)\n"
+            "  --connect <地址>      服务地址，\"主机:端口\"或\"unix:路径\"（默认%s）\n"
+            "  --connections <数量>  并发连接数（默认4）\n"
+            "  --depth <数量>        每个连接同时等待响应的请求数（默认8）\n"
+            "  --requests <数量>     请求总数（默认10000）\n"
+            "  --nodes <数量>        随机查询n0..n<数量-1>之间的路径\n"
+            "  --queries <文件>      从文件读取查询行（循环使用）\n"
+            "  --mode <walking|driving>   随机查询的交通方式（默认driving）\n"
+            "  --algorithm <名称>    随机查询的算法（默认dijkstra）\n"
+            "  --deadline <毫秒>     每个请求的截止时间（默认使用服务端的设置）\n"
+            "  --seed <种子>         随机种子（默认42）\n",
+            program, DEFAULT_ADDRESS);
+}
+
+static int connectTo(const char* address) {
+    int fd = -1;
+    if (strncmp(address, "unix:", 5) == 0) {
+        struct sockaddr_un unixAddress;
+        if (strlen(address + 5) >= sizeof(unixAddress.sun_path)) return -1;
+        memset(&unixAddress, 0, sizeof(unixAddress));
+        unixAddress.sun_family = AF_UNIX;
+        strcpy(unixAddress.sun_path, address + 5);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&unixAddress, sizeof(unixAddress)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        return fd;
+    }
+    
+    const char* colon = strrchr(address, ':');
+    if (!colon) return -1;
+    char host[256];
+    size_t hostLength = (size_t)(colon - address);
+    if (hostLength == 0 || hostLength >= sizeof(host)) return -1;
+    memcpy(host, address, hostLength);
+    host[hostLength] = '\0';
+    
+    struct addrinfo hints;
+    struct addrinfo* addresses;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, colon + 1, &hints, &addresses) != 0) return -1;
+    for (struct addrinfo* ai = addresses; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+// 读入查询文件中的非空、非注释行
+static char** readQueryLines(const char* path, int* count) {
+    FILE* file = fopen(path, "r");
+    if (!file) return NULL;
+    
+    char line[LOADGEN_LINE_LEN];
+    char** lines = NULL;
+    int capacity = 0;
+    *count = 0;
+    while (fgets(line, sizeof(line), file)) {
+        trimString(line);
+        if (line[0] == '\0' || line[0] == '#') continue;
+        if (*count == capacity) {
+            capacity = maxInt(64, capacity * 2);
+            lines = (char**)safeRealloc(lines, (size_t)capacity * sizeof(char*));
+        }
+        lines[*count] = (char*)safeMalloc(strlen(line) + 1);
+        strcpy(lines[*count], line);
+        (*count)++;
+    }
+    fclose(file);
+    return lines;
+}
+
+static void appendOutput(Connection* connection, const char* data, size_t length) {
+    if (connection->outputLength + length > connection->outputCapacity) {
+        size_t capacity = connection->outputCapacity ? connection->outputCapacity : 4096;
+        while (connection->outputLength + length > capacity) capacity *= 2;
+        connection->output = (char*)safeRealloc(connection->output, capacity);
+        connection->outputCapacity = capacity;
+    }
+    memcpy(connection->output + connection->outputLength, data, length);
+    connection->outputLength += length;
+}
+
+static void countResponse(LoadStats* stats, const char* line, double latency) {
+    if (strncmp(line, "ok", 2) == 0) {
+        stats->ok++;
+    } else if (strncmp(line, "unreachable", 11) == 0) {
+        stats->unreachable++;
+    } else if (strncmp(line, "timeout", 7) == 0) {
+        stats->timeout++;
+    } else {
+        stats->error++;
+    }
+    stats->latencies[stats->latencyCount++] = latency;
+}
+
+// 处理读缓冲区中完整的响应行，返回处理的行数
+static int processResponses(Connection* connection, LoadStats* stats, int depth) {
+    int start = 0;
+    int count = 0;
+    double now = getTimeSeconds();
+    while (connection->inFlight > 0) {
+        char* newline = memchr(connection->input + start, '\n', (size_t)(connection->inputLength - start));
+        if (!newline) break;
+        *newline = '\0';
+        countResponse(stats, connection->input + start, now - connection->sendTimes[connection->head]);
+        connection->head = (connection->head + 1) % depth;
+        connection->inFlight--;
+        count++;
+        start = (int)(newline - connection->input) + 1;
+    }
+    connection->inputLength -= start;
+    memmove(connection->input, connection->input + start, (size_t)connection->inputLength);
+    return count;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double* sorted, long long count, double p) {
+    if (count == 0) return 0.0;
+    long long index = (long long)(p * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+    const char* address = DEFAULT_ADDRESS;
+    const char* queryPath = NULL;
+    const char* mode = "driving";
+    const char* algorithm = "dijkstra";
+    int connectionCount = 4;
+    int depth = 8;
+    long long requestCount = 10000;
+    int nodeCount = 0;
+    int deadlineMs = 0;
+    randomState = 42;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--connect") == 0) {
+            address = value;
+        } else if (strcmp(argv[i], "--connections") == 0) {
+            connectionCount = atoi(value);
+        } else if (strcmp(argv[i], "--depth") == 0) {
+            depth = atoi(value);
+        } else if (strcmp(argv[i], "--requests") == 0) {
+            requestCount = atoll(value);
+        } else if (strcmp(argv[i], "--nodes") == 0) {
+            nodeCount = atoi(value);
+        } else if (strcmp(argv[i], "--queries") == 0) {
+            queryPath = value;
+        } else if (strcmp(argv[i], "--mode") == 0) {
+            mode = value;
+        } else if (strcmp(argv[i], "--algorithm") == 0) {
+            algorithm = value;
+        } else if (strcmp(argv[i], "--deadline") == 0) {
+            deadlineMs = atoi(value);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            randomState = strtoull(value, NULL, 10);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (connectionCount <= 0 || depth <= 0 || requestCount <= 0 || deadlineMs < 0 ||
+        (nodeCount <= 0) == (queryPath == NULL)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    char** queryLines = NULL;
+    int queryLineCount = 0;
+    if (queryPath) {
+        queryLines = readQueryLines(queryPath, &queryLineCount);
+        if (!queryLines || queryLineCount == 0) {
+            fprintf(stderr, "无法读取查询文件或文件中没有查询: %s\n", queryPath);
+            return 1;
+        }
+    }
+    
+    Connection* connections = (Connection*)safeMalloc((size_t)connectionCount * sizeof(Connection));
+    struct pollfd* pollFds = (struct pollfd*)safeMalloc((size_t)connectionCount * sizeof(struct pollfd));
+    for (int c = 0; c < connectionCount; c++) {
+        Connection* connection = &connections[c];
+        memset(connection, 0, sizeof(Connection));
+        connection->fd = connectTo(address);
+        if (connection->fd < 0) {
+            fprintf(stderr, "无法连接到 %s: %s\n", address, strerror(errno));
+            return 1;
+        }
+        connection->sendTimes = (double*)safeMalloc((size_t)depth * sizeof(double));
+    }
+    
+    LoadStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.latencies = (double*)safeMalloc((size_t)requestCount * sizeof(double));
+    
+    long long sent = 0;
+    double begin = getTimeSeconds();
+    while (stats.latencyCount < requestCount) {
+        // 补足每个连接的流水线深度
+        for (int c = 0; c < connectionCount; c++) {
+            Connection* connection = &connections[c];
+            while (connection->inFlight < depth && sent < requestCount) {
+                char line[LOADGEN_LINE_LEN + 32];
+                int length;
+                if (queryLines) {
+                    length = snprintf(line, sizeof(line), "%s", queryLines[sent % queryLineCount]);
+                } else {
+                    int start = (int)(nextRandom() % (unsigned long long)nodeCount);
+                    int end = (int)(nextRandom() % (unsigned long long)nodeCount);
+                    length = snprintf(line, sizeof(line), "n%d n%d %s %s", start, end, mode, algorithm);
+                }
+                if (deadlineMs > 0) {
+                    length += snprintf(line + length, sizeof(line) - (size_t)length, " %d", deadlineMs);
+                }
+                line[length++] = '\n';
+                appendOutput(connection, line, (size_t)length);
+                connection->sendTimes[(connection->head + connection->inFlight) % depth] = getTimeSeconds();
+                connection->inFlight++;
+                sent++;
+            }
+            pollFds[c].fd = connection->fd;
+            pollFds[c].events = POLLIN | (connection->outputOffset < connection->outputLength ? POLLOUT : 0);
+            pollFds[c].revents = 0;
+        }
+        
+        if (poll(pollFds, (nfds_t)connectionCount, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        for (int c = 0; c < connectionCount; c++) {
+            Connection* connection = &connections[c];
+            if (pollFds[c].revents & POLLOUT) {
+                ssize_t written = send(connection->fd, connection->output + connection->outputOffset,
+                                       connection->outputLength - connection->outputOffset, MSG_NOSIGNAL);
+                if (written > 0) connection->outputOffset += (size_t)written;
+                if (connection->outputOffset == connection->outputLength) {
+                    connection->outputOffset = 0;
+                    connection->outputLength = 0;
+                }
+            }
+            if (pollFds[c].revents & (POLLIN | POLLHUP | POLLERR)) {
+                if (connection->inputLength == LOADGEN_READ_BUFFER) {
+                    fprintf(stderr, "响应行过长（超过%d字节），可在服务端使用--no-path\n", LOADGEN_READ_BUFFER);
+                    requestCount = stats.latencyCount;
+                    break;
+                }
+                ssize_t received = recv(connection->fd, connection->input + connection->inputLength,
+                                        (size_t)(LOADGEN_READ_BUFFER - connection->inputLength), 0);
+                if (received <= 0) {
+                    fprintf(stderr, "服务关闭了连接（已完成 %lld 个请求）\n", stats.latencyCount);
+                    requestCount = stats.latencyCount;
+                    break;
+                }
+                connection->inputLength += (int)received;
+                processResponses(connection, &stats, depth);
+            }
+        }
+    }
+    double elapsed = getTimeSeconds() - begin;
+    
+    qsort(stats.latencies, (size_t)stats.latencyCount, sizeof(double), compareDoubles);
+    double total = 0.0;
+    for (long long i = 0; i < stats.latencyCount; i++) {
+        total += stats.latencies[i];
+    }
+    double mean = stats.latencyCount > 0 ? total / (double)stats.latencyCount : 0.0;
+    
+    printf("请求: %lld（连接 %d × 深度 %d），耗时 %.3f 秒，%.0f 次/秒\n", stats.latencyCount, connectionCount, depth,
+           elapsed, elapsed > 0.0 ? (double)stats.latencyCount / elapsed : 0.0);
+    printf("响应: ok %lld / unreachable %lld / timeout %lld / error %lld\n", stats.ok, stats.unreachable,
+           stats.timeout, stats.error);
+    printf("延迟（毫秒）: 平均 %.3f / p50 %.3f / p95 %.3f / p99 %.3f / 最大 %.3f\n", mean * 1000.0,
+           percentile(stats.latencies, stats.latencyCount, 0.50) * 1000.0,
+           percentile(stats.latencies, stats.latencyCount, 0.95) * 1000.0,
+           percentile(stats.latencies, stats.latencyCount, 0.99) * 1000.0,
+           stats.latencyCount > 0 ? stats.latencies[stats.latencyCount - 1] * 1000.0 : 0.0);
+    
+    for (int c = 0; c < connectionCount; c++) {
+        close(connections[c].fd);
+        free(connections[c].output);
+        free(connections[c].sendTimes);
+    }
+    for (int i = 0; i < queryLineCount; i++) {
+        free(queryLines[i]);
+    }
+    free(queryLines);
+    free(connections);
+    free(pollFds);
+    free(stats.latencies);
+    return stats.latencyCount > 0 ? 0 : 1;
+}
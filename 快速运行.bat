@@ -21,25 +21,85 @@ if exist PathFinding.exe (
     del *.exe 2>nul
     
     REM 编译程序
-    echo [1/4] 编译 graph.c...
+    echo [1/19] 编译 graph.c...
     gcc -std=c99 -Iinclude -c src/graph.c -o graph.o
     if errorlevel 1 goto error
     
-    echo [2/4] 编译 pathfinding.c...
+    echo [2/19] 编译 pathfinding.c...
     gcc -std=c99 -Iinclude -c src/pathfinding.c -o pathfinding.o
     if errorlevel 1 goto error
     
-    echo [3/4] 编译 utils.c...
+    echo [3/19] 编译 utils.c...
     gcc -std=c99 -Iinclude -c src/utils.c -o utils.o
     if errorlevel 1 goto error
     
-    echo [4/4] 编译 main.c...
+    echo [4/19] 编译 heap.c...
+    gcc -std=c99 -Iinclude -c src/heap.c -o heap.o
+    if errorlevel 1 goto error
+
+    echo [5/19] 编译 ch.c...
+    gcc -std=c99 -Iinclude -c src/ch.c -o ch.o
+    if errorlevel 1 goto error
+
+    echo [6/19] 编译 landmarks.c...
+    gcc -std=c99 -Iinclude -c src/landmarks.c -o landmarks.o
+    if errorlevel 1 goto error
+
+    echo [7/19] 编译 matrix.c...
+    gcc -std=c99 -Iinclude -c src/matrix.c -o matrix.o
+    if errorlevel 1 goto error
+
+    echo [8/19] 编译 engine.c...
+    gcc -std=c99 -Iinclude -c src/engine.c -o engine.o
+    if errorlevel 1 goto error
+
+    echo [9/19] 编译 spt.c...
+    gcc -std=c99 -Iinclude -c src/spt.c -o spt.o
+    if errorlevel 1 goto error
+
+    echo [10/19] 编译 routecache.c...
+    gcc -std=c99 -Iinclude -c src/routecache.c -o routecache.o
+    if errorlevel 1 goto error
+
+    echo [11/19] 编译 dynspt.c...
+    gcc -std=c99 -Iinclude -c src/dynspt.c -o dynspt.o
+    if errorlevel 1 goto error
+
+    echo [12/19] 编译 loader.c...
+    gcc -std=c99 -Iinclude -c src/loader.c -o loader.o
+    if errorlevel 1 goto error
+
+    echo [13/19] 编译 snapshot.c...
+    gcc -std=c99 -Iinclude -c src/snapshot.c -o snapshot.o
+    if errorlevel 1 goto error
+
+    echo [14/19] 编译 generator.c...
+    gcc -std=c99 -Iinclude -c src/generator.c -o generator.o
+    if errorlevel 1 goto error
+
+    echo [15/19] 编译 batch.c...
+    gcc -std=c99 -Iinclude -c src/batch.c -o batch.o
+    if errorlevel 1 goto error
+
+    echo [16/19] 编译 server.c...
+    gcc -std=c99 -Iinclude -c src/server.c -o server.o
+    if errorlevel 1 goto error
+
+    echo [17/19] 编译 timedep.c...
+    gcc -std=c99 -Iinclude -c src/timedep.c -o timedep.o
+    if errorlevel 1 goto error
+
+    echo [18/19] 编译 multimodal.c...
+    gcc -std=c99 -Iinclude -c src/multimodal.c -o multimodal.o
+    if errorlevel 1 goto error
+
+    echo [19/19] 编译 main.c...
     gcc -std=c99 -Iinclude -c src/main.c -o main.o
     if errorlevel 1 goto error
     
     echo.
     echo 正在链接程序...
-    gcc graph.o pathfinding.o utils.o main.o -o PathFinding.exe -lm
+    gcc graph.o pathfinding.o utils.o heap.o ch.o landmarks.o matrix.o engine.o spt.o routecache.o dynspt.o loader.o snapshot.o generator.o batch.o server.o timedep.o multimodal.o main.o -o PathFinding.exe -lm -lpthread
     if errorlevel 1 goto error
     
     echo 编译成功！正在启动...